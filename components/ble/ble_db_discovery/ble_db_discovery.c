@@ -44,6 +44,12 @@
 #include "ble_db_discovery.h"
 #include <stdlib.h>
 #include "ble_srv_common.h"
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+#include "peer_manager.h"
+#endif
+#if NRF_MODULE_ENABLED(APP_TIMER)
+#include "app_timer.h"
+#endif
 #define NRF_LOG_MODULE_NAME ble_db_disc
 #include "nrf_log.h"
 NRF_LOG_MODULE_REGISTER();
@@ -52,6 +58,25 @@ NRF_LOG_MODULE_REGISTER();
 #define DB_DISCOVERY_MAX_USERS BLE_DB_DISCOVERY_MAX_SRV  /**< The maximum number of users/registrations allowed by this module. */
 #define MODULE_INITIALIZED (m_initialized == true)       /**< Macro designating whether the module has been initialized properly. */
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+#define DB_CACHE_HASH_UUID     0x2B2A                                    /**< The UUID of the Database Hash characteristic. */
+#define DB_CACHE_STALE_WORDS   CEIL_DIV(PM_PEER_ID_N_AVAILABLE_IDS, 32)  /**< Size of the bitmap of peers with outdated stored database. */
+
+#define DB_CACHE_STATE_IDLE    0                                         /**< No Database Hash read is in progress. */
+#define DB_CACHE_STATE_CHECK   1                                         /**< Database Hash is read to validate the stored database. */
+#define DB_CACHE_STATE_FILL    2                                         /**< Database Hash is read to be stored with the discovered database. */
+
+/**@brief Stored database of a peer (@ref PM_PEER_DATA_ID_GATT_REMOTE data). */
+typedef struct
+{
+    uint16_t          db_hash_handle;                        /**< Value handle of the Database Hash characteristic, or @ref BLE_GATT_HANDLE_INVALID if it was not found. */
+    uint16_t          srv_changed_handle;                    /**< Value handle of the Service Changed characteristic, or @ref BLE_GATT_HANDLE_INVALID if it was not found. */
+    uint8_t           db_hash[BLE_DB_DISCOVERY_DB_HASH_LEN]; /**< Database Hash of the peer at the time of discovery. */
+    uint32_t          srv_count;                             /**< Number of stored services. */
+    ble_gatt_db_srv_t services[BLE_DB_DISCOVERY_MAX_SRV];    /**< Services in the order of registration. Only srv_count entries are stored. */
+} db_cache_record_t;
+#endif
+
 
 /**@brief Array of structures containing information about the registered application modules. */
 static ble_uuid_t                       m_registered_handlers[DB_DISCOVERY_MAX_USERS];
@@ -61,6 +86,24 @@ static nrf_ble_gq_t                   * mp_gatt_queue; /**< Pointer to BLE GATT
 static uint32_t m_num_of_handlers_reg;      /**< The number of handlers registered with the DB Discovery module. */
 static bool     m_initialized = false;      /**< This variable Indicates if the module is initialized or not. */
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+__ALIGN(4) static db_cache_record_t m_cache_record;                              /**< Buffer for storing the database. It is kept until the store operation has completed. */
+__ALIGN(4) static db_cache_record_t m_cache_load_record;                         /**< Buffer for loading the database. Loading is synchronous, so it is never held. */
+static pm_store_token_t             m_cache_token;                               /**< Token of the ongoing store operation. */
+static pm_peer_id_t                 m_cache_peer_id = PM_PEER_ID_INVALID;        /**< Peer whose database is being stored, or @ref PM_PEER_ID_INVALID if @ref m_cache_record is free. */
+static ble_db_discovery_t         * mp_cache_queue;                              /**< Instances waiting for @ref m_cache_record to be free, in the order of discovery completion. */
+static bool                         m_cache_pm_registered;                       /**< Whether the module is registered for Peer Manager events. */
+static uint32_t                     m_cache_stale[DB_CACHE_STALE_WORDS];         /**< Peers whose stored database must not be used. */
+
+static void cache_fill(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle);
+static void cache_queue_process(void);
+#endif
+
+#if BLE_DB_DISCOVERY_BATCH_ENABLED
+static void batch_srv_next(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle);
+#endif
+
+
 /**@brief     Function for fetching the event handler provided by a registered application module.
  *
  * @param[in] srv_uuid UUID of the service.
@@ -112,6 +155,45 @@ static uint32_t registered_handler_set(ble_uuid_t                     const * p_
 }
 
 
+/**@brief Function for getting the number of services that are discovered on a connection.
+ *
+ * @return Number of registered services, increased by one if the discovery cache needs the GATT
+ *         service and it was not registered.
+ */
+static uint32_t srv_disc_count_get(void)
+{
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+    ble_uuid_t const gatt_uuid = {.uuid = BLE_UUID_GATT, .type = BLE_UUID_TYPE_BLE};
+
+    if (registered_handler_get(&gatt_uuid) == NULL)
+    {
+        return m_num_of_handlers_reg + 1;
+    }
+#endif
+    return m_num_of_handlers_reg;
+}
+
+
+/**@brief     Function for getting the UUID of the service to be discovered.
+ *
+ * @param[in] srv_ind Index of the service.
+ *
+ * @return    UUID of the registered service or of the GATT service if @p srv_ind is past the
+ *            registered services.
+ */
+static ble_uuid_t srv_uuid_get(uint32_t srv_ind)
+{
+    ble_uuid_t const gatt_uuid = {.uuid = BLE_UUID_GATT, .type = BLE_UUID_TYPE_BLE};
+
+    if (srv_ind < m_num_of_handlers_reg)
+    {
+        return m_registered_handlers[srv_ind];
+    }
+
+    return gatt_uuid;
+}
+
+
 /**@brief Function for sending all pending discovery events to the corresponding user modules.
  */
 static void pending_user_evts_send(ble_db_discovery_t * p_db_discovery)
@@ -125,6 +207,36 @@ static void pending_user_evts_send(ble_db_discovery_t * p_db_discovery)
     p_db_discovery->pending_usr_evt_index = 0;
 }
 
+/**@brief     Function for starting the collection of discovery metrics.
+ *
+ * @param[in] p_db_discovery Pointer to the DB discovery structure.
+ */
+static void stats_start(ble_db_discovery_t * p_db_discovery)
+{
+    memset(&p_db_discovery->stats, 0, sizeof(p_db_discovery->stats));
+
+#if NRF_MODULE_ENABLED(APP_TIMER)
+    p_db_discovery->start_ticks = app_timer_cnt_get();
+#endif
+}
+
+
+/**@brief     Function for computing the duration of the finished discovery.
+ *
+ * @param[in] p_db_discovery Pointer to the DB discovery structure.
+ */
+static void stats_finish(ble_db_discovery_t * p_db_discovery)
+{
+#if NRF_MODULE_ENABLED(APP_TIMER)
+    uint32_t ticks = app_timer_cnt_diff_compute(app_timer_cnt_get(), p_db_discovery->start_ticks);
+
+    p_db_discovery->stats.duration_ms = (uint32_t)(((uint64_t)ticks * 1000) / APP_TIMER_TICKS(1000));
+#else
+    UNUSED_PARAMETER(p_db_discovery);
+#endif
+}
+
+
 /**@brief     Function for indicating availability of DB discovery instance.
  *
  * @details   This function triggers an event indicating the finish of a discovery process.
@@ -145,6 +257,8 @@ static void discovery_available_evt_trigger(ble_db_discovery_t * const p_db_disc
     evt.evt_type             = BLE_DB_DISCOVERY_AVAILABLE;
     evt.params.p_db_instance = (void *)p_db_discovery;
 
+    stats_finish(p_db_discovery);
+
     if (m_evt_handler)
     {
         m_evt_handler(&evt);
@@ -287,7 +401,7 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
     p_db_discovery->discoveries_count++;
 
     // Check if more services need to be discovered.
-    if (p_db_discovery->discoveries_count < m_num_of_handlers_reg)
+    if (p_db_discovery->discoveries_count < srv_disc_count_get())
     {
         // Reset the current characteristic index since a new service discovery is about to start.
         p_db_discovery->curr_char_ind = 0;
@@ -295,11 +409,15 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
         // Initiate discovery of the next service.
         p_db_discovery->curr_srv_ind++;
 
+#if BLE_DB_DISCOVERY_BATCH_ENABLED
+        // Handle ranges of all services are already known.
+        batch_srv_next(p_db_discovery, conn_handle);
+#else
         ble_gatt_db_srv_t * p_srv_being_discovered;
 
         p_srv_being_discovered = &(p_db_discovery->services[p_db_discovery->curr_srv_ind]);
 
-        p_srv_being_discovered->srv_uuid = m_registered_handlers[p_db_discovery->curr_srv_ind];
+        p_srv_being_discovered->srv_uuid = srv_uuid_get(p_db_discovery->curr_srv_ind);
 
         // Reset the characteristic count in the current service to zero since a new service
         // discovery is about to start.
@@ -324,12 +442,16 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
 
             return;
         }
+#endif
     }
     else
     {
         // No more service discovery is needed.
         p_db_discovery->discovery_in_progress  = false;
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+        cache_fill(p_db_discovery, conn_handle);
+#endif
         discovery_available_evt_trigger(p_db_discovery, conn_handle);
     }
 }
@@ -570,6 +692,11 @@ static uint32_t descriptors_discover(ble_db_discovery_t * p_db_discovery,
 
     *p_raise_discov_complete = false;
 
+#if BLE_DB_DISCOVERY_BATCH_ENABLED
+    // Descriptors of all remaining characteristics of the service are discovered together.
+    handle_range.end_handle = p_srv_being_discovered->handle_range.end_handle;
+#endif
+
     db_desc_disc_req.type                   = NRF_BLE_GQ_REQ_DESC_DISCOVERY;
     db_desc_disc_req.params.gattc_desc_disc = handle_range;
     db_desc_disc_req.error_handler.p_ctx    = p_db_discovery;
@@ -579,6 +706,7 @@ static uint32_t descriptors_discover(ble_db_discovery_t * p_db_discovery,
 }
 
 
+#if !BLE_DB_DISCOVERY_BATCH_ENABLED
 /**@brief     Function for handling primary service discovery response.
  *
  * @details   This function will handle the primary service discovery response and start the
@@ -599,6 +727,8 @@ static void on_primary_srv_discovery_rsp(ble_db_discovery_t       * p_db_discove
         return;
     }
 
+    p_db_discovery->stats.rsp_count++;
+
     if (p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS)
     {
         uint32_t err_code;
@@ -644,6 +774,7 @@ static void on_primary_srv_discovery_rsp(ble_db_discovery_t       * p_db_discove
         on_srv_disc_completion(p_db_discovery, p_ble_gattc_evt->conn_handle);
     }
 }
+#endif // !BLE_DB_DISCOVERY_BATCH_ENABLED
 
 
 /**@brief     Function for handling characteristic discovery response.
@@ -663,6 +794,8 @@ static void on_characteristic_discovery_rsp(ble_db_discovery_t       * p_db_disc
         return;
     }
 
+    p_db_discovery->stats.rsp_count++;
+
     p_srv_being_discovered = &(p_db_discovery->services[p_db_discovery->curr_srv_ind]);
 
     if (p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS)
@@ -776,6 +909,41 @@ static void on_characteristic_discovery_rsp(ble_db_discovery_t       * p_db_disc
 }
 
 
+/**@brief     Function for storing the handle of a descriptor of interest.
+ *
+ * @details   CCCD, Extended Properties, User Description & Report Reference descriptor handles
+ *            are stored. Other descriptors are ignored.
+ *
+ * @param[in] p_char Pointer to the characteristic the descriptor belongs to.
+ * @param[in] p_desc Pointer to the discovered descriptor.
+ */
+static void desc_handle_store(ble_gatt_db_char_t * p_char, ble_gattc_desc_t const * p_desc)
+{
+    switch (p_desc->uuid.uuid)
+    {
+        case BLE_UUID_DESCRIPTOR_CLIENT_CHAR_CONFIG:
+            p_char->cccd_handle = p_desc->handle;
+            break;
+
+        case BLE_UUID_DESCRIPTOR_CHAR_EXT_PROP:
+            p_char->ext_prop_handle = p_desc->handle;
+            break;
+
+        case BLE_UUID_DESCRIPTOR_CHAR_USER_DESC:
+            p_char->user_desc_handle = p_desc->handle;
+            break;
+
+        case BLE_UUID_REPORT_REF_DESCR:
+            p_char->report_ref_handle = p_desc->handle;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+#if !BLE_DB_DISCOVERY_BATCH_ENABLED
 /**@brief     Function for handling descriptor discovery response.
  *
  * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
@@ -792,6 +960,8 @@ static void on_descriptor_discovery_rsp(ble_db_discovery_t * const    p_db_disco
         return;
     }
 
+    p_db_discovery->stats.rsp_count++;
+
     p_srv_being_discovered = &(p_db_discovery->services[p_db_discovery->curr_srv_ind]);
 
     p_desc_disc_rsp_evt = &(p_ble_gattc_evt->params.desc_disc_rsp);
@@ -806,28 +976,7 @@ static void on_descriptor_discovery_rsp(ble_db_discovery_t * const    p_db_disco
         // User Description & Report Reference descriptor handles.
         for (uint32_t i = 0; i < p_desc_disc_rsp_evt->count; i++)
         {
-            switch (p_desc_disc_rsp_evt->descs[i].uuid.uuid)
-            {
-                case BLE_UUID_DESCRIPTOR_CLIENT_CHAR_CONFIG:
-                    p_char_being_discovered->cccd_handle =
-                        p_desc_disc_rsp_evt->descs[i].handle;
-                    break;
-
-                case BLE_UUID_DESCRIPTOR_CHAR_EXT_PROP:
-                    p_char_being_discovered->ext_prop_handle =
-                        p_desc_disc_rsp_evt->descs[i].handle;
-                    break;
-
-                case BLE_UUID_DESCRIPTOR_CHAR_USER_DESC:
-                    p_char_being_discovered->user_desc_handle =
-                        p_desc_disc_rsp_evt->descs[i].handle;
-                    break;
-
-                case BLE_UUID_REPORT_REF_DESCR:
-                    p_char_being_discovered->report_ref_handle =
-                        p_desc_disc_rsp_evt->descs[i].handle;
-                    break;
-            }
+            desc_handle_store(p_char_being_discovered, &(p_desc_disc_rsp_evt->descs[i]));
 
             /* Break if we've found all the descriptors we are looking for. */
             if (p_char_being_discovered->cccd_handle       != BLE_GATT_HANDLE_INVALID &&
@@ -879,7 +1028,248 @@ static void on_descriptor_discovery_rsp(ble_db_discovery_t * const    p_db_disco
         on_srv_disc_completion(p_db_discovery, p_ble_gattc_evt->conn_handle);
     }
 }
+#endif // !BLE_DB_DISCOVERY_BATCH_ENABLED
+
+#if BLE_DB_DISCOVERY_BATCH_ENABLED
+/**@brief     Function for discovering all primary services starting from a given handle.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] start_handle   Handle to start the discovery from.
+ * @param[in] conn_handle    Connection handle.
+ *
+ * @return    NRF_SUCCESS if the request was queued. Otherwise an error code returned by
+ *            @ref nrf_ble_gq_item_add.
+ */
+static uint32_t batch_srv_discover(ble_db_discovery_t * p_db_discovery,
+                                   uint16_t             start_handle,
+                                   uint16_t             conn_handle)
+{
+    nrf_ble_gq_req_t db_srv_disc_req;
+
+    memset(&db_srv_disc_req, 0, sizeof(nrf_ble_gq_req_t));
+
+    // Service UUID of unknown type requests discovery of all primary services.
+    db_srv_disc_req.type                                 = NRF_BLE_GQ_REQ_SRV_DISCOVERY;
+    db_srv_disc_req.params.gattc_srv_disc.start_handle   = start_handle;
+    db_srv_disc_req.params.gattc_srv_disc.srvc_uuid.type = BLE_UUID_TYPE_UNKNOWN;
+    db_srv_disc_req.error_handler.p_ctx                  = p_db_discovery;
+    db_srv_disc_req.error_handler.cb                     = discovery_error_handler;
+
+    return nrf_ble_gq_item_add(mp_gatt_queue, &db_srv_disc_req, conn_handle);
+}
+
+
+/**@brief     Function for starting the discovery of characteristics of the current service.
+ *
+ * @details   If the service was not found at the peer, Service Not Found event is triggered and
+ *            the next service is processed.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection handle.
+ */
+static void batch_srv_next(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    ble_gatt_db_srv_t * p_srv_being_discovered;
+
+    p_srv_being_discovered = &(p_db_discovery->services[p_db_discovery->curr_srv_ind]);
+
+    if (p_srv_being_discovered->handle_range.start_handle == BLE_GATT_HANDLE_INVALID)
+    {
+        NRF_LOG_DEBUG("Service UUID 0x%x not found.", p_srv_being_discovered->srv_uuid.uuid);
+        // Trigger Service Not Found event to the application.
+        discovery_complete_evt_trigger(p_db_discovery, false, conn_handle);
+        on_srv_disc_completion(p_db_discovery, conn_handle);
+        return;
+    }
+
+    NRF_LOG_DEBUG("Starting discovery of characteristics of service with UUID 0x%x"
+                  " on connection handle 0x%x.",
+                  p_srv_being_discovered->srv_uuid.uuid, conn_handle);
+
+    uint32_t err_code = characteristics_discover(p_db_discovery, conn_handle);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        discovery_error_handler(err_code, p_db_discovery, conn_handle);
+    }
+}
+
+
+/**@brief     Function for handling primary service discovery response of all services.
+ *
+ * @details   Returned services are matched against the services to be discovered. Discovery
+ *            continues after the last returned service until all services are found or the end of
+ *            the peer's database is reached. Then characteristics of the found services are
+ *            discovered one service after another.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_batch_srv_discovery_rsp(ble_db_discovery_t       * p_db_discovery,
+                                       ble_gattc_evt_t    const * p_ble_gattc_evt)
+{
+    ble_gattc_evt_prim_srvc_disc_rsp_t const * p_rsp       = &(p_ble_gattc_evt->params.prim_srvc_disc_rsp);
+    uint32_t                                   srv_total   = srv_disc_count_get();
+    uint32_t                                   srv_found   = 0;
+    uint16_t                                   next_handle = BLE_GATT_HANDLE_INVALID;
+
+    if (p_ble_gattc_evt->conn_handle != p_db_discovery->conn_handle)
+    {
+        return;
+    }
+
+    p_db_discovery->stats.rsp_count++;
+
+    if ((p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS) && (p_rsp->count > 0))
+    {
+        for (uint32_t i = 0; i < p_rsp->count; i++)
+        {
+            for (uint32_t j = 0; j < srv_total; j++)
+            {
+                ble_gatt_db_srv_t * p_srv = &(p_db_discovery->services[j]);
+
+                // Only the first instance of a service is used, as with discovery by UUID.
+                if ((p_srv->handle_range.start_handle == BLE_GATT_HANDLE_INVALID) &&
+                    BLE_UUID_EQ(&(p_srv->srv_uuid), &(p_rsp->services[i].uuid)))
+                {
+                    NRF_LOG_DEBUG("Found service UUID 0x%x.", p_srv->srv_uuid.uuid);
+
+                    p_srv->handle_range = p_rsp->services[i].handle_range;
+                    break;
+                }
+            }
+        }
+
+        uint16_t last_handle = p_rsp->services[p_rsp->count - 1].handle_range.end_handle;
+
+        if (last_handle < BLE_GATT_HANDLE_END)
+        {
+            next_handle = last_handle + 1;
+        }
+    }
+
+    for (uint32_t j = 0; j < srv_total; j++)
+    {
+        if (p_db_discovery->services[j].handle_range.start_handle != BLE_GATT_HANDLE_INVALID)
+        {
+            srv_found++;
+        }
+    }
+
+    p_db_discovery->srv_count = MIN(srv_found, BLE_DB_DISCOVERY_MAX_SRV);
+
+    if ((next_handle != BLE_GATT_HANDLE_INVALID) && (srv_found < srv_total))
+    {
+        uint32_t err_code = batch_srv_discover(p_db_discovery,
+                                               next_handle,
+                                               p_ble_gattc_evt->conn_handle);
+
+        if (err_code != NRF_SUCCESS)
+        {
+            discovery_error_handler(err_code, p_db_discovery, p_ble_gattc_evt->conn_handle);
+        }
+
+        return;
+    }
+
+    p_db_discovery->curr_srv_ind = 0;
+    batch_srv_next(p_db_discovery, p_ble_gattc_evt->conn_handle);
+}
+
+
+/**@brief     Function for finding the characteristic a descriptor belongs to.
+ *
+ * @param[in] p_srv  Pointer to the service being discovered.
+ * @param[in] handle Handle of the descriptor.
+ *
+ * @return    Pointer to the last characteristic with value handle lower than @p handle, or NULL.
+ */
+static ble_gatt_db_char_t * batch_desc_owner_get(ble_gatt_db_srv_t * p_srv, uint16_t handle)
+{
+    for (uint32_t i = p_srv->char_count; i > 0; i--)
+    {
+        if (p_srv->charateristics[i - 1].characteristic.handle_value < handle)
+        {
+            return &(p_srv->charateristics[i - 1]);
+        }
+    }
+
+    return NULL;
+}
+
+
+/**@brief     Function for handling descriptor discovery response of all characteristics of
+ *            a service.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_batch_desc_discovery_rsp(ble_db_discovery_t       * p_db_discovery,
+                                        ble_gattc_evt_t    const * p_ble_gattc_evt)
+{
+    ble_gattc_evt_desc_disc_rsp_t const * p_rsp = &(p_ble_gattc_evt->params.desc_disc_rsp);
+    ble_gatt_db_srv_t                   * p_srv_being_discovered;
+
+    if (p_ble_gattc_evt->conn_handle != p_db_discovery->conn_handle)
+    {
+        return;
+    }
+
+    p_db_discovery->stats.rsp_count++;
+
+    p_srv_being_discovered = &(p_db_discovery->services[p_db_discovery->curr_srv_ind]);
+
+    if ((p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS) && (p_rsp->count > 0))
+    {
+        for (uint32_t i = 0; i < p_rsp->count; i++)
+        {
+            ble_gatt_db_char_t * p_char = batch_desc_owner_get(p_srv_being_discovered,
+                                                               p_rsp->descs[i].handle);
 
+            if (p_char != NULL)
+            {
+                desc_handle_store(p_char, &(p_rsp->descs[i]));
+            }
+        }
+
+        uint16_t last_handle = p_rsp->descs[p_rsp->count - 1].handle;
+
+        if (last_handle < p_srv_being_discovered->handle_range.end_handle)
+        {
+            nrf_ble_gq_req_t db_desc_disc_req;
+            uint32_t         err_code;
+
+            memset(&db_desc_disc_req, 0, sizeof(nrf_ble_gq_req_t));
+
+            db_desc_disc_req.type                                = NRF_BLE_GQ_REQ_DESC_DISCOVERY;
+            db_desc_disc_req.params.gattc_desc_disc.start_handle = last_handle + 1;
+            db_desc_disc_req.params.gattc_desc_disc.end_handle   =
+                p_srv_being_discovered->handle_range.end_handle;
+            db_desc_disc_req.error_handler.p_ctx                 = p_db_discovery;
+            db_desc_disc_req.error_handler.cb                    = discovery_error_handler;
+
+            err_code = nrf_ble_gq_item_add(mp_gatt_queue,
+                                           &db_desc_disc_req,
+                                           p_ble_gattc_evt->conn_handle);
+
+            if (err_code != NRF_SUCCESS)
+            {
+                discovery_error_handler(err_code, p_db_discovery, p_ble_gattc_evt->conn_handle);
+            }
+
+            return;
+        }
+    }
+
+    NRF_LOG_DEBUG("Discovery of service with UUID 0x%x completed with success"
+                  " on connection handle 0x%x.",
+                  p_srv_being_discovered->srv_uuid.uuid,
+                  p_ble_gattc_evt->conn_handle);
+
+    discovery_complete_evt_trigger(p_db_discovery, true, p_ble_gattc_evt->conn_handle);
+    on_srv_disc_completion(p_db_discovery, p_ble_gattc_evt->conn_handle);
+}
+#endif // BLE_DB_DISCOVERY_BATCH_ENABLED
 
 uint32_t ble_db_discovery_init(ble_db_discovery_init_t * p_db_init)
 {
@@ -919,12 +1309,9 @@ uint32_t ble_db_discovery_evt_register(ble_uuid_t const * p_uuid)
 
 static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery, uint16_t conn_handle)
 {
-    ret_code_t          err_code;
-    ble_gatt_db_srv_t * p_srv_being_discovered;
-    nrf_ble_gq_req_t    db_srv_disc_req;
+    ret_code_t err_code;
 
     memset(p_db_discovery, 0x00, sizeof(ble_db_discovery_t));
-    memset(&db_srv_disc_req, 0x00, sizeof(nrf_ble_gq_req_t));
 
     err_code = nrf_ble_gq_conn_handle_register(mp_gatt_queue, conn_handle);
     VERIFY_SUCCESS(err_code);
@@ -937,8 +1324,25 @@ static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery, uint1
     p_db_discovery->curr_srv_ind      = 0;
     p_db_discovery->curr_char_ind     = 0;
 
+    stats_start(p_db_discovery);
+
+#if BLE_DB_DISCOVERY_BATCH_ENABLED
+    for (uint32_t i = 0; i < srv_disc_count_get(); i++)
+    {
+        p_db_discovery->services[i].srv_uuid = srv_uuid_get(i);
+    }
+
+    NRF_LOG_DEBUG("Starting discovery of all services on connection handle 0x%x.", conn_handle);
+
+    err_code = batch_srv_discover(p_db_discovery, SRV_DISC_START_HANDLE, conn_handle);
+#else
+    ble_gatt_db_srv_t * p_srv_being_discovered;
+    nrf_ble_gq_req_t    db_srv_disc_req;
+
+    memset(&db_srv_disc_req, 0x00, sizeof(nrf_ble_gq_req_t));
+
     p_srv_being_discovered = &(p_db_discovery->services[p_db_discovery->curr_srv_ind]);
-    p_srv_being_discovered->srv_uuid = m_registered_handlers[p_db_discovery->curr_srv_ind];
+    p_srv_being_discovered->srv_uuid = srv_uuid_get(p_db_discovery->curr_srv_ind);
 
     NRF_LOG_DEBUG("Starting discovery of service with UUID 0x%x on connection handle 0x%x.",
                   p_srv_being_discovered->srv_uuid.uuid, conn_handle);
@@ -950,6 +1354,7 @@ static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery, uint1
     db_srv_disc_req.error_handler.cb                   = discovery_error_handler;
 
     err_code = nrf_ble_gq_item_add(mp_gatt_queue, &db_srv_disc_req, conn_handle);
+#endif
 
     if (err_code == NRF_SUCCESS)
     {
@@ -960,44 +1365,705 @@ static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery, uint1
 }
 
 
-uint32_t ble_db_discovery_start(ble_db_discovery_t * const p_db_discovery, uint16_t conn_handle)
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+/**@brief     Function for marking the stored database of a peer as outdated or valid.
+ *
+ * @param[in] peer_id Peer ID.
+ * @param[in] stale   True if the stored database must not be used.
+ */
+static void cache_stale_set(pm_peer_id_t peer_id, bool stale)
 {
-    VERIFY_PARAM_NOT_NULL(p_db_discovery);
-    VERIFY_MODULE_INITIALIZED();
-
-    if (m_num_of_handlers_reg == 0)
+    if (peer_id >= PM_PEER_ID_N_AVAILABLE_IDS)
     {
-        // No user modules were registered. There are no services to discover.
-        return NRF_ERROR_INVALID_STATE;
+        return;
     }
 
-    if (p_db_discovery->discovery_in_progress)
+    if (stale)
     {
-        return NRF_ERROR_BUSY;
+        m_cache_stale[peer_id / 32] |= (1UL << (peer_id % 32));
+    }
+    else
+    {
+        m_cache_stale[peer_id / 32] &= ~(1UL << (peer_id % 32));
     }
-
-    return discovery_start(p_db_discovery, conn_handle);
 }
 
 
-/**@brief     Function for handling disconnected event.
+/**@brief     Function for checking if the stored database of a peer is outdated.
  *
- * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
- * @param[in] p_ble_gattc_evt   Pointer to the GAP event.
+ * @param[in] peer_id Peer ID.
+ *
+ * @retval    True if the stored database must not be used.
  */
-static void on_disconnected(ble_db_discovery_t       * p_db_discovery,
-                            ble_gap_evt_t      const * p_evt)
+static bool cache_is_stale(pm_peer_id_t peer_id)
 {
-    if (p_evt->conn_handle == p_db_discovery->conn_handle)
-    {
-        p_db_discovery->discovery_in_progress = false;
-        p_db_discovery->conn_handle           = BLE_CONN_HANDLE_INVALID;
-    }
+    return (m_cache_stale[peer_id / 32] & (1UL << (peer_id % 32))) != 0;
 }
 
 
-void ble_db_discovery_on_ble_evt(ble_evt_t const * p_ble_evt,
-                                 void            * p_context)
+/**@brief     Function for handling the Peer Manager events related to the stored database.
+ *
+ * @param[in] p_evt Peer Manager event.
+ */
+static void cache_pm_evt_handler(pm_evt_t const * p_evt)
+{
+    switch (p_evt->evt_id)
+    {
+        case PM_EVT_PEER_DATA_UPDATE_SUCCEEDED:
+            if ((p_evt->peer_id == m_cache_peer_id) &&
+                (p_evt->params.peer_data_update_succeeded.data_id == PM_PEER_DATA_ID_GATT_REMOTE) &&
+                (p_evt->params.peer_data_update_succeeded.token == m_cache_token))
+            {
+                m_cache_peer_id = PM_PEER_ID_INVALID;
+                cache_queue_process();
+            }
+            break;
+
+        case PM_EVT_PEER_DATA_UPDATE_FAILED:
+            if ((p_evt->peer_id == m_cache_peer_id) &&
+                (p_evt->params.peer_data_update_failed.data_id == PM_PEER_DATA_ID_GATT_REMOTE) &&
+                (p_evt->params.peer_data_update_failed.token == m_cache_token))
+            {
+                // Flash may still contain the previous database of this peer.
+                cache_stale_set(m_cache_peer_id, true);
+                m_cache_peer_id = PM_PEER_ID_INVALID;
+                cache_queue_process();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**@brief     Function for getting the peer ID of a connection.
+ *
+ * @param[in] conn_handle Connection handle.
+ *
+ * @return    Peer ID, or @ref PM_PEER_ID_INVALID if the peer is not bonded.
+ */
+static pm_peer_id_t cache_peer_id_get(uint16_t conn_handle)
+{
+    pm_peer_id_t peer_id;
+
+    if (pm_peer_id_get(conn_handle, &peer_id) != NRF_SUCCESS)
+    {
+        return PM_PEER_ID_INVALID;
+    }
+
+    return peer_id;
+}
+
+
+/**@brief     Function for starting the store operation of a discovered database.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] peer_id        Peer ID.
+ *
+ * @retval    NRF_SUCCESS If the store operation was started.
+ * @return    Otherwise, this function propagates the error code returned by
+ *            @ref pm_peer_data_store.
+ */
+static ret_code_t cache_record_store(ble_db_discovery_t const * p_db_discovery,
+                                     pm_peer_id_t               peer_id)
+{
+    ret_code_t err_code;
+    uint32_t   len;
+
+    memset(&m_cache_record, 0, sizeof(m_cache_record));
+    m_cache_record.db_hash_handle     = p_db_discovery->db_hash_handle;
+    m_cache_record.srv_changed_handle = p_db_discovery->srv_changed_handle;
+    m_cache_record.srv_count          = m_num_of_handlers_reg;
+    memcpy(m_cache_record.db_hash, p_db_discovery->db_hash, sizeof(m_cache_record.db_hash));
+    memcpy(m_cache_record.services,
+           p_db_discovery->services,
+           m_num_of_handlers_reg * sizeof(ble_gatt_db_srv_t));
+
+    len = offsetof(db_cache_record_t, services) + m_num_of_handlers_reg * sizeof(ble_gatt_db_srv_t);
+
+    err_code = pm_peer_data_store(peer_id,
+                                  PM_PEER_DATA_ID_GATT_REMOTE,
+                                  &m_cache_record,
+                                  len,
+                                  &m_cache_token);
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_WARNING("Database of peer %d could not be stored, error 0x%x.", peer_id, err_code);
+        return err_code;
+    }
+
+    m_cache_peer_id = peer_id;
+    cache_stale_set(peer_id, false);
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief     Function for storing the databases that waited for the previous store operation.
+ */
+static void cache_queue_process(void)
+{
+    while ((mp_cache_queue != NULL) && (m_cache_peer_id == PM_PEER_ID_INVALID))
+    {
+        ble_db_discovery_t * p_db_discovery = mp_cache_queue;
+
+        mp_cache_queue                     = p_db_discovery->p_cache_next;
+        p_db_discovery->p_cache_next       = NULL;
+        p_db_discovery->cache_store_queued = false;
+
+        UNUSED_RETURN_VALUE(cache_record_store(p_db_discovery, p_db_discovery->cache_peer_id));
+    }
+}
+
+
+/**@brief     Function for removing the instance from the store queue.
+ *
+ * @details   This is done before the instance is reused or when its database is outdated. The
+ *            database that was waiting is not stored.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ */
+static void cache_queue_remove(ble_db_discovery_t * p_db_discovery)
+{
+    ble_db_discovery_t ** pp_item = &mp_cache_queue;
+
+    if (!p_db_discovery->cache_store_queued)
+    {
+        return;
+    }
+
+    while (*pp_item != p_db_discovery)
+    {
+        pp_item = &(*pp_item)->p_cache_next;
+    }
+
+    *pp_item                           = p_db_discovery->p_cache_next;
+    p_db_discovery->p_cache_next       = NULL;
+    p_db_discovery->cache_store_queued = false;
+}
+
+
+/**@brief     Function for checking if a database of the peer waits to be stored or is being
+ *            stored.
+ *
+ * @param[in] peer_id Peer ID.
+ *
+ * @retval    True if the stored database of the peer is about to be replaced.
+ */
+static bool cache_store_is_pending(pm_peer_id_t peer_id)
+{
+    if (peer_id == m_cache_peer_id)
+    {
+        return true;
+    }
+
+    for (ble_db_discovery_t const * p_item = mp_cache_queue;
+         p_item != NULL;
+         p_item = p_item->p_cache_next)
+    {
+        if (p_item->cache_peer_id == peer_id)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**@brief     Function for invalidating the stored database of the peer.
+ *
+ * @details   The database is marked as outdated immediately because deleting it from flash is
+ *            asynchronous and can fail.
+ *
+ * @param[in] conn_handle Connection handle.
+ */
+static void cache_invalidate(uint16_t conn_handle)
+{
+    pm_peer_id_t peer_id = cache_peer_id_get(conn_handle);
+
+    if (peer_id == PM_PEER_ID_INVALID)
+    {
+        return;
+    }
+
+    NRF_LOG_DEBUG("Stored database of peer %d is outdated.", peer_id);
+
+    // A database of the peer that waits to be stored is outdated as well.
+    for (ble_db_discovery_t * p_item = mp_cache_queue; p_item != NULL; )
+    {
+        ble_db_discovery_t * p_next = p_item->p_cache_next;
+
+        if (p_item->cache_peer_id == peer_id)
+        {
+            cache_queue_remove(p_item);
+        }
+        p_item = p_next;
+    }
+
+    cache_stale_set(peer_id, true);
+    UNUSED_RETURN_VALUE(pm_peer_data_delete(peer_id, PM_PEER_DATA_ID_GATT_REMOTE));
+}
+
+
+/**@brief     Function for storing the discovered database of a bonded peer.
+ *
+ * @details   Peer Manager keeps the data buffer until the store operation has completed. If
+ *            another peer is being stored, the instance is queued, and its database is stored
+ *            from the instance when the buffer becomes free.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection handle.
+ */
+static void cache_store(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    ret_code_t            err_code;
+    ble_db_discovery_t ** pp_item;
+    pm_peer_id_t          peer_id = cache_peer_id_get(conn_handle);
+
+    if (peer_id == PM_PEER_ID_INVALID)
+    {
+        return;
+    }
+
+    if (!m_cache_pm_registered)
+    {
+        err_code = pm_register(cache_pm_evt_handler);
+        if (err_code != NRF_SUCCESS)
+        {
+            NRF_LOG_WARNING("Registration with Peer Manager failed. Increase PM_MAX_REGISTRANTS "
+                            "to store the database.");
+            return;
+        }
+        m_cache_pm_registered = true;
+    }
+
+    if (m_cache_peer_id == PM_PEER_ID_INVALID)
+    {
+        UNUSED_RETURN_VALUE(cache_record_store(p_db_discovery, peer_id));
+        return;
+    }
+
+    NRF_LOG_DEBUG("Database of peer %d queued. Another store operation is ongoing.", peer_id);
+
+    cache_queue_remove(p_db_discovery);
+
+    pp_item = &mp_cache_queue;
+    while (*pp_item != NULL)
+    {
+        pp_item = &(*pp_item)->p_cache_next;
+    }
+
+    *pp_item                           = p_db_discovery;
+    p_db_discovery->p_cache_next       = NULL;
+    p_db_discovery->cache_peer_id      = peer_id;
+    p_db_discovery->cache_store_queued = true;
+}
+
+
+/**@brief     Function for loading the stored database of the peer.
+ *
+ * @details   The database is used only if it was stored for the same set of registered services.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection handle.
+ *
+ * @retval    True if the database was loaded to @p p_db_discovery.
+ */
+static bool cache_load(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    uint32_t                  len      = sizeof(m_cache_load_record);
+    db_cache_record_t const * p_record = &m_cache_load_record;
+    pm_peer_id_t              peer_id  = cache_peer_id_get(conn_handle);
+
+    // Flash may still hold an older database of a peer whose store operation is pending.
+    if ((peer_id == PM_PEER_ID_INVALID) ||
+        cache_is_stale(peer_id)         ||
+        cache_store_is_pending(peer_id))
+    {
+        return false;
+    }
+
+    if (pm_peer_data_load(peer_id,
+                          PM_PEER_DATA_ID_GATT_REMOTE,
+                          &m_cache_load_record,
+                          &len) != NRF_SUCCESS)
+    {
+        return false;
+    }
+
+    if ((len < offsetof(db_cache_record_t, services))     ||
+        (p_record->srv_count != m_num_of_handlers_reg)      ||
+        (len < offsetof(db_cache_record_t, services) + m_num_of_handlers_reg * sizeof(ble_gatt_db_srv_t)))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        if (!BLE_UUID_EQ(&p_record->services[i].srv_uuid, &m_registered_handlers[i]))
+        {
+            return false;
+        }
+    }
+
+    p_db_discovery->db_hash_handle     = p_record->db_hash_handle;
+    p_db_discovery->srv_changed_handle = p_record->srv_changed_handle;
+    memcpy(p_db_discovery->db_hash, p_record->db_hash, sizeof(p_db_discovery->db_hash));
+    memcpy(p_db_discovery->services,
+           p_record->services,
+           m_num_of_handlers_reg * sizeof(ble_gatt_db_srv_t));
+
+    return true;
+}
+
+
+/**@brief     Function for raising the discovery events from the stored database.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection handle.
+ */
+static void cache_replay(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    NRF_LOG_DEBUG("Using stored database on connection handle 0x%x.", conn_handle);
+
+    for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        // Handle range of a service which was not found at the peer is left empty.
+        p_db_discovery->curr_srv_ind = i;
+        discovery_complete_evt_trigger(p_db_discovery,
+                                       (p_db_discovery->services[i].handle_range.start_handle !=
+                                        BLE_GATT_HANDLE_INVALID),
+                                       conn_handle);
+    }
+
+    p_db_discovery->discoveries_count     = m_num_of_handlers_reg;
+    p_db_discovery->discovery_in_progress = false;
+
+    discovery_available_evt_trigger(p_db_discovery, conn_handle);
+}
+
+
+/**@brief     Function for running full discovery when the stored database cannot be used.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection handle.
+ */
+static void cache_fallback(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    ble_db_discovery_stats_t stats       = p_db_discovery->stats;
+    uint32_t                 start_ticks = p_db_discovery->start_ticks;
+    uint32_t                 err_code    = discovery_start(p_db_discovery, conn_handle);
+
+    // Metrics cover the Database Hash read as well.
+    p_db_discovery->stats       = stats;
+    p_db_discovery->start_ticks = start_ticks;
+
+    if (err_code != NRF_SUCCESS)
+    {
+        discovery_error_handler(err_code, p_db_discovery, conn_handle);
+    }
+}
+
+
+/**@brief Function for interception of @ref nrf_ble_gq errors of the Database Hash read.
+ *
+ * @param[in] nrf_error   Error code.
+ * @param[in] p_ctx       Parameter from the event handler.
+ * @param[in] conn_handle Connection handle.
+ */
+static void cache_error_handler(uint32_t   nrf_error,
+                                void     * p_ctx,
+                                uint16_t   conn_handle)
+{
+    ble_db_discovery_t * p_db_discovery = (ble_db_discovery_t *)p_ctx;
+    uint8_t              state          = p_db_discovery->cache_state;
+
+    p_db_discovery->cache_state = DB_CACHE_STATE_IDLE;
+
+    if (state == DB_CACHE_STATE_CHECK)
+    {
+        cache_fallback(p_db_discovery, conn_handle);
+    }
+    else if (state == DB_CACHE_STATE_FILL)
+    {
+        // Store the database without the hash. It is then validated by Service Changed only.
+        p_db_discovery->db_hash_handle = BLE_GATT_HANDLE_INVALID;
+        cache_store(p_db_discovery, conn_handle);
+    }
+}
+
+
+/**@brief     Function for reading the Database Hash characteristic of the peer.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection handle.
+ * @param[in] state          Purpose of the read.
+ *
+ * @return    This function propagates the error code returned by @ref nrf_ble_gq_item_add.
+ */
+static uint32_t cache_hash_read(ble_db_discovery_t * p_db_discovery,
+                                uint16_t             conn_handle,
+                                uint8_t              state)
+{
+    uint32_t         err_code;
+    nrf_ble_gq_req_t db_hash_read_req;
+
+    memset(&db_hash_read_req, 0, sizeof(nrf_ble_gq_req_t));
+
+    db_hash_read_req.type                     = NRF_BLE_GQ_REQ_GATTC_READ;
+    db_hash_read_req.params.gattc_read.handle = p_db_discovery->db_hash_handle;
+    db_hash_read_req.params.gattc_read.offset = 0;
+    db_hash_read_req.error_handler.p_ctx      = p_db_discovery;
+    db_hash_read_req.error_handler.cb         = cache_error_handler;
+
+    err_code = nrf_ble_gq_item_add(mp_gatt_queue, &db_hash_read_req, conn_handle);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        p_db_discovery->cache_state = state;
+    }
+
+    return err_code;
+}
+
+
+/**@brief     Function for storing the database after a full discovery.
+ *
+ * @details   The Service Changed and Database Hash characteristics are taken from the discovered
+ *            GATT service. If the peer has a Database Hash, it is read before the database is
+ *            stored.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection handle.
+ */
+static void cache_fill(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    uint32_t srv_count = srv_disc_count_get();
+
+    for (uint32_t i = 0; i < srv_count; i++)
+    {
+        ble_gatt_db_srv_t const * p_srv = &p_db_discovery->services[i];
+
+        if ((p_srv->srv_uuid.uuid != BLE_UUID_GATT) || (p_srv->srv_uuid.type != BLE_UUID_TYPE_BLE))
+        {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < p_srv->char_count; j++)
+        {
+            ble_gattc_char_t const * p_char = &p_srv->charateristics[j].characteristic;
+
+            if (p_char->uuid.type != BLE_UUID_TYPE_BLE)
+            {
+                continue;
+            }
+
+            if (p_char->uuid.uuid == BLE_UUID_GATT_CHARACTERISTIC_SERVICE_CHANGED)
+            {
+                p_db_discovery->srv_changed_handle = p_char->handle_value;
+            }
+            else if (p_char->uuid.uuid == DB_CACHE_HASH_UUID)
+            {
+                p_db_discovery->db_hash_handle = p_char->handle_value;
+            }
+        }
+    }
+
+    if (cache_peer_id_get(conn_handle) == PM_PEER_ID_INVALID)
+    {
+        return;
+    }
+
+    if ((p_db_discovery->db_hash_handle != BLE_GATT_HANDLE_INVALID) &&
+        (cache_hash_read(p_db_discovery, conn_handle, DB_CACHE_STATE_FILL) == NRF_SUCCESS))
+    {
+        return;
+    }
+
+    p_db_discovery->db_hash_handle = BLE_GATT_HANDLE_INVALID;
+    cache_store(p_db_discovery, conn_handle);
+}
+
+
+/**@brief     Function for starting the discovery from the stored database.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection handle.
+ *
+ * @retval    True if the stored database is used.
+ * @retval    False if full discovery must be performed.
+ */
+static bool cache_start(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    // The instance is cleared below, so its database can no longer be stored.
+    cache_queue_remove(p_db_discovery);
+
+    memset(p_db_discovery, 0x00, sizeof(ble_db_discovery_t));
+
+    stats_start(p_db_discovery);
+
+    if (!cache_load(p_db_discovery, conn_handle) ||
+        (nrf_ble_gq_conn_handle_register(mp_gatt_queue, conn_handle) != NRF_SUCCESS))
+    {
+        return false;
+    }
+
+    p_db_discovery->conn_handle           = conn_handle;
+    p_db_discovery->discovery_in_progress = true;
+
+    if (p_db_discovery->db_hash_handle == BLE_GATT_HANDLE_INVALID)
+    {
+        cache_replay(p_db_discovery, conn_handle);
+        return true;
+    }
+
+    // The stored database is used only if the Database Hash of the peer has not changed.
+    return (cache_hash_read(p_db_discovery, conn_handle, DB_CACHE_STATE_CHECK) == NRF_SUCCESS);
+}
+
+
+/**@brief     Function for handling read response of the Database Hash characteristic.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_read_rsp(ble_db_discovery_t       * p_db_discovery,
+                        ble_gattc_evt_t    const * p_ble_gattc_evt)
+{
+    ble_gattc_evt_read_rsp_t const * p_read_rsp = &(p_ble_gattc_evt->params.read_rsp);
+    uint8_t                          state      = p_db_discovery->cache_state;
+    bool                             is_success;
+    uint16_t                         handle;
+
+    is_success = (p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS);
+    handle     = is_success ? p_read_rsp->handle : p_ble_gattc_evt->error_handle;
+
+    if ((p_ble_gattc_evt->conn_handle != p_db_discovery->conn_handle) ||
+        (state == DB_CACHE_STATE_IDLE)                                 ||
+        (handle != p_db_discovery->db_hash_handle))
+    {
+        return;
+    }
+
+    p_db_discovery->cache_state = DB_CACHE_STATE_IDLE;
+    p_db_discovery->stats.rsp_count++;
+
+    is_success = is_success                                      &&
+                 (p_read_rsp->offset == 0)                       &&
+                 (p_read_rsp->len == BLE_DB_DISCOVERY_DB_HASH_LEN);
+
+    if (state == DB_CACHE_STATE_CHECK)
+    {
+        if (is_success &&
+            (memcmp(p_read_rsp->data, p_db_discovery->db_hash, BLE_DB_DISCOVERY_DB_HASH_LEN) == 0))
+        {
+            cache_replay(p_db_discovery, p_ble_gattc_evt->conn_handle);
+        }
+        else
+        {
+            cache_invalidate(p_ble_gattc_evt->conn_handle);
+            cache_fallback(p_db_discovery, p_ble_gattc_evt->conn_handle);
+        }
+    }
+    else
+    {
+        if (is_success)
+        {
+            memcpy(p_db_discovery->db_hash, p_read_rsp->data, BLE_DB_DISCOVERY_DB_HASH_LEN);
+        }
+        else
+        {
+            p_db_discovery->db_hash_handle = BLE_GATT_HANDLE_INVALID;
+        }
+
+        cache_store(p_db_discovery, p_ble_gattc_evt->conn_handle);
+    }
+}
+
+
+/**@brief     Function for handling Service Changed indications.
+ *
+ * @details   The stored database is invalidated. Confirming the indication and restarting the
+ *            discovery are left to the application, for example using the GATT Service Client.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_hvx(ble_db_discovery_t       * p_db_discovery,
+                   ble_gattc_evt_t    const * p_ble_gattc_evt)
+{
+    if ((p_ble_gattc_evt->conn_handle == p_db_discovery->conn_handle)          &&
+        (p_db_discovery->srv_changed_handle != BLE_GATT_HANDLE_INVALID)        &&
+        (p_ble_gattc_evt->params.hvx.handle == p_db_discovery->srv_changed_handle))
+    {
+        cache_invalidate(p_ble_gattc_evt->conn_handle);
+    }
+}
+#endif // BLE_DB_DISCOVERY_CACHE_ENABLED
+
+
+uint32_t ble_db_discovery_start(ble_db_discovery_t * const p_db_discovery, uint16_t conn_handle)
+{
+    VERIFY_PARAM_NOT_NULL(p_db_discovery);
+    VERIFY_MODULE_INITIALIZED();
+
+    if (m_num_of_handlers_reg == 0)
+    {
+        // No user modules were registered. There are no services to discover.
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (p_db_discovery->discovery_in_progress)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+    if (cache_start(p_db_discovery, conn_handle))
+    {
+        return NRF_SUCCESS;
+    }
+#endif
+
+    return discovery_start(p_db_discovery, conn_handle);
+}
+
+
+uint32_t ble_db_discovery_stats_get(ble_db_discovery_t const * p_db_discovery,
+                                    ble_db_discovery_stats_t * p_stats)
+{
+    VERIFY_PARAM_NOT_NULL(p_db_discovery);
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    *p_stats = p_db_discovery->stats;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief     Function for handling disconnected event.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GAP event.
+ */
+static void on_disconnected(ble_db_discovery_t       * p_db_discovery,
+                            ble_gap_evt_t      const * p_evt)
+{
+    if (p_evt->conn_handle == p_db_discovery->conn_handle)
+    {
+        p_db_discovery->discovery_in_progress = false;
+        p_db_discovery->conn_handle           = BLE_CONN_HANDLE_INVALID;
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+        p_db_discovery->cache_state           = DB_CACHE_STATE_IDLE;
+#endif
+    }
+}
+
+
+void ble_db_discovery_on_ble_evt(ble_evt_t const * p_ble_evt,
+                                 void            * p_context)
 {
     VERIFY_PARAM_NOT_NULL_VOID(p_ble_evt);
     VERIFY_PARAM_NOT_NULL_VOID(p_context);
@@ -1007,6 +2073,19 @@ void ble_db_discovery_on_ble_evt(ble_evt_t const * p_ble_evt,
 
     switch (p_ble_evt->header.evt_id)
     {
+#if BLE_DB_DISCOVERY_BATCH_ENABLED
+        case BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP:
+            on_batch_srv_discovery_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+
+        case BLE_GATTC_EVT_CHAR_DISC_RSP:
+            on_characteristic_discovery_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+
+        case BLE_GATTC_EVT_DESC_DISC_RSP:
+            on_batch_desc_discovery_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+#else
         case BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP:
             on_primary_srv_discovery_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
             break;
@@ -1018,6 +2097,17 @@ void ble_db_discovery_on_ble_evt(ble_evt_t const * p_ble_evt,
         case BLE_GATTC_EVT_DESC_DISC_RSP:
             on_descriptor_discovery_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
             break;
+#endif
+
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+        case BLE_GATTC_EVT_READ_RSP:
+            on_read_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+
+        case BLE_GATTC_EVT_HVX:
+            on_hvx(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+#endif
 
         case BLE_GAP_EVT_DISCONNECTED:
             on_disconnected(p_db_discovery, &(p_ble_evt->evt.gap_evt));
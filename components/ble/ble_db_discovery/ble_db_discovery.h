@@ -64,6 +64,19 @@
  * @note The application must propagate BLE stack events to this module by calling
  *       ble_db_discovery_on_ble_evt().
  *
+ * @note If @ref BLE_DB_DISCOVERY_CACHE_ENABLED is set, the discovered database of a bonded peer is
+ *       stored with Peer Manager as @ref PM_PEER_DATA_ID_GATT_REMOTE data. On the next connection,
+ *       the stored handles are passed to the application without discovery. If the peer has a
+ *       Database Hash characteristic, its value is read and compared first. The stored data is
+ *       invalidated when the hash differs or when a Service Changed indication is received.
+ *       The application must not use @ref PM_PEER_DATA_ID_GATT_REMOTE for other purposes.
+ *
+ * @note If @ref BLE_DB_DISCOVERY_BATCH_ENABLED is set, all primary services of the peer are read in
+ *       one pass instead of one discovery per registered service, and descriptors of all
+ *       characteristics of a service are discovered together. This reduces the number of GATT
+ *       round trips per connection. Connections are discovered in parallel because
+ *       @ref nrf_ble_gq keeps a separate queue for each connection.
+ *
  */
 
 #ifndef BLE_DB_DISCOVERY_H__
@@ -125,6 +138,22 @@ NRF_SDH_BLE_OBSERVERS(_name ## _obs,
 
 #define BLE_DB_DISCOVERY_MAX_SRV        6   /**< Maximum number of services supported by this module. This also indicates the maximum number of users allowed to be registered to this module (one user per service). */
 
+#ifndef BLE_DB_DISCOVERY_CACHE_ENABLED
+#define BLE_DB_DISCOVERY_CACHE_ENABLED  0   /**< Enable storing the discovered database of bonded peers. Requires Peer Manager. */
+#endif
+
+#ifndef BLE_DB_DISCOVERY_BATCH_ENABLED
+#define BLE_DB_DISCOVERY_BATCH_ENABLED  0   /**< Enable discovering all services and all descriptors of a service in batches. */
+#endif
+
+#define BLE_DB_DISCOVERY_DB_HASH_LEN    16  /**< Length of the Database Hash characteristic value. */
+
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+#define BLE_DB_DISCOVERY_SRV_SLOTS      (BLE_DB_DISCOVERY_MAX_SRV + 1)  /**< Number of services discovered on a connection. One slot is used for the GATT service if it is not registered by the application. */
+#else
+#define BLE_DB_DISCOVERY_SRV_SLOTS      BLE_DB_DISCOVERY_MAX_SRV        /**< Number of services discovered on a connection. */
+#endif
+
 
 /**@brief DB Discovery event type. */
 typedef enum
@@ -158,6 +187,13 @@ typedef struct
     ble_db_discovery_evt_handler_t evt_handler;  /**< Event handler which should be called to raise this event. */
 } ble_db_discovery_user_evt_t;
 
+/**@brief Structure containing the discovery metrics of a connection. */
+typedef struct
+{
+    uint32_t duration_ms; /**< Time from the start of the discovery to the @ref BLE_DB_DISCOVERY_AVAILABLE event, in milliseconds. Zero if the app_timer module is not enabled. */
+    uint16_t rsp_count;   /**< Number of GATT responses handled during the discovery. */
+} ble_db_discovery_stats_t;
+
 /**@brief Structure for holding the information related to the GATT database at the server.
  *
  * @details This module identifies a remote database. Use one instance of this structure per
@@ -165,9 +201,9 @@ typedef struct
  *
  * @warning This structure must be zero-initialized.
  */
-typedef struct
+typedef struct ble_db_discovery_s
 {
-    ble_gatt_db_srv_t           services[BLE_DB_DISCOVERY_MAX_SRV];         /**< Information related to the current service being discovered. This is intended for internal use during service discovery.*/
+    ble_gatt_db_srv_t           services[BLE_DB_DISCOVERY_SRV_SLOTS];       /**< Information related to the current service being discovered. This is intended for internal use during service discovery.*/
     uint8_t                     srv_count;                                  /**< Number of services at the peer's GATT database.*/
     uint8_t                     curr_char_ind;                              /**< Index of the current characteristic being discovered. This is intended for internal use during service discovery.*/
     uint8_t                     curr_srv_ind;                               /**< Index of the current service being discovered. This is intended for internal use during service discovery.*/
@@ -176,6 +212,17 @@ typedef struct
     uint16_t                    conn_handle;                                /**< Connection handle on which the discovery is started. */
     uint32_t                    pending_usr_evt_index;                      /**< The index to the pending user event array, pointing to the last added pending user event. */
     ble_db_discovery_user_evt_t pending_usr_evts[BLE_DB_DISCOVERY_MAX_SRV]; /**< Whenever a discovery related event is to be raised to a user module, it is stored in this array first. When all expected services have been discovered, all pending events are sent to the corresponding user modules. */
+    uint32_t                    start_ticks;                                /**< Timestamp of the start of the discovery. */
+    ble_db_discovery_stats_t    stats;                                      /**< Metrics of the last discovery. */
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+    uint16_t                    db_hash_handle;                             /**< Value handle of the Database Hash characteristic at the peer. This is intended for internal use by the discovery cache. */
+    uint16_t                    srv_changed_handle;                         /**< Value handle of the Service Changed characteristic at the peer. This is intended for internal use by the discovery cache. */
+    uint8_t                     db_hash[BLE_DB_DISCOVERY_DB_HASH_LEN];      /**< Database Hash of the stored database. This is intended for internal use by the discovery cache. */
+    uint8_t                     cache_state;                                /**< State of the Database Hash read. This is intended for internal use by the discovery cache. */
+    bool                        cache_store_queued;                         /**< Whether the database waits for the store operation of another peer to complete. This is intended for internal use by the discovery cache. */
+    uint16_t                    cache_peer_id;                              /**< Peer whose database waits to be stored. This is intended for internal use by the discovery cache. */
+    struct ble_db_discovery_s * p_cache_next;                               /**< Next instance waiting to store its database. This is intended for internal use by the discovery cache. */
+#endif
 } ble_db_discovery_t;
 
 /**@brief DB discovery module initialization struct. */
@@ -233,6 +280,10 @@ uint32_t ble_db_discovery_evt_register(const ble_uuid_t * const p_uuid);
 
 
 /**@brief Function for starting the discovery of the GATT database at the server.
+ *
+ * @details If @ref BLE_DB_DISCOVERY_CACHE_ENABLED is set and a valid database is stored for the
+ *          peer, the discovery events are raised from the stored data. This can happen before
+ *          this function returns.
  *
  * @param[out] p_db_discovery Pointer to the DB Discovery structure.
  * @param[in]  conn_handle    The handle of the connection for which the discovery should be
@@ -253,6 +304,20 @@ uint32_t ble_db_discovery_start(ble_db_discovery_t * p_db_discovery,
                                 uint16_t             conn_handle);
 
 
+/**@brief Function for getting the metrics of the last discovery.
+ *
+ * @details The metrics are complete when the @ref BLE_DB_DISCOVERY_AVAILABLE event is raised.
+ *
+ * @param[in]  p_db_discovery Pointer to the DB Discovery structure.
+ * @param[out] p_stats        Discovery metrics.
+ *
+ * @retval NRF_SUCCESS    Operation success.
+ * @retval NRF_ERROR_NULL When a NULL pointer is passed as input.
+ */
+uint32_t ble_db_discovery_stats_get(ble_db_discovery_t const * p_db_discovery,
+                                    ble_db_discovery_stats_t * p_stats);
+
+
 /**@brief Function for handling the Application's BLE Stack events.
  *
  * @param[in]     p_ble_evt Pointer to the BLE event received.
@@ -42,6 +42,9 @@
 #include "ble.h"
 #include "ble_nus.h"
 #include "ble_srv_common.h"
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM)
+#include "app_timer.h"
+#endif
 
 #define NRF_LOG_MODULE_NAME ble_nus
 #if BLE_NUS_CONFIG_LOG_ENABLED
@@ -215,6 +218,209 @@ static void on_hvx_tx_complete(ble_nus_t * p_nus, ble_evt_t const * p_ble_evt)
 }
 
 
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM)
+/**@brief Function for taking data from the stream buffer.
+ *
+ * @details If another context holds the buffer, the pending flag is set and the buffer is tried
+ *          once more. Either the buffer is taken here, or the holder finds the flag after it
+ *          releases the buffer and sends again.
+ *
+ * @param[in]     p_stream Stream instance.
+ * @param[out]    pp_data  Pointer to the data.
+ * @param[in,out] p_len    Maximum length of the data. Length of the data taken.
+ *
+ * @retval NRF_SUCCESS       If the buffer was taken or it is empty.
+ * @retval NRF_ERROR_BUSY    If another context holds the buffer.
+ */
+static ret_code_t stream_get(ble_nus_stream_t * p_stream, uint8_t ** pp_data, size_t * p_len)
+{
+    size_t     max_len  = *p_len;
+    ret_code_t err_code = nrf_ringbuf_get(p_stream->p_ringbuf, pp_data, p_len, true);
+
+    if (err_code == NRF_ERROR_BUSY)
+    {
+        UNUSED_RETURN_VALUE(nrf_atomic_flag_set(&p_stream->pending));
+
+        *p_len   = max_len;
+        err_code = nrf_ringbuf_get(p_stream->p_ringbuf, pp_data, p_len, true);
+    }
+
+    return err_code;
+}
+
+
+/**@brief Function for sending buffered stream data until the buffer is empty or the SoftDevice
+ *        TX queue is full.
+ *
+ * @param[in] p_stream     Stream instance.
+ * @param[in] p_hvx_params Notification parameters with the handle and type set.
+ * @param[in] max_len      Maximum length of a notification.
+ *
+ * @retval true  If the buffer was released by this context.
+ * @retval false If another context holds the buffer.
+ */
+static bool stream_send(ble_nus_stream_t       * p_stream,
+                        ble_gatts_hvx_params_t * p_hvx_params,
+                        uint16_t                 max_len)
+{
+    ret_code_t err_code;
+    uint8_t    chunk[BLE_NUS_MAX_DATA_LEN];
+
+    for (;;)
+    {
+        uint8_t * p_data;
+        size_t    len = max_len;
+        uint16_t  hvx_len;
+
+        err_code = stream_get(p_stream, &p_data, &len);
+        if (err_code != NRF_SUCCESS)
+        {
+            return false;
+        }
+        if (len == 0)
+        {
+            return true;
+        }
+
+        if (len < max_len)
+        {
+            uint8_t * p_tail;
+            size_t    tail_len = max_len - len;
+
+            // Data wraps around the end of the buffer. Gather it so that the packet is filled.
+            UNUSED_RETURN_VALUE(nrf_ringbuf_get(p_stream->p_ringbuf, &p_tail, &tail_len, false));
+            if (tail_len > 0)
+            {
+                memcpy(chunk, p_data, len);
+                memcpy(&chunk[len], p_tail, tail_len);
+                p_data = chunk;
+                len   += tail_len;
+            }
+        }
+
+        hvx_len              = (uint16_t)len;
+        p_hvx_params->p_data = p_data;
+        p_hvx_params->p_len  = &hvx_len;
+
+        err_code = sd_ble_gatts_hvx(p_stream->conn_handle, p_hvx_params);
+        if (err_code != NRF_SUCCESS)
+        {
+            // Data is left in the buffer.
+            UNUSED_RETURN_VALUE(nrf_ringbuf_free(p_stream->p_ringbuf, 0));
+
+            if (err_code == NRF_ERROR_RESOURCES)
+            {
+                // Sending is resumed on BLE_GATTS_EVT_HVN_TX_COMPLETE.
+                p_stream->stats.tx_queue_full++;
+            }
+            else
+            {
+                NRF_LOG_DEBUG("Stream notification failed: 0x%08X.", err_code);
+            }
+            return true;
+        }
+
+        UNUSED_RETURN_VALUE(nrf_ringbuf_free(p_stream->p_ringbuf, hvx_len));
+        p_stream->stats.tx_bytes += hvx_len;
+        p_stream->stats.tx_packets++;
+    }
+}
+
+
+/**@brief Function for sending buffered stream data.
+ *
+ * @details Only one context can take data from the buffer at a time. A context that finds the
+ *          buffer busy sets the pending flag, and the holder sends again after releasing the
+ *          buffer. This way neither new data nor a @ref BLE_GATTS_EVT_HVN_TX_COMPLETE that
+ *          arrives while the buffer is held is lost.
+ *
+ * @param[in] p_stream Stream instance.
+ */
+static void stream_process(ble_nus_stream_t * p_stream)
+{
+    ret_code_t                 err_code;
+    ble_gatts_hvx_params_t     hvx_params;
+    ble_nus_client_context_t * p_client;
+    uint16_t                   max_len;
+
+    if (p_stream->conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return;
+    }
+
+    err_code = blcm_link_ctx_get(p_stream->p_nus->p_link_ctx_storage,
+                                 p_stream->conn_handle,
+                                 (void *) &p_client);
+    if ((err_code != NRF_SUCCESS) || (p_client == NULL) || !p_client->is_notification_enabled)
+    {
+        return;
+    }
+
+    max_len = nrf_ble_gatt_eff_mtu_get(p_stream->p_gatt, p_stream->conn_handle);
+    if (max_len <= OPCODE_LENGTH + HANDLE_LENGTH)
+    {
+        return;
+    }
+    max_len = MIN(max_len - OPCODE_LENGTH - HANDLE_LENGTH, BLE_NUS_MAX_DATA_LEN);
+
+    memset(&hvx_params, 0, sizeof(hvx_params));
+    hvx_params.handle = p_stream->p_nus->tx_handles.value_handle;
+    hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+
+    do
+    {
+        if (!stream_send(p_stream, &hvx_params, max_len))
+        {
+            // The holder of the buffer sends again after releasing it.
+            return;
+        }
+    } while (nrf_atomic_flag_clear_fetch(&p_stream->pending));
+}
+
+
+/**@brief Function for passing the BLE events to the streams attached to the instance.
+ *
+ * @param[in] p_nus     Nordic UART Service structure.
+ * @param[in] p_ble_evt Pointer to the event received from BLE stack.
+ */
+static void on_stream_evt(ble_nus_t * p_nus, ble_evt_t const * p_ble_evt)
+{
+    uint16_t conn_handle = p_ble_evt->evt.common_evt.conn_handle;
+
+    for (ble_nus_stream_t * p_stream = p_nus->p_stream_head;
+         p_stream != NULL;
+         p_stream = p_stream->p_next)
+    {
+        if (p_stream->conn_handle != conn_handle)
+        {
+            continue;
+        }
+
+        switch (p_ble_evt->header.evt_id)
+        {
+            case BLE_GAP_EVT_DISCONNECTED:
+                p_stream->conn_handle = BLE_CONN_HANDLE_INVALID;
+                break;
+
+            case BLE_GATTC_EVT_EXCHANGE_MTU_RSP:
+            case BLE_GATTS_EVT_EXCHANGE_MTU_REQUEST:
+                // The GATT module has already updated the effective ATT_MTU, so data that was
+                // held back is sent in notifications of the new length.
+            case BLE_GATTS_EVT_WRITE:
+                // Notifications may have been enabled.
+            case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+                stream_process(p_stream);
+                break;
+
+            default:
+                // No implementation needed.
+                break;
+        }
+    }
+}
+#endif // NRF_MODULE_ENABLED(BLE_NUS_STREAM)
+
+
 void ble_nus_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
 {
     if ((p_context == NULL) || (p_ble_evt == NULL))
@@ -242,6 +448,10 @@ void ble_nus_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
             // No implementation needed.
             break;
     }
+
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM)
+    on_stream_evt(p_nus, p_ble_evt);
+#endif
 }
 
 
@@ -351,4 +561,93 @@ uint32_t ble_nus_data_send(ble_nus_t * p_nus,
 }
 
 
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM)
+ret_code_t ble_nus_stream_init(ble_nus_stream_t     * p_stream,
+                               ble_nus_t            * p_nus,
+                               nrf_ble_gatt_t const * p_gatt)
+{
+    VERIFY_PARAM_NOT_NULL(p_stream);
+    VERIFY_PARAM_NOT_NULL(p_nus);
+    VERIFY_PARAM_NOT_NULL(p_gatt);
+
+    p_stream->p_nus       = p_nus;
+    p_stream->p_gatt      = p_gatt;
+    p_stream->conn_handle = BLE_CONN_HANDLE_INVALID;
+    nrf_ringbuf_init(p_stream->p_ringbuf);
+
+    // The stream is linked before it becomes visible to the event handler.
+    p_stream->p_next     = p_nus->p_stream_head;
+    p_nus->p_stream_head = p_stream;
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ble_nus_stream_conn_handle_assign(ble_nus_stream_t * p_stream, uint16_t conn_handle)
+{
+    VERIFY_PARAM_NOT_NULL(p_stream);
+
+    nrf_ringbuf_init(p_stream->p_ringbuf);
+    memset(&p_stream->stats, 0, sizeof(p_stream->stats));
+    p_stream->rate_bytes  = 0;
+    p_stream->rate_ticks  = app_timer_cnt_get();
+    p_stream->conn_handle = conn_handle;
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ble_nus_stream_write(ble_nus_stream_t * p_stream,
+                                uint8_t const    * p_data,
+                                size_t           * p_length)
+{
+    ret_code_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_stream);
+    VERIFY_PARAM_NOT_NULL(p_data);
+    VERIFY_PARAM_NOT_NULL(p_length);
+
+    if (p_stream->conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    err_code = nrf_ringbuf_cpy_put(p_stream->p_ringbuf, p_data, p_length);
+    VERIFY_SUCCESS(err_code);
+
+    stream_process(p_stream);
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ble_nus_stream_stats_get(ble_nus_stream_t * p_stream, ble_nus_stream_stats_t * p_stats)
+{
+    uint32_t ticks;
+    uint32_t elapsed;
+    uint32_t tx_bytes;
+
+    VERIFY_PARAM_NOT_NULL(p_stream);
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    ticks    = app_timer_cnt_get();
+    elapsed  = app_timer_cnt_diff_compute(ticks, p_stream->rate_ticks);
+    tx_bytes = p_stream->stats.tx_bytes;
+
+    if (elapsed > 0)
+    {
+        p_stream->stats.bytes_per_sec =
+            (uint32_t)(((uint64_t)(tx_bytes - p_stream->rate_bytes) * APP_TIMER_CLOCK_FREQ) /
+                       ((uint64_t)elapsed * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)));
+        p_stream->rate_ticks = ticks;
+        p_stream->rate_bytes = tx_bytes;
+    }
+
+    *p_stats = p_stream->stats;
+
+    return NRF_SUCCESS;
+}
+#endif // NRF_MODULE_ENABLED(BLE_NUS_STREAM)
+
+
 #endif // NRF_MODULE_ENABLED(BLE_NUS)
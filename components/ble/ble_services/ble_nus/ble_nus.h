@@ -70,6 +70,11 @@
 #include "ble_srv_common.h"
 #include "nrf_sdh_ble.h"
 #include "ble_link_ctx_manager.h"
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM)
+#include "nrf_ble_gatt.h"
+#include "nrf_ringbuf.h"
+#include "nrf_atomic.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -94,6 +99,22 @@ extern "C" {
                          ble_nus_on_ble_evt,                      \
                          &_name)
 
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM) || defined(__SDK_DOXYGEN__)
+/**@brief   Macro for defining a ble_nus TX stream instance.
+ *
+ * @param     _name     Name of the instance.
+ * @param[in] _buf_size Size of the stream buffer in bytes. Must be a power of 2.
+ * @hideinitializer
+ */
+#define BLE_NUS_STREAM_DEF(_name, _buf_size)                        \
+    NRF_RINGBUF_DEF(CONCAT_2(_name, _ringbuf), _buf_size);          \
+    static ble_nus_stream_t _name =                                 \
+    {                                                               \
+        .p_ringbuf   = &CONCAT_2(_name, _ringbuf),                  \
+        .conn_handle = BLE_CONN_HANDLE_INVALID                      \
+    }
+#endif
+
 #define BLE_UUID_NUS_SERVICE 0x0001 /**< The UUID of the Nordic UART Service. */
 
 #define OPCODE_LENGTH        1
@@ -121,6 +142,9 @@ typedef enum
 /* Forward declaration of the ble_nus_t type. */
 typedef struct ble_nus_s ble_nus_t;
 
+/* Forward declaration of the ble_nus_stream_t type. */
+typedef struct ble_nus_stream_s ble_nus_stream_t;
+
 
 /**@brief   Nordic UART Service @ref BLE_NUS_EVT_RX_DATA event data.
  *
@@ -188,9 +212,43 @@ struct ble_nus_s
     ble_gatts_char_handles_t        rx_handles;         /**< Handles related to the RX characteristic (as provided by the SoftDevice). */
     blcm_link_ctx_storage_t * const p_link_ctx_storage; /**< Pointer to link context storage with handles of all current connections and its context. */
     ble_nus_data_handler_t          data_handler;       /**< Event handler to be called for handling received data. */
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM)
+    ble_nus_stream_t              * p_stream_head;      /**< List of TX streams attached to this instance. */
+#endif
 };
 
 
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM) || defined(__SDK_DOXYGEN__)
+/**@brief   Nordic UART Service TX stream statistics. */
+typedef struct
+{
+    uint32_t tx_bytes;      /**< Number of bytes accepted by the SoftDevice since the stream was assigned to the connection. */
+    uint32_t tx_packets;    /**< Number of notifications accepted by the SoftDevice. */
+    uint32_t tx_queue_full; /**< Number of times the SoftDevice TX queue was full. */
+    uint32_t bytes_per_sec; /**< Throughput achieved since the previous call to @ref ble_nus_stream_stats_get. */
+} ble_nus_stream_stats_t;
+
+
+/**@brief   Nordic UART Service TX stream structure.
+ *
+ * @details This structure contains status information related to the stream. It must be defined
+ *          with @ref BLE_NUS_STREAM_DEF.
+ */
+struct ble_nus_stream_s
+{
+    nrf_ringbuf_t const  * p_ringbuf;   /**< Buffer with data waiting for transmission. */
+    ble_nus_t            * p_nus;       /**< Nordic UART Service instance used for sending. */
+    nrf_ble_gatt_t const * p_gatt;      /**< GATT module instance used to get the ATT_MTU of the connection. */
+    ble_nus_stream_t     * p_next;      /**< Next stream attached to the same service instance. */
+    uint16_t               conn_handle; /**< Connection handle of the destination client. */
+    nrf_atomic_flag_t      pending;     /**< Set when sending was requested while the buffer was held by another context. */
+    uint32_t               rate_ticks;  /**< Timestamp of the previous throughput measurement. */
+    uint32_t               rate_bytes;  /**< Number of sent bytes at the time of the previous throughput measurement. */
+    ble_nus_stream_stats_t stats;       /**< Stream statistics. */
+};
+#endif
+
+
 /**@brief   Function for initializing the Nordic UART Service.
  *
  * @param[out] p_nus      Nordic UART Service structure. This structure must be supplied
@@ -235,6 +293,82 @@ uint32_t ble_nus_data_send(ble_nus_t * p_nus,
                            uint16_t    conn_handle);
 
 
+#if NRF_MODULE_ENABLED(BLE_NUS_STREAM) || defined(__SDK_DOXYGEN__)
+/**@brief   Function for attaching a TX stream to the Nordic UART Service instance.
+ *
+ * @details Data written to the stream is buffered and sent as notifications of the TX
+ *          characteristic. Each notification is filled up to the ATT_MTU negotiated on the
+ *          connection, and the stream is refilled on every @ref BLE_GATTS_EVT_HVN_TX_COMPLETE
+ *          event, so no flow control is needed in the application. Throughput is measured
+ *          with the app_timer counter, which must be running.
+ *
+ * @note    The notification length follows ATT_MTU exchanges made after the stream was
+ *          assigned to the connection. For this, the GATT module must handle BLE events before
+ *          this service: NRF_BLE_GATT_BLE_OBSERVER_PRIO must be lower than
+ *          BLE_NUS_BLE_OBSERVER_PRIO.
+ *
+ * @param[in] p_stream Stream instance defined with @ref BLE_NUS_STREAM_DEF.
+ * @param[in] p_nus    Initialized Nordic UART Service instance.
+ * @param[in] p_gatt   GATT module instance.
+ *
+ * @retval NRF_SUCCESS    If the stream was attached.
+ * @retval NRF_ERROR_NULL If any of the pointers is NULL.
+ */
+ret_code_t ble_nus_stream_init(ble_nus_stream_t     * p_stream,
+                               ble_nus_t            * p_nus,
+                               nrf_ble_gatt_t const * p_gatt);
+
+
+/**@brief   Function for assigning a connection to the stream.
+ *
+ * @details Data that is left in the stream is discarded and statistics are cleared. The stream is
+ *          detached from the connection automatically when the link is disconnected.
+ *
+ * @param[in] p_stream    Stream instance.
+ * @param[in] conn_handle Connection handle of the destination client.
+ *
+ * @retval NRF_SUCCESS    If the connection was assigned.
+ * @retval NRF_ERROR_NULL If @p p_stream is NULL.
+ */
+ret_code_t ble_nus_stream_conn_handle_assign(ble_nus_stream_t * p_stream, uint16_t conn_handle);
+
+
+/**@brief   Function for writing data to the stream.
+ *
+ * @details Data is copied to the stream buffer and transmission is started if the peer has
+ *          enabled notifications. If the buffer cannot hold all the data, only the part that
+ *          fits is copied. The rest can be written after the next @ref BLE_NUS_EVT_TX_RDY event.
+ *
+ * @param[in]     p_stream Stream instance.
+ * @param[in]     p_data   Data to be sent.
+ * @param[in,out] p_length Length of the data. Number of bytes copied to the stream.
+ *
+ * @retval NRF_SUCCESS             If the data was copied.
+ * @retval NRF_ERROR_NULL          If any of the pointers is NULL.
+ * @retval NRF_ERROR_INVALID_STATE If no connection is assigned to the stream.
+ * @retval NRF_ERROR_BUSY          If the stream is being written from another context.
+ */
+ret_code_t ble_nus_stream_write(ble_nus_stream_t * p_stream,
+                                uint8_t const    * p_data,
+                                size_t           * p_length);
+
+
+/**@brief   Function for getting the stream statistics.
+ *
+ * @details The throughput is calculated over the time elapsed since the previous call of this
+ *          function or since the connection was assigned. The function must be called at least
+ *          once per app_timer counter period.
+ *
+ * @param[in]  p_stream Stream instance.
+ * @param[out] p_stats  Stream statistics.
+ *
+ * @retval NRF_SUCCESS    If the statistics were copied.
+ * @retval NRF_ERROR_NULL If any of the pointers is NULL.
+ */
+ret_code_t ble_nus_stream_stats_get(ble_nus_stream_t * p_stream, ble_nus_stream_stats_t * p_stats);
+#endif
+
+
 #ifdef __cplusplus
 }
 #endif
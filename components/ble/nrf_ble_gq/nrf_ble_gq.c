@@ -170,21 +170,154 @@ __STATIC_INLINE void request_err_code_handle(nrf_ble_gq_req_t const * const p_re
 }
 
 
+/**@brief Function gets the UUID used to filter primary service discovery.
+ *
+ * @param[in] p_srv_disc Pointer to the service discovery parameters.
+ *
+ * @return Pointer to the UUID or NULL if all primary services are to be discovered.
+ */
+static ble_uuid_t const * srv_disc_uuid_get(nrf_ble_gq_gattc_srv_discovery_t const * const p_srv_disc)
+{
+    return (p_srv_disc->srvc_uuid.type == BLE_UUID_TYPE_UNKNOWN) ? NULL : &p_srv_disc->srvc_uuid;
+}
+
+
+/**@brief Function checks if the request is transmitted from the SoftDevice TX queue without
+ *        waiting for a response from the peer (notification or write command).
+ *
+ * @param[in] p_req  Pointer to GATT request.
+ *
+ * @retval    true   If the request uses the SoftDevice TX queue.
+ * @retval    false  Otherwise.
+ */
+static bool is_tx_queued(nrf_ble_gq_req_t const * const p_req)
+{
+    switch (p_req->type)
+    {
+        case NRF_BLE_GQ_REQ_GATTC_WRITE:
+            return (p_req->params.gattc_write.write_op == BLE_GATT_OP_WRITE_CMD);
+
+        case NRF_BLE_GQ_REQ_GATTS_HVX:
+            return (p_req->params.gatts_hvx.type == BLE_GATT_HVX_NOTIFICATION);
+
+        default:
+            return false;
+    }
+}
+
+
+/**@brief Function checks if the request can be submitted to the SoftDevice now.
+ *
+ * @param[in] p_req   Pointer to GATT request.
+ * @param[in] p_link  Pointer to the link statistics.
+ *
+ * @retval    true   If the request can be submitted.
+ * @retval    false  If the in-flight window of the link is full.
+ */
+static bool is_window_open(nrf_ble_gq_req_t const * const p_req, nrf_ble_gq_stats_t const * p_link)
+{
+#if NRF_BLE_GQ_TX_WINDOW_SIZE
+    return !is_tx_queued(p_req) || (p_link->in_flight < NRF_BLE_GQ_TX_WINDOW_SIZE);
+#else
+    UNUSED_PARAMETER(p_req);
+    UNUSED_PARAMETER(p_link);
+    return true;
+#endif
+}
+
+
+/**@brief Function checks if the request must be retried later.
+ *
+ * @param[in] p_req     Pointer to GATT request.
+ * @param[in] p_link    Pointer to the link statistics.
+ * @param[in] err_code  Error code returned by SoftDevice.
+ *
+ * @retval    true   If SoftDevice is busy or its TX queue is full.
+ * @retval    false  If the request has been processed.
+ */
+static bool is_retry_needed(nrf_ble_gq_req_t const * const p_req,
+                            nrf_ble_gq_stats_t       *     p_link,
+                            ret_code_t                     err_code)
+{
+    if (err_code == NRF_ERROR_BUSY) // Softdevice is processing another GATT request.
+    {
+        NRF_LOG_DEBUG("SD is currently busy. The GATT request procedure will be attempted \
+                      again later.");
+        return true;
+    }
+
+    if ((err_code == NRF_ERROR_RESOURCES) && is_tx_queued(p_req))
+    {
+        p_link->tx_queue_full++;
+#if NRF_BLE_GQ_TX_WINDOW_SIZE
+        // Request is submitted again when SoftDevice reports that packets were transmitted.
+        NRF_LOG_DEBUG("SD TX queue is full. The GATT request will be attempted again later.");
+        return true;
+#endif
+    }
+
+    return false;
+}
+
+
+/**@brief Function updates the link statistics after the request has been accepted by SoftDevice.
+ *
+ * @param[in] p_req   Pointer to GATT request.
+ * @param[in] p_link  Pointer to the link statistics.
+ * @param[in] len     Length of the request payload.
+ */
+static void tx_stats_update(nrf_ble_gq_req_t const * const p_req,
+                            nrf_ble_gq_stats_t       *     p_link,
+                            uint16_t                       len)
+{
+    if (!is_tx_queued(p_req))
+    {
+        return;
+    }
+
+    p_link->tx_packets++;
+    p_link->tx_bytes += len;
+    p_link->in_flight++;
+
+    if (p_link->in_flight_max < p_link->in_flight)
+    {
+        p_link->in_flight_max = p_link->in_flight;
+    }
+}
+
+
 /**@brief Function processes subsequent requests from the BGQ instance queue.
+ *
+ * @details If @ref NRF_BLE_GQ_TX_WINDOW_SIZE is set, requests are submitted until SoftDevice is
+ *          busy, its TX queue is full or the in-flight window of the link is full. Otherwise, one
+ *          request is submitted.
  *
  * @param[in] p_queue      Pointer to the queue instance.
+ * @param[in] p_link       Pointer to the link statistics.
  * @param[in] conn_handle  Connection handle.
  */
-static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handle)
+static void queue_process(nrf_queue_t const * const p_queue,
+                          nrf_ble_gq_stats_t      * p_link,
+                          uint16_t                  conn_handle)
 {
     ret_code_t       err_code;
     nrf_ble_gq_req_t ble_req;
+    bool             more = true;
 
     NRF_LOG_DEBUG("Processing the request queue...");
 
-    err_code = nrf_queue_peek(p_queue, &ble_req);
-    if (err_code == NRF_SUCCESS) // Queue is not empty
+    while (more && (nrf_queue_peek(p_queue, &ble_req) == NRF_SUCCESS)) // Queue is not empty
     {
+        uint16_t len = 0;
+
+        if (!is_window_open(&ble_req, p_link))
+        {
+            NRF_LOG_DEBUG("In-flight window is full.");
+            break;
+        }
+
+        err_code = NRF_SUCCESS;
+
         switch (ble_req.type)
         {
             case NRF_BLE_GQ_REQ_GATTC_READ:
@@ -196,17 +329,28 @@ static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handl
 
             case NRF_BLE_GQ_REQ_GATTC_WRITE:
             {
-                uint8_t write_data[NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN];
+                uint8_t            write_data[NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN];
+                nrf_memobj_iovec_t iov;
 
-                // Retrieve allocated data.
-                ble_req.params.gattc_write.p_value = write_data;
-                nrf_memobj_read(ble_req.p_mem_obj,
-                                (void *) ble_req.params.gattc_write.p_value,
-                                ble_req.params.gattc_write.len, 0);
+                // Retrieve allocated data. It is copied only if it does not fit in one chunk.
+                if ((nrf_memobj_iovec_get(ble_req.p_mem_obj, 0,
+                                          ble_req.params.gattc_write.len, &iov, 1) == 1) &&
+                    (iov.len == ble_req.params.gattc_write.len))
+                {
+                    ble_req.params.gattc_write.p_value = iov.p_base;
+                }
+                else
+                {
+                    ble_req.params.gattc_write.p_value = write_data;
+                    nrf_memobj_read(ble_req.p_mem_obj,
+                                    (void *) ble_req.params.gattc_write.p_value,
+                                    ble_req.params.gattc_write.len, 0);
+                }
 
                 NRF_LOG_DEBUG("GATTC Write Request");
                 err_code = sd_ble_gattc_write(conn_handle,
                                               &ble_req.params.gattc_write);
+                len      = ble_req.params.gattc_write.len;
             } break;
 
             case NRF_BLE_GQ_REQ_SRV_DISCOVERY:
@@ -214,7 +358,7 @@ static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handl
                 NRF_LOG_DEBUG("GATTC Primary Service Discovery Request");
                 err_code = sd_ble_gattc_primary_services_discover(conn_handle,
                                                                   ble_req.params.gattc_srv_disc.start_handle,
-                                                                  &ble_req.params.gattc_srv_disc.srvc_uuid);
+                                                                  srv_disc_uuid_get(&ble_req.params.gattc_srv_disc));
             } break;
 
             case NRF_BLE_GQ_REQ_CHAR_DISCOVERY:
@@ -233,21 +377,30 @@ static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handl
 
             case NRF_BLE_GQ_REQ_GATTS_HVX:
             {
-                uint8_t  hvx_data[NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN];
-                uint16_t len;
-                uint16_t hvx_len;
+                uint8_t            hvx_data[NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN];
+                uint16_t           hvx_len;
+                nrf_memobj_iovec_t iov;
 
-                // Retrieve allocated data.
-                ble_req.params.gatts_hvx.p_data = hvx_data;
+                // Retrieve allocated data. It is copied only if it does not fit in one chunk.
                 nrf_memobj_read(ble_req.p_mem_obj,
                                 (void *) &hvx_len,
                                 sizeof(uint16_t),
                                 0);
                 ble_req.params.gatts_hvx.p_len = &hvx_len;
-                nrf_memobj_read(ble_req.p_mem_obj,
-                                (void *) ble_req.params.gatts_hvx.p_data,
-                                *ble_req.params.gatts_hvx.p_len,
-                                sizeof(uint16_t));
+                if ((nrf_memobj_iovec_get(ble_req.p_mem_obj, sizeof(uint16_t),
+                                          hvx_len, &iov, 1) == 1) &&
+                    (iov.len == hvx_len))
+                {
+                    ble_req.params.gatts_hvx.p_data = iov.p_base;
+                }
+                else
+                {
+                    ble_req.params.gatts_hvx.p_data = hvx_data;
+                    nrf_memobj_read(ble_req.p_mem_obj,
+                                    (void *) ble_req.params.gatts_hvx.p_data,
+                                    *ble_req.params.gatts_hvx.p_len,
+                                    sizeof(uint16_t));
+                }
 
                 len = hvx_len;
 
@@ -267,27 +420,48 @@ static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handl
                 break;
         }
 
-        if (err_code == NRF_ERROR_BUSY) // Softdevice is processing another GATT request.
+        if (is_retry_needed(&ble_req, p_link, err_code))
         {
-            NRF_LOG_DEBUG("SD is currently busy. The GATT request procedure will be attempted \
-                          again later.");
+            break;
         }
-        else
+
+        if (err_code == NRF_SUCCESS)
         {
-            // Remove last request descriptor from the queue and free data associated with it.
-            if (m_req_data_alloc[ble_req.type] != NULL)
-            {
-                nrf_memobj_free(ble_req.p_mem_obj);
-                NRF_LOG_DEBUG("Pointer to freed memory block: %p.", ble_req.p_mem_obj);
-            }
-            UNUSED_RETURN_VALUE(nrf_queue_pop(p_queue, &ble_req));
+            tx_stats_update(&ble_req, p_link, len);
+        }
 
-            request_err_code_handle(&ble_req, conn_handle, err_code);
+        // Remove last request descriptor from the queue and free data associated with it.
+        if (m_req_data_alloc[ble_req.type] != NULL)
+        {
+            nrf_memobj_free(ble_req.p_mem_obj);
+            NRF_LOG_DEBUG("Pointer to freed memory block: %p.", ble_req.p_mem_obj);
         }
+        UNUSED_RETURN_VALUE(nrf_queue_pop(p_queue, &ble_req));
+
+        request_err_code_handle(&ble_req, conn_handle, err_code);
+
+        more = (NRF_BLE_GQ_TX_WINDOW_SIZE > 0);
     }
 }
 
 
+/**@brief Function updates the link statistics when SoftDevice reports transmitted packets.
+ *
+ * @details The reported packets may also include notifications or write commands which were not
+ *          sent through the BGQ instance, so the in-flight counter never goes below zero.
+ *
+ * @param[in] p_link  Pointer to the link statistics.
+ * @param[in] count   Number of transmitted packets.
+ */
+static void tx_complete_handle(nrf_ble_gq_stats_t * p_link, uint8_t count)
+{
+    uint16_t completed = MIN(count, p_link->in_flight);
+
+    p_link->in_flight   -= completed;
+    p_link->tx_complete += completed;
+}
+
+
 /**@brief Function purges all requests from BGQ instance queues that are
  *        no longer used by any connection.
  *
@@ -330,14 +504,23 @@ static void queues_purge(nrf_ble_gq_t const * const p_gatt_queue)
 /**@brief Function processes single GATT request without queue.
  *
  * @param[in] p_req        Pointer to GATT request.
+ * @param[in] p_link       Pointer to the link statistics.
  * @param[in] conn_handle  Connection handle.
  *
  * @retval  true   If request is accepted by Softdevice.
  * @retval  false  If Softdevice is busy and the request should be queued.
  */
-static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_handle)
+static bool request_process(nrf_ble_gq_req_t const * const p_req,
+                            nrf_ble_gq_stats_t       *     p_link,
+                            uint16_t                       conn_handle)
 {
     ret_code_t err_code = NRF_SUCCESS;
+    uint16_t   len      = 0;
+
+    if (!is_window_open(p_req, p_link))
+    {
+        return false;
+    }
 
     switch (p_req->type)
     {
@@ -352,13 +535,14 @@ static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_
             NRF_LOG_DEBUG("GATTC Write Request");
             err_code = sd_ble_gattc_write(conn_handle,
                                           &p_req->params.gattc_write);
+            len      = p_req->params.gattc_write.len;
             break;
 
         case NRF_BLE_GQ_REQ_SRV_DISCOVERY:
             NRF_LOG_DEBUG("GATTC Primary Services Discovery Request");
             err_code = sd_ble_gattc_primary_services_discover(conn_handle,
                                                               p_req->params.gattc_srv_disc.start_handle,
-                                                              &p_req->params.gattc_srv_disc.srvc_uuid);
+                                                              srv_disc_uuid_get(&p_req->params.gattc_srv_disc));
             break;
 
         case NRF_BLE_GQ_REQ_CHAR_DISCOVERY:
@@ -375,7 +559,7 @@ static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_
 
         case NRF_BLE_GQ_REQ_GATTS_HVX:
         {
-            uint16_t len = *p_req->params.gatts_hvx.p_len;
+            len = *p_req->params.gatts_hvx.p_len;
 
             NRF_LOG_DEBUG("GATTS Notification or Indication");
 
@@ -395,17 +579,18 @@ static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_
             break;
     }
 
-    if (err_code == NRF_ERROR_BUSY) // Softdevice is processing another GATT request.
+    if (is_retry_needed(p_req, p_link, err_code))
     {
-        NRF_LOG_DEBUG("SD is currently busy. The GATT request procedure will be attempted \
-                      again later.");
         return false;
     }
-    else
+
+    if (err_code == NRF_SUCCESS)
     {
-        request_err_code_handle(p_req, conn_handle, err_code);
-        return true;
+        tx_stats_update(p_req, p_link, len);
     }
+
+    request_err_code_handle(p_req, conn_handle, err_code);
+    return true;
 }
 
 
@@ -446,6 +631,10 @@ static ret_code_t conn_handle_register(nrf_ble_gq_t const * const p_gatt_queue,
         if (p_gatt_queue->p_conn_handles[id] == BLE_CONN_HANDLE_INVALID)
         {
             p_gatt_queue->p_conn_handles[id] = conn_handle;
+
+            // Start collecting statistics for the new link.
+            memset(&p_gatt_queue->p_link_stats[id], 0, sizeof(nrf_ble_gq_stats_t));
+            nrf_queue_max_utilization_reset(&p_gatt_queue->p_req_queue[id]);
             return NRF_SUCCESS;
         }
     }
@@ -498,7 +687,7 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
     // Try processing a request without buffering.
     if (nrf_queue_is_empty(&p_gatt_queue->p_req_queue[conn_id]))
     {
-        bool req_processed = request_process(p_req, conn_handle);
+        bool req_processed = request_process(p_req, &p_gatt_queue->p_link_stats[conn_id], conn_handle);
         if (req_processed)
         {
             return err_code;
@@ -522,11 +711,36 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
     }
 
     // Check if Softdevice is still busy.
-    queue_process(&p_gatt_queue->p_req_queue[conn_id], conn_handle);
+    queue_process(&p_gatt_queue->p_req_queue[conn_id],
+                  &p_gatt_queue->p_link_stats[conn_id],
+                  conn_handle);
     return err_code;
 }
 
 
+ret_code_t nrf_ble_gq_stats_get(nrf_ble_gq_t const * const p_gatt_queue,
+                                uint16_t                   conn_handle,
+                                nrf_ble_gq_stats_t * const p_stats)
+{
+    uint16_t conn_id;
+
+    VERIFY_PARAM_NOT_NULL(p_gatt_queue);
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    conn_id = conn_handle_id_find(p_gatt_queue, conn_handle);
+    if (conn_id == p_gatt_queue->max_conns)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    *p_stats                 = p_gatt_queue->p_link_stats[conn_id];
+    p_stats->queue_depth     = nrf_queue_utilization_get(&p_gatt_queue->p_req_queue[conn_id]);
+    p_stats->queue_depth_max = nrf_queue_max_utilization_get(&p_gatt_queue->p_req_queue[conn_id]);
+
+    return NRF_SUCCESS;
+}
+
+
 ret_code_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * const p_gatt_queue, uint16_t conn_handle)
 {
     ret_code_t err_code = NRF_SUCCESS;
@@ -598,12 +812,27 @@ void nrf_ble_gq_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
     // Perform operations on the queue.
     if (p_ble_evt->header.evt_id == BLE_GAP_EVT_DISCONNECTED)
     {
-        p_gatt_queue->p_conn_handles[conn_id] = BLE_CONN_HANDLE_INVALID;
+        p_gatt_queue->p_conn_handles[conn_id]         = BLE_CONN_HANDLE_INVALID;
+        p_gatt_queue->p_link_stats[conn_id].in_flight = 0;
         UNUSED_RETURN_VALUE(nrf_queue_push(p_gatt_queue->p_purge_queue, &conn_id));
     }
     else
     {
-        queue_process(&p_gatt_queue->p_req_queue[conn_id], conn_handle);
+        // Packets transmitted from the SoftDevice TX queue leave room for the next requests.
+        if (p_ble_evt->header.evt_id == BLE_GATTS_EVT_HVN_TX_COMPLETE)
+        {
+            tx_complete_handle(&p_gatt_queue->p_link_stats[conn_id],
+                               p_ble_evt->evt.gatts_evt.params.hvn_tx_complete.count);
+        }
+        else if (p_ble_evt->header.evt_id == BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE)
+        {
+            tx_complete_handle(&p_gatt_queue->p_link_stats[conn_id],
+                               p_ble_evt->evt.gattc_evt.params.write_cmd_tx_complete.count);
+        }
+
+        queue_process(&p_gatt_queue->p_req_queue[conn_id],
+                      &p_gatt_queue->p_link_stats[conn_id],
+                      conn_handle);
     }
 }
 
@@ -50,6 +50,12 @@
  *          free, the request is retried. For conceptual documentation of this module, see
  *          @ref lib_ble_gatt_queue.
  *
+ *          Notifications and write commands are transmitted from the SoftDevice TX queue without
+ *          waiting for the peer. If @ref NRF_BLE_GQ_TX_WINDOW_SIZE is set, several of them are
+ *          submitted at once until the SoftDevice TX queue or the in-flight window of the link
+ *          is full. The remaining ones are submitted when the SoftDevice reports that packets
+ *          have been transmitted.
+ *
  */
 #ifndef NRF_BLE_GQ_H__
 #define NRF_BLE_GQ_H__
@@ -64,6 +70,16 @@
 extern "C" {
 #endif
 
+/**@brief Maximal number of notifications and write commands submitted by a single link and not
+ *        yet transmitted.
+ *
+ * @details If 0, one request is submitted at a time and a request rejected because the SoftDevice
+ *          TX queue is full is dropped and reported to the error handler.
+ */
+#ifndef NRF_BLE_GQ_TX_WINDOW_SIZE
+#define NRF_BLE_GQ_TX_WINDOW_SIZE 0
+#endif
+
 /**@brief   Macro for defining a nrf_ble_gq_t instance with default parameters.
  *
  * @param   _name            Name of the instance.
@@ -100,13 +116,15 @@ extern "C" {
     NRF_QUEUE_DEF(uint16_t, CONCAT_2(_name, purge_queue), _max_connections,                            \
                   NRF_QUEUE_MODE_NO_OVERFLOW);                                                         \
     NRF_MEMOBJ_POOL_DEF(CONCAT_2(_name, pool), _pool_elem_size, _pool_elem_count);                     \
+    static nrf_ble_gq_stats_t CONCAT_2(_name, link_stats)[_max_connections];                          \
     static nrf_ble_gq_t _name =                                                                        \
     {                                                                                                  \
         .max_conns      = (_max_connections),                                                          \
         .p_conn_handles = CONCAT_2(_name, conn_handles_arr),                                           \
         .p_req_queue    = CONCAT_2(_name, req_queue),                                                  \
         .p_purge_queue  = &CONCAT_2(_name, purge_queue),                                               \
-        .p_data_pool    = &CONCAT_2(_name, pool)                                                       \
+        .p_data_pool    = &CONCAT_2(_name, pool),                                                      \
+        .p_link_stats   = CONCAT_2(_name, link_stats)                                                  \
     };                                                                                                 \
     NRF_SDH_BLE_OBSERVER(_name ## _obs,                                                                \
                          NRF_BLE_GQ_BLE_OBSERVER_PRIO,                                                 \
@@ -152,7 +170,7 @@ typedef ble_gattc_write_params_t nrf_ble_gq_gattc_write_t;
 typedef struct
 {
     uint16_t   start_handle;    /**< The start handle value used during service discovery. */
-    ble_uuid_t srvc_uuid;       /**< The service UUID to be found. */
+    ble_uuid_t srvc_uuid;       /**< The service UUID to be found. All primary services are discovered if the type is @ref BLE_UUID_TYPE_UNKNOWN. */
 } nrf_ble_gq_gattc_srv_discovery_t;
 
 /**@brief Structure used to describe @ref NRF_BLE_GQ_REQ_CHAR_DISCOVERY request type. */
@@ -189,6 +207,23 @@ typedef struct
     } params;
 } nrf_ble_gq_req_t;
 
+/**@brief Statistics of a single link.
+ *
+ * @details Throughput can be calculated by sampling @ref nrf_ble_gq_stats_t::tx_bytes periodically.
+ *          Statistics are reset when the connection handle is registered.
+ */
+typedef struct
+{
+    uint32_t tx_bytes;        /**< Number of payload bytes in notifications and write commands accepted by the SoftDevice. */
+    uint32_t tx_packets;      /**< Number of notifications and write commands accepted by the SoftDevice. */
+    uint32_t tx_complete;     /**< Number of accepted packets reported as transmitted by the SoftDevice. */
+    uint32_t tx_queue_full;   /**< Number of times a request was rejected because the SoftDevice TX queue was full. */
+    uint16_t in_flight;       /**< Number of accepted packets which have not been transmitted yet. */
+    uint16_t in_flight_max;   /**< Maximal value of @ref nrf_ble_gq_stats_t::in_flight. */
+    uint16_t queue_depth;     /**< Number of requests waiting in the queue. Filled by @ref nrf_ble_gq_stats_get. */
+    uint16_t queue_depth_max; /**< Maximal number of requests waiting in the queue. Filled by @ref nrf_ble_gq_stats_get. */
+} nrf_ble_gq_stats_t;
+
 /**@brief Descriptor for the BLE GATT Queue instance. */
 typedef struct
 {
@@ -197,6 +232,7 @@ typedef struct
     nrf_queue_t const * const p_req_queue;    /**< Pointer to array of queue instances used to hold nrf_ble_gq_req_t instances.*/
     nrf_queue_t const * const p_purge_queue;  /**< Pointer to the queue instance used to hold indexes of queues to purge.*/
     nrf_memobj_pool_t const * p_data_pool;    /**< Memory pool used to obtain nrf_memobj_t instances.*/
+    nrf_ble_gq_stats_t      * p_link_stats;   /**< Pointer to array with statistics of registered links.*/
 } nrf_ble_gq_t;
 
 
@@ -239,6 +275,21 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
 ret_code_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * const p_gatt_queue, uint16_t conn_handle);
 
 
+/**@brief Function for getting statistics of a link.
+ *
+ * @param[in]  p_gatt_queue  Pointer to the BGQ instance.
+ * @param[in]  conn_handle   Connection handle.
+ * @param[out] p_stats       Statistics of the link.
+ *
+ * @retval    NRF_SUCCESS             If the statistics were retrieved successfully.
+ * @retval    NRF_ERROR_NULL          Any parameter was NULL.
+ * @retval    NRF_ERROR_INVALID_PARAM If \p conn_handle is not registered.
+ */
+ret_code_t nrf_ble_gq_stats_get(nrf_ble_gq_t const * const p_gatt_queue,
+                                uint16_t                   conn_handle,
+                                nrf_ble_gq_stats_t * const p_stats);
+
+
 /**@brief     Function for handling BLE events from the SoftDevice.
  *
  * @details   This function handles the BLE events received from the SoftDevice. If a BLE
@@ -160,6 +160,148 @@ static uint16_t nrf_ble_scan_address_type_decode(uint8_t const * p_addr)
 
 
 #if (NRF_BLE_SCAN_FILTER_ENABLE == 1)
+
+#if (NRF_BLE_SCAN_NAME_CNT > 0) || (NRF_BLE_SCAN_SHORT_NAME_CNT > 0) || \
+    (NRF_BLE_SCAN_UUID_CNT > 0) || (NRF_BLE_SCAN_APPEARANCE_CNT > 0)
+#define ADV_FIELDS_USED 1 /**< Advertising data is parsed by at least one filter type. */
+#else
+#define ADV_FIELDS_USED 0
+#endif
+
+#if (NRF_BLE_SCAN_UUID_CNT > 0)
+// UUID filters matched by a report are tracked in a 32-bit mask.
+STATIC_ASSERT(NRF_BLE_SCAN_UUID_CNT <= 32, "NRF_BLE_SCAN_UUID_CNT must not exceed 32.");
+#endif
+
+#if ADV_FIELDS_USED
+/**@brief AD structures used by the filters. */
+typedef enum
+{
+    ADV_FIELD_NAME,                 /**< Complete local name. */
+    ADV_FIELD_SHORT_NAME,           /**< Shortened local name. */
+    ADV_FIELD_APPEARANCE,           /**< Appearance. */
+    ADV_FIELD_UUID16_COMPLETE,      /**< Complete list of 16-bit UUIDs. */
+    ADV_FIELD_UUID16_MORE,          /**< Incomplete list of 16-bit UUIDs. */
+    ADV_FIELD_UUID32_COMPLETE,      /**< Complete list of 32-bit UUIDs. */
+    ADV_FIELD_UUID32_MORE,          /**< Incomplete list of 32-bit UUIDs. */
+    ADV_FIELD_UUID128_COMPLETE,     /**< Complete list of 128-bit UUIDs. */
+    ADV_FIELD_UUID128_MORE,         /**< Incomplete list of 128-bit UUIDs. */
+    ADV_FIELD_CNT
+} adv_field_t;
+
+/**@brief AD structures found in an advertising report.
+ *
+ * @details Only the first AD structure of each type is used, the same as in @ref ble_advdata_search.
+ *          Malformed structures are stored with NULL data pointer.
+ */
+typedef struct
+{
+    uint8_t const * p_data[ADV_FIELD_CNT]; /**< Data of the AD structure or NULL if not found. */
+    uint8_t         len[ADV_FIELD_CNT];    /**< Length of the data. */
+} adv_fields_t;
+
+
+/**@brief Function for mapping an AD type to the field used by the filters.
+ *
+ * @param[in] ad_type AD type.
+ *
+ * @return Field or @ref ADV_FIELD_CNT if the AD type is not used by the filters.
+ */
+static adv_field_t adv_field_get(uint8_t ad_type)
+{
+    switch (ad_type)
+    {
+        case BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME:
+            return ADV_FIELD_NAME;
+        case BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME:
+            return ADV_FIELD_SHORT_NAME;
+        case BLE_GAP_AD_TYPE_APPEARANCE:
+            return ADV_FIELD_APPEARANCE;
+        case BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE:
+            return ADV_FIELD_UUID16_COMPLETE;
+        case BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE:
+            return ADV_FIELD_UUID16_MORE;
+        case BLE_GAP_AD_TYPE_32BIT_SERVICE_UUID_COMPLETE:
+            return ADV_FIELD_UUID32_COMPLETE;
+        case BLE_GAP_AD_TYPE_32BIT_SERVICE_UUID_MORE_AVAILABLE:
+            return ADV_FIELD_UUID32_MORE;
+        case BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE:
+            return ADV_FIELD_UUID128_COMPLETE;
+        case BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_MORE_AVAILABLE:
+            return ADV_FIELD_UUID128_MORE;
+        default:
+            return ADV_FIELD_CNT;
+    }
+}
+
+
+/**@brief Function for finding all AD structures used by the filters in a single pass.
+ *
+ * @param[in]  p_adv_report Advertising data to parse.
+ * @param[out] p_fields     AD structures found in the data.
+ */
+static void adv_fields_parse(ble_gap_evt_adv_report_t const * const p_adv_report,
+                             adv_fields_t                   * const p_fields)
+{
+    uint8_t const * p_data   = p_adv_report->data.p_data;
+    uint16_t        data_len = p_adv_report->data.len;
+    uint16_t        found    = 0;
+
+    memset(p_fields, 0, sizeof(adv_fields_t));
+
+    if (p_data == NULL)
+    {
+        return;
+    }
+
+    for (uint16_t i = 0; (i + 1) < data_len; i += (p_data[i] + 1))
+    {
+        adv_field_t field = adv_field_get(p_data[i + 1]);
+
+        if ((field == ADV_FIELD_CNT) || (found & (1U << field)))
+        {
+            continue;
+        }
+
+        found |= (1U << field);
+
+        uint16_t offset = i + 2;
+        uint16_t len    = p_data[i] ? (p_data[i] - 1) : 0;
+
+        // Skip the malformed structure, but do not look for another one of the same type.
+        if ((len != 0) && ((offset + len) <= data_len))
+        {
+            p_fields->p_data[field] = &p_data[offset];
+            p_fields->len[field]    = (uint8_t)len;
+        }
+    }
+}
+#endif // ADV_FIELDS_USED
+
+
+#if (NRF_BLE_SCAN_NAME_CNT > 0)
+/**@brief Function for calculating the hash of a name (32-bit FNV-1a).
+ *
+ * @param[in] p_name Name.
+ * @param[in] len    Length of the name.
+ *
+ * @return Hash of the name.
+ */
+static uint32_t name_hash_calc(uint8_t const * p_name, uint16_t len)
+{
+    uint32_t hash = 2166136261UL;
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        hash ^= p_name[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+#endif // NRF_BLE_SCAN_NAME_CNT
+
+
 #if (NRF_BLE_SCAN_ADDRESS_CNT > 0)
 
 /**@brief Function for searching for the provided address in the advertisement packets.
@@ -293,28 +435,35 @@ static ret_code_t nrf_ble_scan_addr_filter_add(nrf_ble_scan_t * const p_scan_ctx
 #if (NRF_BLE_SCAN_NAME_CNT > 0)
 /** @brief Function for comparing the provided name with the advertised name.
  *
- * @param[in] p_adv_report    Advertising data to parse.
+ * @param[in] p_fields        AD structures found in the advertising data.
  * @param[in] p_scan_ctx      Pointer to the Scanning Module instance.
  *
  * @retval True when the names match. False otherwise.
  */
-static bool adv_name_compare(ble_gap_evt_adv_report_t const * p_adv_report,
-                             nrf_ble_scan_t     const * const p_scan_ctx)
+static bool adv_name_compare(adv_fields_t   const * const p_fields,
+                             nrf_ble_scan_t const * const p_scan_ctx)
 {
     nrf_ble_scan_name_filter_t const * p_name_filter = &p_scan_ctx->scan_filters.name_filter;
     uint8_t                            counter       =
         p_scan_ctx->scan_filters.name_filter.name_cnt;
-    uint8_t  index;
-    uint16_t data_len;
+    uint8_t const *                    p_name        = p_fields->p_data[ADV_FIELD_NAME];
+    uint8_t                            name_len      = p_fields->len[ADV_FIELD_NAME];
+    uint32_t                           hash;
+    uint8_t                            index;
+
+    if (p_name == NULL)
+    {
+        return false;
+    }
 
-    data_len = p_adv_report->data.len;
+    hash = name_hash_calc(p_name, name_len);
 
-    // Compare the name found with the name filter.
+    // Compare the name found with the name filter. Names are compared only if hashes match.
     for (index = 0; index < counter; index++)
     {
-        if (ble_advdata_name_find(p_adv_report->data.p_data,
-                                  data_len,
-                                  p_name_filter->target_name[index]))
+        if ((p_name_filter->name_hash[index] == hash)          &&
+            (p_name_filter->name_len[index]  == name_len)      &&
+            (memcmp(p_name_filter->target_name[index], p_name, name_len) == 0))
         {
             return true;
         }
@@ -363,6 +512,9 @@ static ret_code_t nrf_ble_scan_name_filter_add(nrf_ble_scan_t * const p_scan_ctx
     }
 
     // Add name to filter.
+    p_scan_ctx->scan_filters.name_filter.name_len[*counter]  = name_len;
+    p_scan_ctx->scan_filters.name_filter.name_hash[*counter] =
+        name_hash_calc((uint8_t const *)p_name, name_len);
     memcpy(p_scan_ctx->scan_filters.name_filter.target_name[(*counter)++],
            p_name,
            strlen(p_name));
@@ -379,29 +531,35 @@ static ret_code_t nrf_ble_scan_name_filter_add(nrf_ble_scan_t * const p_scan_ctx
 #if (NRF_BLE_SCAN_SHORT_NAME_CNT > 0)
 /** @brief Function for comparing the provided short name with the advertised short name.
  *
- * @param[in] p_adv_report    Advertising data to parse.
+ * @details The advertised short name matches if it is a prefix of the filter name and it is not
+ *          shorter than the minimum length, the same as in @ref ble_advdata_short_name_find.
+ *
+ * @param[in] p_fields        AD structures found in the advertising data.
  * @param[in] p_scan_ctx      Pointer to the Scanning Module instance.
  *
  * @retval True when the names match. False otherwise.
  */
-static bool adv_short_name_compare(ble_gap_evt_adv_report_t const * const p_adv_report,
-                                   nrf_ble_scan_t           const * const p_scan_ctx)
+static bool adv_short_name_compare(adv_fields_t   const * const p_fields,
+                                   nrf_ble_scan_t const * const p_scan_ctx)
 {
     nrf_ble_scan_short_name_filter_t const * p_name_filter =
         &p_scan_ctx->scan_filters.short_name_filter;
-    uint8_t  counter = p_scan_ctx->scan_filters.short_name_filter.name_cnt;
-    uint8_t  index;
-    uint16_t data_len;
+    uint8_t         counter  = p_scan_ctx->scan_filters.short_name_filter.name_cnt;
+    uint8_t const * p_name   = p_fields->p_data[ADV_FIELD_SHORT_NAME];
+    uint8_t         name_len = p_fields->len[ADV_FIELD_SHORT_NAME];
+    uint8_t         index;
 
-    data_len = p_adv_report->data.len;
+    if (p_name == NULL)
+    {
+        return false;
+    }
 
     // Compare the name found with the name filters.
     for (index = 0; index < counter; index++)
     {
-        if (ble_advdata_short_name_find(p_adv_report->data.p_data,
-                                        data_len,
-                                        p_name_filter->short_name[index].short_target_name,
-                                        p_name_filter->short_name[index].short_name_min_len))
+        if ((name_len >= p_name_filter->short_name[index].short_name_min_len) &&
+            (name_len <  p_name_filter->short_name[index].short_name_len)     &&
+            (memcmp(p_name_filter->short_name[index].short_target_name, p_name, name_len) == 0))
         {
             return true;
         }
@@ -456,6 +614,7 @@ static ret_code_t nrf_ble_scan_short_name_filter_add(nrf_ble_scan_t            *
     // Add name to the filter.
     p_short_name_filter->short_name[(*p_counter)].short_name_min_len =
         p_short_name->short_name_min_len;
+    p_short_name_filter->short_name[(*p_counter)].short_name_len = name_len;
     memcpy(p_short_name_filter->short_name[(*p_counter)++].short_target_name,
            p_short_name->p_short_name,
            strlen(p_short_name->p_short_name));
@@ -470,54 +629,188 @@ static ret_code_t nrf_ble_scan_short_name_filter_add(nrf_ble_scan_t            *
 
 
 #if (NRF_BLE_SCAN_UUID_CNT > 0)
+/**@brief Function for calculating the hash of an encoded UUID.
+ *
+ * @details The hash is the bit number in @ref nrf_ble_scan_uuid_filter_t::raw_uuid_hash_set.
+ *          It is based on the 16-bit part of the UUID, which differs between the UUIDs
+ *          sharing a vendor-specific base.
+ *
+ * @param[in] p_raw_uuid Encoded UUID.
+ * @param[in] len        Length of the encoded UUID.
+ *
+ * @return Hash of the UUID.
+ */
+static uint8_t raw_uuid_hash_calc(uint8_t const * p_raw_uuid, uint8_t len)
+{
+    // 16-bit part of the 128-bit UUID is stored at offset 12.
+    uint8_t const * p_uuid16 = (len == sizeof(ble_uuid128_t)) ? &p_raw_uuid[12] : p_raw_uuid;
+
+    return (p_uuid16[0] ^ p_uuid16[1]) & 0x1F;
+}
+
+
+/**@brief Function for encoding the UUID filter in the format used in the advertising data.
+ *
+ * @param[in,out] p_uuid_filter Pointer to the UUID filter data.
+ * @param[in]     index         Index of the UUID filter.
+ */
+static void raw_uuid_encode(nrf_ble_scan_uuid_filter_t * const p_uuid_filter, uint8_t index)
+{
+    uint8_t raw_uuid_len = sizeof(ble_uuid128_t);
+
+    if (sd_ble_uuid_encode(&p_uuid_filter->uuid[index],
+                           &raw_uuid_len,
+                           p_uuid_filter->raw_uuid[index]) != NRF_SUCCESS)
+    {
+        // Vendor-specific base may not be registered yet. Try again when the report is matched.
+        raw_uuid_len = 0;
+    }
+
+    p_uuid_filter->raw_uuid_len[index] = raw_uuid_len;
+
+    if (raw_uuid_len != 0)
+    {
+        p_uuid_filter->raw_uuid_hash_set |=
+            (1UL << raw_uuid_hash_calc(p_uuid_filter->raw_uuid[index], raw_uuid_len));
+    }
+}
+
+
+/**@brief Function for getting the list of UUIDs of the given size from the advertising data.
+ *
+ * @details The incomplete list is used only if there is no valid complete list, the same as in
+ *          @ref ble_advdata_uuid_find.
+ *
+ * @param[in]  p_fields     AD structures found in the advertising data.
+ * @param[in]  raw_uuid_len Length of the encoded UUIDs.
+ * @param[out] p_len        Length of the list.
+ *
+ * @return Pointer to the list or NULL if not found.
+ */
+static uint8_t const * adv_uuid_list_get(adv_fields_t const * const p_fields,
+                                         uint8_t                    raw_uuid_len,
+                                         uint8_t                  * p_len)
+{
+    adv_field_t field;
+
+    switch (raw_uuid_len)
+    {
+        case sizeof(uint16_t):
+            field = ADV_FIELD_UUID16_COMPLETE;
+            break;
+
+        case sizeof(uint32_t):
+            field = ADV_FIELD_UUID32_COMPLETE;
+            break;
+
+        case sizeof(ble_uuid128_t):
+            field = ADV_FIELD_UUID128_COMPLETE;
+            break;
+
+        default:
+            return NULL;
+    }
+
+    // Incomplete list always follows the complete one in adv_field_t.
+    if (p_fields->p_data[field] == NULL)
+    {
+        field++;
+    }
+
+    *p_len = p_fields->len[field];
+    return p_fields->p_data[field];
+}
+
+
 /**@brief Function for comparing the provided UUID with the UUID in the advertisement packets.
  *
- * @param[in]   p_adv_report   Advertising data to parse.
+ * @details Every UUID in the advertised lists is checked only once against all filters. The hash
+ *          set is used to skip UUIDs that do not match any filter.
+ *
+ * @param[in]   p_fields       AD structures found in the advertising data.
  * @param[in]   p_scan_ctx     Pointer to the Scanning Module instance.
  *
  * @return      True if the UUIDs match. False otherwise.
  */
-static bool adv_uuid_compare(ble_gap_evt_adv_report_t const * const p_adv_report,
-                             nrf_ble_scan_t           const * const p_scan_ctx)
+static bool adv_uuid_compare(adv_fields_t   const * const p_fields,
+                             nrf_ble_scan_t const * const p_scan_ctx)
 {
+    static const uint8_t raw_uuid_sizes[] = {sizeof(uint16_t),
+                                             sizeof(uint32_t),
+                                             sizeof(ble_uuid128_t)};
+
     nrf_ble_scan_uuid_filter_t const * p_uuid_filter    = &p_scan_ctx->scan_filters.uuid_filter;
     bool const                         all_filters_mode = p_scan_ctx->scan_filters.all_filters_mode;
     uint8_t const                      counter          =
         p_scan_ctx->scan_filters.uuid_filter.uuid_cnt;
-    uint8_t  index;
-    uint16_t data_len;
-    uint8_t  uuid_match_cnt = 0;
+    uint32_t const                     all_mask         =
+        (counter == 32) ? UINT32_MAX : ((1UL << counter) - 1);
+    uint32_t                           match_mask       = 0;
+    uint8_t                            index;
 
-    data_len = p_adv_report->data.len;
-
-    for (index = 0; index < counter; index++)
+    for (uint8_t i = 0; i < ARRAY_SIZE(raw_uuid_sizes); i++)
     {
+        uint8_t const   size = raw_uuid_sizes[i];
+        uint8_t         len;
+        uint8_t const * p_list = adv_uuid_list_get(p_fields, size, &len);
+
+        if (p_list == NULL)
+        {
+            continue;
+        }
 
-        if (ble_advdata_uuid_find(p_adv_report->data.p_data,
-                                  data_len,
-                                  &p_uuid_filter->uuid[index]))
+        for (uint16_t list_offset = 0; (list_offset + size) <= len; list_offset += size)
         {
-            uuid_match_cnt++;
+            uint8_t const * p_uuid = &p_list[list_offset];
 
-            // In the normal filter mode, only one UUID is needed to match.
-            if (!all_filters_mode)
+            if (!(p_uuid_filter->raw_uuid_hash_set & (1UL << raw_uuid_hash_calc(p_uuid, size))))
             {
-                break;
+                continue;
+            }
+
+            for (index = 0; index < counter; index++)
+            {
+                if ((p_uuid_filter->raw_uuid_len[index] == size) &&
+                    (memcmp(p_uuid_filter->raw_uuid[index], p_uuid, size) == 0))
+                {
+                    match_mask |= (1UL << index);
+                }
             }
         }
-        else if (all_filters_mode)
+    }
+
+    // UUIDs that could not be encoded when the filter was added are encoded now.
+    for (index = 0; index < counter; index++)
+    {
+        uint8_t         raw_uuid[sizeof(ble_uuid128_t)];
+        uint8_t         raw_uuid_len = sizeof(raw_uuid);
+        uint8_t         len;
+        uint8_t const * p_list;
+
+        if ((p_uuid_filter->raw_uuid_len[index] != 0) ||
+            (sd_ble_uuid_encode(&p_uuid_filter->uuid[index], &raw_uuid_len, raw_uuid) != NRF_SUCCESS))
         {
-            break;
+            continue;
         }
-        else
+
+        p_list = adv_uuid_list_get(p_fields, raw_uuid_len, &len);
+
+        for (uint16_t list_offset = 0;
+             (p_list != NULL) && ((list_offset + raw_uuid_len) <= len);
+             list_offset += raw_uuid_len)
         {
-            // Do nothing.
+            if (memcmp(raw_uuid, &p_list[list_offset], raw_uuid_len) == 0)
+            {
+                match_mask |= (1UL << index);
+                break;
+            }
         }
     }
 
     // In the multifilter mode, all UUIDs must be found in the advertisement packets.
-    if ((all_filters_mode && (uuid_match_cnt == counter)) ||
-        ((!all_filters_mode) && (uuid_match_cnt > 0)))
+    // In the normal filter mode, only one UUID is needed to match.
+    if ((all_filters_mode && (match_mask == all_mask)) ||
+        ((!all_filters_mode) && (match_mask != 0)))
     {
         return true;
     }
@@ -557,7 +850,9 @@ static ret_code_t nrf_ble_scan_uuid_filter_add(nrf_ble_scan_t * const p_scan_ctx
     }
 
     // Add UUID to the filter.
-    p_uuid_filter[(*p_counter)++] = *p_uuid;
+    p_uuid_filter[*p_counter] = *p_uuid;
+    raw_uuid_encode(&p_scan_ctx->scan_filters.uuid_filter, *p_counter);
+    (*p_counter)++;
     NRF_LOG_DEBUG("Added filter on UUID %x", p_uuid->uuid);
 
     return NRF_SUCCESS;
@@ -570,29 +865,33 @@ static ret_code_t nrf_ble_scan_uuid_filter_add(nrf_ble_scan_t * const p_scan_ctx
 #if (NRF_BLE_SCAN_APPEARANCE_CNT)
 /**@brief Function for comparing the provided appearance with the appearance in the advertisement packets.
  *
- * @param[in]     p_adv_report Advertising data to parse.
+ * @param[in]     p_fields     AD structures found in the advertising data.
  * @param[in,out] p_scan_ctx   Pointer to the Scanning Module instance.
  *
  * @return      True if the appearances match. False otherwise.
  */
-static bool adv_appearance_compare(ble_gap_evt_adv_report_t const * const p_adv_report,
-                                   nrf_ble_scan_t           const * const p_scan_ctx)
+static bool adv_appearance_compare(adv_fields_t   const * const p_fields,
+                                   nrf_ble_scan_t const * const p_scan_ctx)
 {
     nrf_ble_scan_appearance_filter_t const * p_appearance_filter =
         &p_scan_ctx->scan_filters.appearance_filter;
     uint8_t const counter =
         p_scan_ctx->scan_filters.appearance_filter.appearance_cnt;
     uint8_t  index;
-    uint16_t data_len;
+    uint16_t appearance;
+
+    // Appearance is decoded in the same way as in ble_advdata_appearance_find.
+    if (p_fields->p_data[ADV_FIELD_APPEARANCE] == NULL)
+    {
+        return false;
+    }
 
-    data_len = p_adv_report->data.len;
+    appearance = uint16_decode(p_fields->p_data[ADV_FIELD_APPEARANCE]);
 
     // Verify if the advertised appearance matches the provided appearance.
     for (index = 0; index < counter; index++)
     {
-        if (ble_advdata_appearance_find(p_adv_report->data.p_data,
-                                        data_len,
-                                        &p_appearance_filter->appearance[index]))
+        if (p_appearance_filter->appearance[index] == appearance)
         {
             return true;
         }
@@ -702,6 +1001,8 @@ ret_code_t nrf_ble_scan_all_filter_remove(nrf_ble_scan_t * const p_scan_ctx)
 #if (NRF_BLE_SCAN_NAME_CNT > 0)
     nrf_ble_scan_name_filter_t * p_name_filter = &p_scan_ctx->scan_filters.name_filter;
     memset(p_name_filter->target_name, 0, sizeof(p_name_filter->target_name));
+    memset(p_name_filter->name_len, 0, sizeof(p_name_filter->name_len));
+    memset(p_name_filter->name_hash, 0, sizeof(p_name_filter->name_hash));
     p_name_filter->name_cnt = 0;
 #endif
 
@@ -721,6 +1022,9 @@ ret_code_t nrf_ble_scan_all_filter_remove(nrf_ble_scan_t * const p_scan_ctx)
 #if (NRF_BLE_SCAN_UUID_CNT > 0)
     nrf_ble_scan_uuid_filter_t * p_uuid_filter = &p_scan_ctx->scan_filters.uuid_filter;
     memset(p_uuid_filter->uuid, 0, sizeof(p_uuid_filter->uuid));
+    memset(p_uuid_filter->raw_uuid, 0, sizeof(p_uuid_filter->raw_uuid));
+    memset(p_uuid_filter->raw_uuid_len, 0, sizeof(p_uuid_filter->raw_uuid_len));
+    p_uuid_filter->raw_uuid_hash_set = 0;
     p_uuid_filter->uuid_cnt = 0;
 #endif
 
@@ -883,6 +1187,12 @@ static void nrf_ble_scan_on_adv_report(nrf_ble_scan_t           const * const p_
     bool const all_filter_mode   = p_scan_ctx->scan_filters.all_filters_mode;
     bool       is_filter_matched = false;
 
+#if ADV_FIELDS_USED
+    // Advertising data is parsed once and all filters are matched against the result.
+    adv_fields_t adv_fields;
+    adv_fields_parse(p_adv_report, &adv_fields);
+#endif
+
 #if (NRF_BLE_SCAN_ADDRESS_CNT > 0)
     bool const addr_filter_enabled = p_scan_ctx->scan_filters.addr_filter.addr_filter_enabled;
 #endif
@@ -928,7 +1238,7 @@ static void nrf_ble_scan_on_adv_report(nrf_ble_scan_t           const * const p_
     if (name_filter_enabled)
     {
         filter_cnt++;
-        if (adv_name_compare(p_adv_report, p_scan_ctx))
+        if (adv_name_compare(&adv_fields, p_scan_ctx))
         {
             filter_match_cnt++;
 
@@ -943,7 +1253,7 @@ static void nrf_ble_scan_on_adv_report(nrf_ble_scan_t           const * const p_
     if (short_name_filter_enabled)
     {
         filter_cnt++;
-        if (adv_short_name_compare(p_adv_report, p_scan_ctx))
+        if (adv_short_name_compare(&adv_fields, p_scan_ctx))
         {
             filter_match_cnt++;
 
@@ -959,7 +1269,7 @@ static void nrf_ble_scan_on_adv_report(nrf_ble_scan_t           const * const p_
     if (uuid_filter_enabled)
     {
         filter_cnt++;
-        if (adv_uuid_compare(p_adv_report, p_scan_ctx))
+        if (adv_uuid_compare(&adv_fields, p_scan_ctx))
         {
             filter_match_cnt++;
             // Information about the filters matched.
@@ -974,7 +1284,7 @@ static void nrf_ble_scan_on_adv_report(nrf_ble_scan_t           const * const p_
     if (appearance_filter_enabled)
     {
         filter_cnt++;
-        if (adv_appearance_compare(p_adv_report, p_scan_ctx))
+        if (adv_appearance_compare(&adv_fields, p_scan_ctx))
         {
             filter_match_cnt++;
             // Information about the filters matched.
@@ -211,9 +211,11 @@ typedef void (*nrf_ble_scan_evt_handler_t)(scan_evt_t const * p_scan_evt);
 #if (NRF_BLE_SCAN_NAME_CNT > 0)
 typedef struct
 {
-    char    target_name[NRF_BLE_SCAN_NAME_CNT][NRF_BLE_SCAN_NAME_MAX_LEN]; /**< Names that the main application will scan for, and that will be advertised by the peripherals. */
-    uint8_t name_cnt;                                                      /**< Name filter counter. */
-    bool    name_filter_enabled;                                           /**< Flag to inform about enabling or disabling this filter. */
+    char     target_name[NRF_BLE_SCAN_NAME_CNT][NRF_BLE_SCAN_NAME_MAX_LEN]; /**< Names that the main application will scan for, and that will be advertised by the peripherals. */
+    uint8_t  name_len[NRF_BLE_SCAN_NAME_CNT];                               /**< Lengths of the names. */
+    uint32_t name_hash[NRF_BLE_SCAN_NAME_CNT];                              /**< Hashes of the names, used to find a matching name without comparing all of them. */
+    uint8_t  name_cnt;                                                      /**< Name filter counter. */
+    bool     name_filter_enabled;                                           /**< Flag to inform about enabling or disabling this filter. */
 } nrf_ble_scan_name_filter_t;
 #endif
 
@@ -224,6 +226,7 @@ typedef struct
     {
         char    short_target_name[NRF_BLE_SCAN_SHORT_NAME_MAX_LEN]; /**< Short names that the main application will scan for, and that will be advertised by the peripherals. */
         uint8_t short_name_min_len;                                 /**< Minimum length of the short name. */
+        uint8_t short_name_len;                                     /**< Length of the short name. */
     } short_name[NRF_BLE_SCAN_SHORT_NAME_CNT];
     uint8_t name_cnt;                                               /**< Short name filter counter. */
     bool    short_name_filter_enabled;                              /**< Flag to inform about enabling or disabling this filter. */
@@ -242,9 +245,12 @@ typedef struct
 #if (NRF_BLE_SCAN_UUID_CNT > 0)
 typedef struct
 {
-    ble_uuid_t uuid[NRF_BLE_SCAN_UUID_CNT]; /**< UUIDs that the main application will scan for, and that will be advertised by the peripherals. */
-    uint8_t    uuid_cnt;                    /**< UUID filter counter. */
-    bool       uuid_filter_enabled;         /**< Flag to inform about enabling or disabling this filter. */
+    ble_uuid_t uuid[NRF_BLE_SCAN_UUID_CNT];                                 /**< UUIDs that the main application will scan for, and that will be advertised by the peripherals. */
+    uint8_t    raw_uuid[NRF_BLE_SCAN_UUID_CNT][sizeof(ble_uuid128_t)];      /**< UUIDs encoded in the format used in the advertising data. */
+    uint8_t    raw_uuid_len[NRF_BLE_SCAN_UUID_CNT];                         /**< Lengths of the encoded UUIDs. 0 if the UUID could not be encoded when the filter was added. */
+    uint32_t   raw_uuid_hash_set;                                           /**< Set of hashes of all encoded UUIDs, used to quickly skip UUIDs which do not match any filter. */
+    uint8_t    uuid_cnt;                                                    /**< UUID filter counter. */
+    bool       uuid_filter_enabled;                                         /**< Flag to inform about enabling or disabling this filter. */
 } nrf_ble_scan_uuid_filter_t;
 #endif
 
@@ -59,6 +59,18 @@
 #define TAIL_GUARD_FILL     0xBAADCAFE      /**< Magic number used to mark tail guard.*/
 #define FREE_MEM_FILL       0xBAADBAAD      /**< Magic number used to mark free memory.*/
 
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+#define FREE_HEAD_IDX_MASK  0x0000FFFFUL    /**< Part of the free list head holding index of the first free block + 1.*/
+#define FREE_HEAD_TAG_INC   0x00010000UL    /**< Modification counter increment, protects against ABA problem.*/
+
+/**@brief Prepare new value of the free list head.
+ *
+ * @param[in]   head    Current value of the head.
+ * @param[in]   idx1    Index of the new first free block + 1 (0 if the list is empty).
+ */
+#define FREE_HEAD_NEXT(head, idx1) ((((head) & ~FREE_HEAD_IDX_MASK) + FREE_HEAD_TAG_INC) | (idx1))
+#endif // NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+
 #if NRF_BALLOC_CONFIG_DEBUG_ENABLED
 #define POOL_ID(_p_pool) _p_pool->p_name
 #define POOL_MARKER     "%s"
@@ -227,7 +239,7 @@ __STATIC_INLINE void * nrf_balloc_element_wrap(nrf_balloc_t const * p_pool, void
  *
  * @return      Pointer to the beginning of the block.
  */
-static void * nrf_balloc_idx2block(nrf_balloc_t const * p_pool, uint8_t idx)
+static void * nrf_balloc_idx2block(nrf_balloc_t const * p_pool, nrf_balloc_idx_t idx)
 {
     ASSERT(p_pool != NULL);
     return (uint8_t *)(p_pool->p_memory_begin) + ((size_t)(idx) * p_pool->block_size);
@@ -240,15 +252,186 @@ static void * nrf_balloc_idx2block(nrf_balloc_t const * p_pool, uint8_t idx)
  *
  * @return      Index of the block.
  */
-static uint8_t nrf_balloc_block2idx(nrf_balloc_t const * p_pool, void const * p_block)
+static nrf_balloc_idx_t nrf_balloc_block2idx(nrf_balloc_t const * p_pool, void const * p_block)
 {
     ASSERT(p_pool != NULL);
     return ((size_t)(p_block) - (size_t)(p_pool->p_memory_begin)) / p_pool->block_size;
 }
 
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+/**@brief  Take the first block from the free list.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ * @param[out]  p_idx       Index of the block.
+ *
+ * @retval      true        Block was taken.
+ * @retval      false       Free list is empty.
+ */
+static bool nrf_balloc_list_pop(nrf_balloc_t const * p_pool, nrf_balloc_idx_t * p_idx)
+{
+    uint32_t head = p_pool->p_cb->free_head;
+    uint32_t idx1;
+
+    do
+    {
+        idx1 = head & FREE_HEAD_IDX_MASK;
+        if (idx1 == 0)
+        {
+            return false;
+        }
+        // If the block is taken meanwhile, the link may be stale but then the head has changed
+        // and the exchange fails.
+    } while (!nrf_atomic_u32_cmp_exch(&p_pool->p_cb->free_head,
+                                      &head,
+                                      FREE_HEAD_NEXT(head, p_pool->p_stack_base[idx1 - 1])));
+
+    *p_idx = (nrf_balloc_idx_t)(idx1 - 1);
+    return true;
+}
+
+/**@brief  Put a block at the beginning of the free list.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ * @param[in]   idx         Index of the block.
+ */
+static void nrf_balloc_list_push(nrf_balloc_t const * p_pool, nrf_balloc_idx_t idx)
+{
+    uint32_t head = p_pool->p_cb->free_head;
+
+    do
+    {
+        p_pool->p_stack_base[idx] = (nrf_balloc_idx_t)(head & FREE_HEAD_IDX_MASK);
+    } while (!nrf_atomic_u32_cmp_exch(&p_pool->p_cb->free_head,
+                                      &head,
+                                      FREE_HEAD_NEXT(head, (uint32_t)idx + 1)));
+}
+
+#if NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+/**@brief  Get the magazine of the current interrupt priority level.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ *
+ * @return      Pointer to the magazine or NULL in thread mode.
+ */
+static nrf_balloc_magazine_t * nrf_balloc_magazine_get(nrf_balloc_t const * p_pool)
+{
+    uint32_t priority = current_int_priority_get();
+
+    // Tasks of an RTOS preempt each other in thread mode, so the magazine cannot be used there.
+    if (priority >= NRF_BALLOC_MAGAZINE_COUNT)
+    {
+        return NULL;
+    }
+
+    return &p_pool->p_cb->magazine[priority];
+}
+#endif // NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+
+/**@brief  Allocate a block without disabling interrupts.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ *
+ * @return      Pointer to the beginning of the block or NULL if the pool is empty.
+ */
+static void * nrf_balloc_lock_free_alloc(nrf_balloc_t const * p_pool)
+{
+    nrf_balloc_idx_t idx;
+
+#if NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+    nrf_balloc_magazine_t * p_magazine = nrf_balloc_magazine_get(p_pool);
+
+    if ((p_magazine != NULL) && (p_magazine->count > 0))
+    {
+        idx = p_magazine->idx[--(p_magazine->count)];
+    }
+    else
+#endif // NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+    if (!nrf_balloc_list_pop(p_pool, &idx))
+    {
+        return NULL;
+    }
+
+    // Update utilization statistics.
+    uint32_t utilization     = nrf_atomic_u32_add(&p_pool->p_cb->utilization, 1);
+    uint32_t max_utilization = p_pool->p_cb->max_utilization;
+
+    while ((max_utilization < utilization) &&
+           !nrf_atomic_u32_cmp_exch(&p_pool->p_cb->max_utilization,
+                                    &max_utilization,
+                                    utilization))
+    {
+    }
+
+    return nrf_balloc_idx2block(p_pool, idx);
+}
+
+/**@brief  Free a block without disabling interrupts.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ * @param[in]   p_block     Pointer to the beginning of the block.
+ */
+static void nrf_balloc_lock_free_free(nrf_balloc_t const * p_pool, void * p_block)
+{
+    nrf_balloc_idx_t idx = nrf_balloc_block2idx(p_pool, p_block);
+
+    UNUSED_RETURN_VALUE(nrf_atomic_u32_sub(&p_pool->p_cb->utilization, 1));
+
+#if NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+    nrf_balloc_magazine_t * p_magazine = nrf_balloc_magazine_get(p_pool);
+
+    if ((p_magazine != NULL) && (p_magazine->count < NRF_BALLOC_CONFIG_MAGAZINE_SIZE))
+    {
+        p_magazine->idx[(p_magazine->count)++] = idx;
+        return;
+    }
+#endif // NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+
+    nrf_balloc_list_push(p_pool, idx);
+}
+
+#if NRF_BALLOC_CONFIG_DEBUG_ENABLED
+/**@brief  Check if the block is free. Must be called in critical region.
+ *
+ * @param[in]   p_pool      Pointer to the memory pool.
+ * @param[in]   idx         Index of the block.
+ *
+ * @return      True if the block is on the free list or in one of magazines.
+ */
+static bool nrf_balloc_lock_free_is_free(nrf_balloc_t const * p_pool, nrf_balloc_idx_t idx)
+{
+    uint32_t pool_size = p_pool->p_stack_limit - p_pool->p_stack_base;
+    uint32_t idx1      = p_pool->p_cb->free_head & FREE_HEAD_IDX_MASK;
+
+    // Number of steps is limited in case the list is corrupted.
+    for (; (idx1 != 0) && (pool_size-- > 0); idx1 = p_pool->p_stack_base[idx1 - 1])
+    {
+        if (idx1 - 1 == idx)
+        {
+            return true;
+        }
+    }
+
+#if NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+    for (uint32_t i = 0; i < NRF_BALLOC_MAGAZINE_COUNT; i++)
+    {
+        for (uint32_t j = 0; j < p_pool->p_cb->magazine[i].count; j++)
+        {
+            if (p_pool->p_cb->magazine[i].idx[j] == idx)
+            {
+                return true;
+            }
+        }
+    }
+#endif // NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+
+    return false;
+}
+#endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
+#endif // NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+
 ret_code_t nrf_balloc_init(nrf_balloc_t const * p_pool)
 {
-    uint8_t pool_size;
+    uint32_t pool_size;
 
     VERIFY_PARAM_NOT_NULL(p_pool);
 
@@ -276,11 +459,25 @@ ret_code_t nrf_balloc_init(nrf_balloc_t const * p_pool)
                       p_pool->block_size,
                       pool_size * p_pool->block_size);
 
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+    // Link all blocks, so that they are allocated in the same order as from the stack.
+    for (uint32_t idx = 0; idx < pool_size; idx++)
+    {
+        p_pool->p_stack_base[idx] = (nrf_balloc_idx_t)((idx + 1 < pool_size) ? (idx + 2) : 0);
+    }
+
+    p_pool->p_cb->free_head   = (pool_size > 0) ? 1 : 0;
+    p_pool->p_cb->utilization = 0;
+#if NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+    memset(p_pool->p_cb->magazine, 0, sizeof(p_pool->p_cb->magazine));
+#endif
+#else
     p_pool->p_cb->p_stack_pointer = p_pool->p_stack_base;
     while (pool_size--)
     {
         *(p_pool->p_cb->p_stack_pointer)++ = pool_size;
     }
+#endif // NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
 
     p_pool->p_cb->max_utilization = 0;
 
@@ -293,6 +490,9 @@ void * nrf_balloc_alloc(nrf_balloc_t const * p_pool)
 
     void * p_block = NULL;
 
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+    p_block = nrf_balloc_lock_free_alloc(p_pool);
+#else
     CRITICAL_REGION_ENTER();
 
     if (p_pool->p_cb->p_stack_pointer > p_pool->p_stack_base)
@@ -309,6 +509,7 @@ void * nrf_balloc_alloc(nrf_balloc_t const * p_pool)
     }
 
     CRITICAL_REGION_EXIT();
+#endif // NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
 
 #if NRF_BALLOC_CONFIG_DEBUG_ENABLED
     if (p_block != NULL)
@@ -335,7 +536,7 @@ void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
     // These checks could be done outside critical region as they use only pool configuration data.
     if (NRF_BALLOC_DEBUG_BASIC_CHECKS_GET(p_pool->debug_flags))
     {
-        uint8_t pool_size  = p_pool->p_stack_limit - p_pool->p_stack_base;
+        uint32_t pool_size = p_pool->p_stack_limit - p_pool->p_stack_base;
         void *p_memory_end = (uint8_t *)(p_pool->p_memory_begin) + (pool_size * p_pool->block_size);
 
         // Check if the element belongs to this pool.
@@ -359,14 +560,16 @@ void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
     void * p_block = p_element;
 #endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
 
+#if NRF_BALLOC_CONFIG_DEBUG_ENABLED || !NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
     CRITICAL_REGION_ENTER();
+#endif
 
 #if NRF_BALLOC_CONFIG_DEBUG_ENABLED
     // These checks have to be done in critical region as they use p_pool->p_stack_pointer.
     if (NRF_BALLOC_DEBUG_BASIC_CHECKS_GET(p_pool->debug_flags))
     {
         // Check for allocated/free ballance.
-        if (p_pool->p_cb->p_stack_pointer >= p_pool->p_stack_limit)
+        if (nrf_balloc_utilization_get(p_pool) == 0)
         {
             NRF_LOG_INST_ERROR(p_pool->p_log,
                                "Attempted to free an element (0x%08X) while the pool is full.",
@@ -378,6 +581,14 @@ void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
     if (NRF_BALLOC_DEBUG_DOUBLE_FREE_CHECK_GET(p_pool->debug_flags))
     {
         // Check for double free.
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+        if (nrf_balloc_lock_free_is_free(p_pool, nrf_balloc_block2idx(p_pool, p_block)))
+        {
+            NRF_LOG_INST_ERROR(p_pool->p_log, "Attempted to double-free an element (0x%08X).",
+                               p_element);
+            APP_ERROR_CHECK_BOOL(false);
+        }
+#else
         for (uint8_t * p_idx = p_pool->p_stack_base; p_idx < p_pool->p_cb->p_stack_pointer; p_idx++)
         {
             if (nrf_balloc_idx2block(p_pool, *p_idx) == p_block)
@@ -387,13 +598,20 @@ void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element)
                 APP_ERROR_CHECK_BOOL(false);
             }
         }
+#endif // NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
     }
 #endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
 
     // Free the element.
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+    nrf_balloc_lock_free_free(p_pool, p_block);
+#else
     *(p_pool->p_cb->p_stack_pointer)++ = nrf_balloc_block2idx(p_pool, p_block);
+#endif // NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
 
+#if NRF_BALLOC_CONFIG_DEBUG_ENABLED || !NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
     CRITICAL_REGION_EXIT();
+#endif
 }
 
 #endif // NRF_MODULE_ENABLED(NRF_BALLOC)
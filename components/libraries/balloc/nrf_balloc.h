@@ -42,6 +42,17 @@
   * @{
   * @ingroup app_common
   * @brief This module handles block memory allocator features.
+  *
+  * By default, free blocks are kept on a stack of 8-bit indexes protected by a critical section,
+  * which limits a pool to 255 blocks. If @c NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED is set, blocks are
+  * identified by 16-bit indexes and free blocks are kept on a linked list updated with
+  * compare-and-swap, so interrupts are never disabled by the allocator.
+  *
+  * In this mode, @c NRF_BALLOC_CONFIG_MAGAZINE_SIZE blocks can be cached per interrupt priority
+  * level. Interrupts of the same priority cannot preempt each other, so the cache is accessed
+  * without any synchronization. Thread mode does not use a cache because it can be shared by
+  * preempting tasks of an RTOS. Blocks cached by one priority level are not available to other
+  * levels, so the pool must be large enough to cover them.
   */
 
 
@@ -59,6 +70,19 @@ extern "C" {
 #include "nrf_log_instance.h"
 #include "nrf_section.h"
 
+#ifndef NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+#define NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED 0
+#endif
+
+#ifndef NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+/**@brief Number of blocks cached per interrupt priority level. Thread mode is never cached. */
+#define NRF_BALLOC_CONFIG_MAGAZINE_SIZE 0
+#endif
+
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+#include "nrf_atomic.h"
+#endif
+
 /** @brief Name of the module used for logger messaging.
  */
 #define NRF_BALLOC_LOG_NAME balloc
@@ -100,22 +124,59 @@ extern "C" {
     #define NRF_BALLOC_DEFAULT_DEBUG_FLAGS   0
 #endif // NRF_BALLOC_CONFIG_DEBUG_ENABLED
 
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+/**@brief Type of the block index. */
+typedef uint16_t nrf_balloc_idx_t;
+
+/**@brief Maximum number of blocks in the pool. */
+#define NRF_BALLOC_MAX_POOL_SIZE        UINT16_MAX
+
+#if NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+/**@brief Number of magazines: one for each interrupt priority level. */
+#define NRF_BALLOC_MAGAZINE_COUNT       (1UL << __NVIC_PRIO_BITS)
+
+/**@brief Cache of free blocks used by a single interrupt priority level. */
+typedef struct
+{
+    uint8_t          count;                                  //!< Number of cached blocks.
+    nrf_balloc_idx_t idx[NRF_BALLOC_CONFIG_MAGAZINE_SIZE];   //!< Indexes of cached blocks.
+} nrf_balloc_magazine_t;
+#endif // NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+#else
+/**@brief Type of the block index. */
+typedef uint8_t nrf_balloc_idx_t;
+
+/**@brief Maximum number of blocks in the pool. */
+#define NRF_BALLOC_MAX_POOL_SIZE        UINT8_MAX
+#endif // NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+
 /**@brief Block memory allocator control block.*/
 typedef struct
 {
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+    nrf_atomic_u32_t   free_head;       //!< First free block (index + 1, 0 if none) and modification counter.
+    nrf_atomic_u32_t   utilization;     //!< Number of elements allocated from the pool.
+    nrf_atomic_u32_t   max_utilization; //!< Maximum utilization of the memory pool.
+#if NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+    nrf_balloc_magazine_t magazine[NRF_BALLOC_MAGAZINE_COUNT]; //!< Free blocks cached per priority level.
+#endif
+#else
     uint8_t * p_stack_pointer;          //!< Current allocation stack pointer.
     uint8_t   max_utilization;          //!< Maximum utilization of the memory pool.
+#endif // NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
 } nrf_balloc_cb_t;
 
 /**@brief Block memory allocator pool instance. The pool is made of elements of the same size. */
 typedef struct
 {
-    nrf_balloc_cb_t * p_cb;             //!< Pointer to the instance control block.
-    uint8_t         * p_stack_base;     //!< Base of the allocation stack.
+    nrf_balloc_cb_t  * p_cb;            //!< Pointer to the instance control block.
+    nrf_balloc_idx_t * p_stack_base;    //!< Base of the allocation stack.
                                         /**<
                                          * Stack is used to store handlers to not allocated elements.
+                                         * In lock-free mode, it holds the index of the next
+                                         * free block (plus one) for each free block.
                                          */
-    uint8_t         * p_stack_limit;    //!< Maximum possible value of the allocation stack pointer.
+    nrf_balloc_idx_t * p_stack_limit;   //!< Maximum possible value of the allocation stack pointer.
     void            * p_memory_begin;   //!< Pointer to the start of the memory pool.
                                         /**<
                                          * Memory is used as a heap for blocks.
@@ -194,8 +255,8 @@ typedef struct
  * @param[in]   _debug_flags    Debug flags (@ref NRF_BALLOC_DEBUG).
  */
 #define NRF_BALLOC_DBG_DEF(_name, _element_size, _pool_size, _debug_flags)                      \
-    STATIC_ASSERT((_pool_size) <= UINT8_MAX);                                                   \
-    static uint8_t              CONCAT_2(_name, _nrf_balloc_pool_stack)[(_pool_size)];          \
+    STATIC_ASSERT((_pool_size) <= NRF_BALLOC_MAX_POOL_SIZE);                                    \
+    static nrf_balloc_idx_t     CONCAT_2(_name, _nrf_balloc_pool_stack)[(_pool_size)];          \
     static uint32_t             CONCAT_2(_name,_nrf_balloc_pool_mem)                            \
         [NRF_BALLOC_BLOCK_SIZE(_element_size, _debug_flags) * (_pool_size) / sizeof(uint32_t)]; \
     static nrf_balloc_cb_t      CONCAT_2(_name,_nrf_balloc_cb);                                 \
@@ -317,13 +378,13 @@ void nrf_balloc_free(nrf_balloc_t const * p_pool, void * p_element);
  *
  * @return Maximum number of elements allocated from the pool.
  */
-__STATIC_INLINE uint8_t nrf_balloc_max_utilization_get(nrf_balloc_t const * p_pool);
+__STATIC_INLINE nrf_balloc_idx_t nrf_balloc_max_utilization_get(nrf_balloc_t const * p_pool);
 
 #ifndef SUPPRESS_INLINE_IMPLEMENTATION
-__STATIC_INLINE uint8_t nrf_balloc_max_utilization_get(nrf_balloc_t const * p_pool)
+__STATIC_INLINE nrf_balloc_idx_t nrf_balloc_max_utilization_get(nrf_balloc_t const * p_pool)
 {
     ASSERT(p_pool != NULL);
-    return p_pool->p_cb->max_utilization;
+    return (nrf_balloc_idx_t)p_pool->p_cb->max_utilization;
 }
 #endif //SUPPRESS_INLINE_IMPLEMENTATION
 
@@ -333,13 +394,17 @@ __STATIC_INLINE uint8_t nrf_balloc_max_utilization_get(nrf_balloc_t const * p_po
  *
  * @return Maximum number of elements allocated from the pool.
  */
-__STATIC_INLINE uint8_t nrf_balloc_utilization_get(nrf_balloc_t const * p_pool);
+__STATIC_INLINE nrf_balloc_idx_t nrf_balloc_utilization_get(nrf_balloc_t const * p_pool);
 
 #ifndef SUPPRESS_INLINE_IMPLEMENTATION
-__STATIC_INLINE uint8_t nrf_balloc_utilization_get(nrf_balloc_t const * p_pool)
+__STATIC_INLINE nrf_balloc_idx_t nrf_balloc_utilization_get(nrf_balloc_t const * p_pool)
 {
     ASSERT(p_pool != NULL);
+#if NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+    return (nrf_balloc_idx_t)p_pool->p_cb->utilization;
+#else
     return (p_pool->p_stack_limit - p_pool->p_cb->p_stack_pointer);
+#endif
 }
 #endif //SUPPRESS_INLINE_IMPLEMENTATION
 
@@ -551,6 +551,10 @@ static void on_data_obj_execute_request_sched(void * p_evt, uint16_t event_lengt
         return;
     }
 
+    /* Hash the executed data objects now that they are in flash. */
+    nrf_dfu_validation_stream_hash_update(m_firmware_start_addr,
+                                          s_dfu_settings.progress.firmware_image_offset_last);
+
     nrf_dfu_response_t res =
     {
         .request = NRF_DFU_OP_OBJECT_EXECUTE,
@@ -68,6 +68,10 @@ NRF_LOG_MODULE_REGISTER();
 #endif
 #endif
 
+#ifndef NRF_DFU_STREAMING_HASH
+#define NRF_DFU_STREAMING_HASH 0
+#endif
+
 #define EXT_ERR(err) (nrf_dfu_result_t)((uint32_t)NRF_DFU_RES_CODE_EXT_ERROR + (uint32_t)err)
 
 /* Whether a complete init command has been received and prevalidated, but the firmware
@@ -105,6 +109,21 @@ static nrf_crypto_hash_sha256_digest_t              m_fw_hash;
  */
 static bool                                         m_crypto_initialized = false;
 
+#if NRF_DFU_STREAMING_HASH
+/** @brief Running hash of the firmware received so far.
+ */
+static nrf_crypto_hash_context_t                    m_stream_hash_context;
+
+/** @brief Start address and length of the firmware fed into the running hash.
+ */
+static uint32_t                                     m_stream_hash_addr;
+static uint32_t                                     m_stream_hash_len;
+
+/** @brief Whether the running hash can be used for the firmware hash check.
+ */
+static bool                                         m_stream_hash_valid = false;
+#endif
+
 /** @brief Flag used by parser code to indicate that the init command has been found to be invalid.
  */
 static bool                                         m_init_packet_valid = false;
@@ -264,6 +283,11 @@ nrf_dfu_result_t nrf_dfu_validation_init_cmd_create(uint32_t size)
         // Set DFU to uninitialized.
         m_valid_init_cmd_present = false;
 
+#if NRF_DFU_STREAMING_HASH
+        // Firmware of the new update must be hashed from the start.
+        m_stream_hash_valid = false;
+#endif
+
         // Reset all progress.
         nrf_dfu_settings_progress_reset();
 
@@ -628,18 +652,11 @@ nrf_dfu_result_t nrf_dfu_validation_init_cmd_execute(uint32_t * p_dst_data_addr,
 }
 
 
-// Function to check the hash received in the init command against the received firmware.
+// Function to compare the expected hash against the hash of the firmware in m_fw_hash.
 // little_endian specifies the endianness of @p p_hash.
-static bool nrf_dfu_validation_hash_ok(uint8_t const * p_hash, uint32_t src_addr, uint32_t data_len, bool little_endian)
+static bool fw_hash_compare(uint8_t const * p_hash, bool little_endian)
 {
-    ret_code_t err_code;
-    bool       result   = true;
-    uint8_t    hash_be[NRF_CRYPTO_HASH_SIZE_SHA256];
-    size_t     hash_len = NRF_CRYPTO_HASH_SIZE_SHA256;
-
-    nrf_crypto_hash_context_t hash_context = {0};
-
-    crypto_init();
+    uint8_t hash_be[NRF_CRYPTO_HASH_SIZE_SHA256];
 
     if (little_endian)
     {
@@ -650,6 +667,33 @@ static bool nrf_dfu_validation_hash_ok(uint8_t const * p_hash, uint32_t src_addr
         p_hash = hash_be;
     }
 
+    if (memcmp(m_fw_hash, p_hash, NRF_CRYPTO_HASH_SIZE_SHA256) != 0)
+    {
+        NRF_LOG_WARNING("Hash verification failed.");
+        NRF_LOG_DEBUG("Expected FW hash:")
+        NRF_LOG_HEXDUMP_DEBUG(p_hash, NRF_CRYPTO_HASH_SIZE_SHA256);
+        NRF_LOG_DEBUG("Actual FW hash:")
+        NRF_LOG_HEXDUMP_DEBUG(m_fw_hash, NRF_CRYPTO_HASH_SIZE_SHA256);
+        NRF_LOG_FLUSH();
+
+        return false;
+    }
+
+    return true;
+}
+
+
+// Function to check the hash received in the init command against the received firmware.
+// little_endian specifies the endianness of @p p_hash.
+static bool nrf_dfu_validation_hash_ok(uint8_t const * p_hash, uint32_t src_addr, uint32_t data_len, bool little_endian)
+{
+    ret_code_t err_code;
+    size_t     hash_len = NRF_CRYPTO_HASH_SIZE_SHA256;
+
+    nrf_crypto_hash_context_t hash_context = {0};
+
+    crypto_init();
+
     NRF_LOG_DEBUG("Hash verification. start address: 0x%x, size: 0x%x",
                   src_addr,
                   data_len);
@@ -664,32 +708,109 @@ static bool nrf_dfu_validation_hash_ok(uint8_t const * p_hash, uint32_t src_addr
     if (err_code != NRF_SUCCESS)
     {
         NRF_LOG_ERROR("Could not run hash verification (err_code 0x%x).", err_code);
-        result = false;
+        return false;
     }
-    else if (memcmp(m_fw_hash, p_hash, NRF_CRYPTO_HASH_SIZE_SHA256) != 0)
+
+    return fw_hash_compare(p_hash, little_endian);
+}
+
+
+void nrf_dfu_validation_stream_hash_update(uint32_t data_addr, uint32_t data_len)
+{
+#if NRF_DFU_STREAMING_HASH
+    ret_code_t err_code = NRF_SUCCESS;
+
+    if (!m_stream_hash_valid || (m_stream_hash_addr != data_addr) || (m_stream_hash_len > data_len))
     {
-        NRF_LOG_WARNING("Hash verification failed.");
-        NRF_LOG_DEBUG("Expected FW hash:")
-        NRF_LOG_HEXDUMP_DEBUG(p_hash, NRF_CRYPTO_HASH_SIZE_SHA256);
-        NRF_LOG_DEBUG("Actual FW hash:")
-        NRF_LOG_HEXDUMP_DEBUG(m_fw_hash, NRF_CRYPTO_HASH_SIZE_SHA256);
-        NRF_LOG_FLUSH();
+        crypto_init();
 
-        result = false;
+        err_code = nrf_crypto_hash_init(&m_stream_hash_context, &g_nrf_crypto_hash_sha256_info);
+
+        m_stream_hash_addr = data_addr;
+        m_stream_hash_len  = 0;
+    }
+
+    if ((err_code == NRF_SUCCESS) && (data_len > m_stream_hash_len))
+    {
+        // Data is read back from flash so that the hash covers what was actually written.
+        err_code = nrf_crypto_hash_update(&m_stream_hash_context,
+                                          (uint8_t *)(data_addr + m_stream_hash_len),
+                                          data_len - m_stream_hash_len);
     }
 
+    if (err_code == NRF_SUCCESS)
+    {
+        m_stream_hash_len   = data_len;
+        m_stream_hash_valid = true;
+    }
+    else
+    {
+        NRF_LOG_WARNING("Could not update running hash (err_code 0x%x).", err_code);
+        m_stream_hash_valid = false;
+    }
+#else
+    UNUSED_PARAMETER(data_addr);
+    UNUSED_PARAMETER(data_len);
+#endif
+}
+
+
+#if NRF_DFU_STREAMING_HASH
+// Function to finalize the running hash into m_fw_hash. Returns false if the running hash does not
+// cover exactly the given firmware, in which case the firmware must be hashed from flash.
+static bool stream_hash_finalize(uint32_t src_addr, uint32_t data_len)
+{
+    size_t hash_len = NRF_CRYPTO_HASH_SIZE_SHA256;
+    bool   result   = m_stream_hash_valid              &&
+                      (m_stream_hash_addr == src_addr) &&
+                      (m_stream_hash_len == data_len);
+
+    if (result)
+    {
+        NRF_LOG_DEBUG("Hash verification using running hash. size: 0x%x", data_len);
+
+        result = (nrf_crypto_hash_finalize(&m_stream_hash_context, m_fw_hash, &hash_len) == NRF_SUCCESS);
+    }
+
+    // The running hash can only be finalized once.
+    m_stream_hash_valid = false;
+
     return result;
 }
+#endif
 
 
 // Function to check the hash received in the init command against the received firmware.
 bool fw_hash_ok(dfu_init_command_t const * p_init, uint32_t fw_start_addr, uint32_t fw_size)
 {
     ASSERT(p_init != NULL);
+
+#if NRF_DFU_STREAMING_HASH
+    if (stream_hash_finalize(fw_start_addr, fw_size))
+    {
+        return fw_hash_compare((uint8_t *)p_init->hash.hash.bytes, true);
+    }
+#endif
+
     return nrf_dfu_validation_hash_ok((uint8_t *)p_init->hash.hash.bytes, fw_start_addr, fw_size, true);
 }
 
 
+// Function to get the CRC of the received firmware.
+static uint32_t fw_crc_get(uint32_t data_addr, uint32_t data_len)
+{
+#if NRF_DFU_STREAMING_HASH
+    // The CRC accumulated over the received data objects is reused when it covers the firmware.
+    if (s_dfu_settings.progress.firmware_image_offset_last == data_len)
+    {
+        return s_dfu_settings.progress.firmware_image_crc_last;
+    }
+#endif
+
+    return crc32_compute((uint8_t *)data_addr, data_len, NULL);
+}
+
+
 // Function to check whether the update contains a SoftDevice and, if so, if it is of a different
 // major version than the existing SoftDevice.
 static bool is_major_softdevice_update(uint32_t new_sd_addr)
@@ -1053,7 +1174,7 @@ nrf_dfu_result_t postvalidate(uint32_t data_addr, uint32_t data_len, bool is_tru
         if (ret_val == NRF_DFU_RES_CODE_SUCCESS)
         {
             // Mark the update as complete and valid.
-            s_dfu_settings.bank_1.image_crc  = crc32_compute((uint8_t *)data_addr, data_len, NULL);
+            s_dfu_settings.bank_1.image_crc  = fw_crc_get(data_addr, data_len);
             s_dfu_settings.bank_1.image_size = data_len;
         }
         else
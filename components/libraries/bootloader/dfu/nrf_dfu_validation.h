@@ -131,6 +131,20 @@ nrf_dfu_result_t nrf_dfu_validation_prevalidate(void);
  */
 bool nrf_dfu_validation_boot_validate(boot_validation_t const * p_validation, uint32_t data_addr, uint32_t data_len);
 
+/**
+ * @brief Function for feeding received firmware into the running hash.
+ *
+ * Called when all data objects received so far are written to flash. Data between the end of
+ * the previously hashed data and @p data_len is read from flash and hashed, so the firmware
+ * hash check after the last data object does not need to hash the whole firmware.
+ *
+ * @note This function does nothing unless NRF_DFU_STREAMING_HASH is set to 1.
+ *
+ * @param[in] data_addr  Start address of the received data.
+ * @param[in] data_len   Length of the data received so far.
+ */
+void nrf_dfu_validation_stream_hash_update(uint32_t data_addr, uint32_t data_len);
+
 /**
  * @brief Function for postvalidating the update after all data is received.
  *
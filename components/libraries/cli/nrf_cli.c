@@ -3283,6 +3283,7 @@ static bool cli_log_entry_process(nrf_cli_t const * p_cli, bool skip)
         params.module_id  = header.module_id;
         params.dropped    = header.dropped;
         params.use_colors = NRF_LOG_USES_COLORS; /* Color will be provided by the console application. */
+        params.defer_flush = false;
 
         if (header.base.generic.type == HEADER_TYPE_STD)
         {
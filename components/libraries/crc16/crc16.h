@@ -56,6 +56,12 @@
 extern "C" {
 #endif
 
+/**@brief CRC-16 streaming context. */
+typedef struct
+{
+    uint16_t crc; //!< Running CRC-16 value.
+} crc16_ctx_t;
+
 /**@brief Function for calculating CRC-16 in blocks.
  *
  * Feed each consecutive data block into this function, along with the current value of p_crc as
@@ -70,6 +76,42 @@ extern "C" {
  */
 uint16_t crc16_compute(uint8_t const * p_data, uint32_t size, uint16_t const * p_crc);
 
+/**@brief Function for calculating CRC-16 over a word-aligned block.
+ *
+ * Gives the same result as @ref crc16_compute called on the same memory, but reads the data one
+ * word at a time. Use it for data that is known to be 4-byte aligned, such as FDS record data.
+ * With the slice-by-4 engine, each word is processed with four table lookups in one iteration.
+ *
+ * @param[in] p_words   The input data block. Must be aligned to a 4-byte boundary.
+ * @param[in] len_words The size of the input data block in 4-byte words.
+ * @param[in] p_crc     The previous calculated CRC-16 value or NULL if first call.
+ *
+ * @return The updated CRC-16 value, based on the input supplied.
+ */
+uint16_t crc16_compute_words(uint32_t const * p_words, uint32_t len_words, uint16_t const * p_crc);
+
+/**@brief Function for initializing a CRC-16 streaming context.
+ *
+ * @param[out] p_ctx Context to initialize.
+ */
+void crc16_init(crc16_ctx_t * p_ctx);
+
+/**@brief Function for feeding a data block into a CRC-16 streaming context.
+ *
+ * @param[in,out] p_ctx  Context initialized with @ref crc16_init.
+ * @param[in]     p_data The input data block for computation.
+ * @param[in]     size   The size of the input data block in bytes.
+ */
+void crc16_update(crc16_ctx_t * p_ctx, uint8_t const * p_data, uint32_t size);
+
+/**@brief Function for getting the CRC-16 value of all data fed into a streaming context.
+ *
+ * @param[in] p_ctx Context to read.
+ *
+ * @return The CRC-16 value of the data supplied so far.
+ */
+uint16_t crc16_final(crc16_ctx_t const * p_ctx);
+
 
 #ifdef __cplusplus
 }
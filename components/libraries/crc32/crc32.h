@@ -55,6 +55,16 @@
 extern "C" {
 #endif
 
+/**@brief CRC-32 streaming context.
+ *
+ * @details Holds the running (non-inverted) CRC-32 register between calls to @ref crc32_update.
+ *          The result is identical to feeding the same data through @ref crc32_compute.
+ */
+typedef struct
+{
+    uint32_t crc; //!< Running CRC-32 register value.
+} crc32_ctx_t;
+
 /**@brief Function for calculating CRC-32 in blocks.
  *
  * Feed each consecutive data block into this function, along with the current value of p_crc as
@@ -69,6 +79,30 @@ extern "C" {
  */
 uint32_t crc32_compute(uint8_t const * p_data, uint32_t size, uint32_t const * p_crc);
 
+/**@brief Function for initializing a CRC-32 streaming context.
+ *
+ * @param[out] p_ctx Context to initialize.
+ */
+void crc32_init(crc32_ctx_t * p_ctx);
+
+/**@brief Function for feeding a data block into a CRC-32 streaming context.
+ *
+ * @param[in,out] p_ctx  Context initialized with @ref crc32_init.
+ * @param[in]     p_data The input data block for computation.
+ * @param[in]     size   The size of the input data block in bytes.
+ */
+void crc32_update(crc32_ctx_t * p_ctx, uint8_t const * p_data, uint32_t size);
+
+/**@brief Function for getting the CRC-32 value of all data fed into a streaming context.
+ *
+ * The context is not modified, so more data can be fed into it afterwards.
+ *
+ * @param[in] p_ctx Context to read.
+ *
+ * @return The CRC-32 value of the data supplied so far.
+ */
+uint32_t crc32_final(crc32_ctx_t const * p_ctx);
+
 
 #ifdef __cplusplus
 }
@@ -99,6 +99,100 @@ static fds_swap_page_t      m_swap_page;
 // Garbage collection data.
 static fds_gc_data_t        m_gc;
 
+#if (FDS_WRITE_BATCH_ENABLED)
+// Staging buffer for batched writes. Must be statically allocated since it is not buffered
+// by fstorage. Only one operation is executed at a time, so one buffer is enough.
+static uint32_t             m_batch_buf[FDS_WRITE_BATCH_BUFFER_WORDS];
+// The header of the record being committed. Its file ID and CRC are written to flash.
+static fds_header_t         m_batch_header;
+#endif
+
+#if (FDS_TELEMETRY_ENABLED)
+// Wear and latency telemetry. Erase counts are kept per virtual page, in the order in which
+// pages are laid out in flash. Latencies are kept per type of operation, indexed by event ID.
+static struct
+{
+    fds_timestamp_func_t timestamp_func;
+    uint32_t             counter_mask;
+    uint32_t             op_started;    // When the current operation started executing.
+    uint32_t             page_erase_count[FDS_VIRTUAL_PAGES];
+    fds_op_latency_t     latency[FDS_EVT_WRITE_BATCH + 1];
+} m_telemetry =
+{
+    .counter_mask = 0xFFFFFFFF,
+};
+#endif
+
+#if (FDS_INDEX_ENABLED)
+// RAM index of valid records, kept sorted by location (page, then offset), which is the same
+// order in which a flash scan finds them. 'by_id' holds the positions of the entries sorted by
+// record ID, for lookups by ID. While 'valid' is false, the index may be missing records and
+// lookups fall back to scanning flash. Entries are only hints: the record header in flash is
+// always checked before an entry is used.
+static struct
+{
+    fds_index_entry_t entries[FDS_INDEX_SIZE];
+    uint16_t          by_id[FDS_INDEX_SIZE];
+    uint16_t          count;
+    bool              valid;
+} m_index;
+#endif
+
+
+#if (FDS_TELEMETRY_ENABLED)
+static uint32_t telemetry_timestamp(void)
+{
+    return (m_telemetry.timestamp_func != NULL) ? m_telemetry.timestamp_func() : 0;
+}
+
+
+// Returns the histogram bucket of a latency. See FDS_LATENCY_HIST_BUCKETS.
+static uint8_t telemetry_bucket(uint32_t ticks)
+{
+    uint8_t bucket = 0;
+
+    while ((ticks != 0) && (bucket < FDS_LATENCY_HIST_BUCKETS - 1))
+    {
+        ticks >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+
+static void telemetry_op_completed(fds_op_t const * const p_op, fds_evt_t const * const p_evt)
+{
+    fds_op_latency_t * const p_latency = &m_telemetry.latency[p_evt->id];
+
+    uint32_t const wait = (m_telemetry.op_started - p_op->timestamp) & m_telemetry.counter_mask;
+    uint32_t const exec = (telemetry_timestamp() - m_telemetry.op_started) & m_telemetry.counter_mask;
+
+    p_latency->count++;
+    if (p_evt->result != NRF_SUCCESS)
+    {
+        p_latency->errors++;
+    }
+
+    p_latency->wait_max = MAX(p_latency->wait_max, wait);
+    p_latency->exec_max = MAX(p_latency->exec_max, exec);
+
+    p_latency->wait_hist[telemetry_bucket(wait)]++;
+    p_latency->exec_hist[telemetry_bucket(exec)]++;
+}
+
+
+static void telemetry_page_erased(uint32_t addr)
+{
+    uint32_t const page = (addr - m_fs.start_addr) / (FDS_PAGE_SIZE * sizeof(uint32_t));
+
+    if (page < FDS_VIRTUAL_PAGES)
+    {
+        m_telemetry.page_erase_count[page]++;
+    }
+}
+#endif
+
 
 static void event_send(fds_evt_t const * const p_evt)
 {
@@ -151,7 +245,14 @@ static void event_prepare(fds_op_t const * const p_op, fds_evt_t * const p_evt)
             break;
 
         case FDS_OP_GC:
-            p_evt->id = FDS_EVT_GC;
+            p_evt->id             = FDS_EVT_GC;
+            p_evt->gc.is_complete = (m_gc.state == GC_BEGIN);
+            break;
+
+        case FDS_OP_WRITE_BATCH:
+            p_evt->id                    = FDS_EVT_WRITE_BATCH;
+            p_evt->batch.first_record_id = p_op->batch.first_record_id;
+            p_evt->batch.count           = p_op->batch.count;
             break;
 
         default:
@@ -298,9 +399,11 @@ static ret_code_t page_from_record(uint16_t * const p_page, uint32_t const * con
 // Scan a page to determine how many words have been written to it.
 // This information is used to set the page write offset during initialization.
 // Additionally, this function updates the latest record ID as it proceeds.
-// If an invalid record header is found, the can_gc argument is set to true.
+// If an invalid record header is found, the can_gc argument is set to true and the
+// size of the invalid record is added to words_dirty.
 static void page_scan(uint32_t const *       p_addr,
                       uint16_t       * const words_written,
+                      uint16_t       * const words_dirty,
                       bool           * const can_gc)
 {
     uint32_t const * const p_page_end = p_addr + FDS_PAGE_SIZE;
@@ -331,6 +434,11 @@ static void page_scan(uint32_t const *       p_addr,
 
             if (hdr == FDS_HEADER_CORRUPT)
             {
+                if (words_dirty != NULL)
+                {
+                    *words_dirty += (FDS_PAGE_SIZE - *words_written);
+                }
+
                 // It could happen that a record has a corrupt header which would set a
                 // wrong offset for this page. In such cases, update this value to its maximum,
                 // to ensure that no new records will be written to this page and to enable
@@ -340,6 +448,11 @@ static void page_scan(uint32_t const *       p_addr,
                 // We can't continue to scan this page.
                 return;
             }
+
+            if (words_dirty != NULL)
+            {
+                *words_dirty += (FDS_HEADER_SIZE + p_header->length_words);
+            }
         }
 
         *words_written += (FDS_HEADER_SIZE + p_header->length_words);
@@ -477,6 +590,310 @@ static bool record_find_next(uint16_t page, uint32_t const ** p_record)
 }
 
 
+#if (FDS_INDEX_ENABLED)
+// Compute the sort key of a location in the index.
+static uint32_t index_pos(uint16_t page, uint16_t offset)
+{
+    return ((uint32_t)page << 16) | offset;
+}
+
+
+// Find the first index entry located at or after the given position.
+// NOTE: Must be called from within a critical section.
+static uint16_t index_lower_bound(uint32_t pos)
+{
+    uint16_t lo = 0;
+    uint16_t hi = m_index.count;
+
+    while (lo < hi)
+    {
+        uint16_t const mid = lo + ((hi - lo) / 2);
+
+        if (index_pos(m_index.entries[mid].page, m_index.entries[mid].offset) < pos)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+
+// Find the first position in 'by_id' of an entry with the given record ID or a larger one.
+// NOTE: Must be called from within a critical section.
+static uint16_t index_id_lower_bound(uint32_t record_id)
+{
+    uint16_t lo = 0;
+    uint16_t hi = m_index.count;
+
+    while (lo < hi)
+    {
+        uint16_t const mid = lo + ((hi - lo) / 2);
+
+        if (m_index.entries[m_index.by_id[mid]].record_id < record_id)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+
+// Remove the entries in the range [first, last) from both orders of the index.
+// NOTE: Must be called from within a critical section.
+static void index_entries_remove(uint16_t first, uint16_t last)
+{
+    uint16_t const removed = last - first;
+    uint16_t       count   = 0;
+
+    for (uint16_t i = 0; i < m_index.count; i++)
+    {
+        uint16_t const pos = m_index.by_id[i];
+
+        if (pos < first)
+        {
+            m_index.by_id[count++] = pos;
+        }
+        else if (pos >= last)
+        {
+            m_index.by_id[count++] = pos - removed;
+        }
+    }
+
+    memmove(&m_index.entries[first], &m_index.entries[last],
+            (m_index.count - last) * sizeof(fds_index_entry_t));
+    m_index.count = count;
+}
+
+
+// Get the record an index entry refers to, if the record is still valid.
+// Returns NULL if the record has been deleted or moved since the entry was added.
+static fds_header_t const * index_entry_header(fds_index_entry_t const * const p_entry)
+{
+    uint32_t     const * const p_page_end = m_pages[p_entry->page].p_addr + FDS_PAGE_SIZE;
+    fds_header_t const * const p_header   =
+        (fds_header_t*)(m_pages[p_entry->page].p_addr + p_entry->offset);
+
+    if (   (m_pages[p_entry->page].page_type != FDS_PAGE_DATA)
+        || (!header_has_next(p_header, p_page_end))
+        || (header_check(p_header, p_page_end) != FDS_HEADER_VALID)
+        || (p_header->record_id != p_entry->record_id))
+    {
+        return NULL;
+    }
+
+    return p_header;
+}
+
+
+// Add a record to the index. If the index is full, it is flagged as incomplete.
+static void index_insert(uint16_t page, uint32_t const * const p_record)
+{
+    fds_header_t const * const p_header = (fds_header_t*)p_record;
+    uint16_t             const offset   = (uint16_t)(p_record - m_pages[page].p_addr);
+    uint16_t                   i;
+
+    CRITICAL_SECTION_ENTER();
+    i = index_lower_bound(index_pos(page, offset));
+
+    if ((i < m_index.count) &&
+        (m_index.entries[i].page == page) && (m_index.entries[i].offset == offset))
+    {
+        // Already indexed.
+    }
+    else if (m_index.count < FDS_INDEX_SIZE)
+    {
+        uint16_t j;
+
+        memmove(&m_index.entries[i + 1], &m_index.entries[i],
+                (m_index.count - i) * sizeof(fds_index_entry_t));
+
+        m_index.entries[i].record_id  = p_header->record_id;
+        m_index.entries[i].file_id    = p_header->file_id;
+        m_index.entries[i].record_key = p_header->record_key;
+        m_index.entries[i].page       = page;
+        m_index.entries[i].offset     = offset;
+
+        // Entries at or after 'i' have moved by one.
+        for (j = 0; j < m_index.count; j++)
+        {
+            if (m_index.by_id[j] >= i)
+            {
+                m_index.by_id[j]++;
+            }
+        }
+
+        j = index_id_lower_bound(p_header->record_id);
+        memmove(&m_index.by_id[j + 1], &m_index.by_id[j],
+                (m_index.count - j) * sizeof(m_index.by_id[0]));
+        m_index.by_id[j] = i;
+        m_index.count++;
+    }
+    else
+    {
+        // Out of memory; lookups must scan flash until the index is rebuilt.
+        m_index.valid = false;
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Remove a record from the index, if present.
+static void index_remove(uint16_t page, uint32_t const * const p_record)
+{
+    uint16_t const offset = (uint16_t)(p_record - m_pages[page].p_addr);
+    uint16_t       i;
+
+    CRITICAL_SECTION_ENTER();
+    i = index_lower_bound(index_pos(page, offset));
+
+    if ((i < m_index.count) &&
+        (m_index.entries[i].page == page) && (m_index.entries[i].offset == offset))
+    {
+        index_entries_remove(i, i + 1);
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Drop all index entries for a page and add the valid records currently stored on it.
+// Used after a page has been garbage collected, since its records have moved.
+static void index_page_rebuild(uint16_t page)
+{
+    uint32_t const * p_record = NULL;
+    uint16_t         first;
+    uint16_t         last;
+
+    CRITICAL_SECTION_ENTER();
+    first = index_lower_bound(index_pos(page, 0));
+    last  = index_lower_bound(index_pos(page + 1, 0));
+
+    index_entries_remove(first, last);
+    CRITICAL_SECTION_EXIT();
+
+    if (m_pages[page].page_type != FDS_PAGE_DATA)
+    {
+        return;
+    }
+
+    while (record_find_next(page, &p_record))
+    {
+        index_insert(page, p_record);
+    }
+}
+
+
+// Build the index from scratch by scanning all data pages.
+static void index_rebuild(void)
+{
+    m_index.count = 0;
+    m_index.valid = true;
+
+    for (uint16_t page = 0; page < FDS_DATA_PAGES; page++)
+    {
+        index_page_rebuild(page);
+    }
+}
+
+
+// Index-based equivalent of record_find_by_desc(), used when the descriptor is stale.
+static bool index_find_by_id(fds_record_desc_t * const p_desc, uint16_t * const p_page)
+{
+    bool found = false;
+
+    CRITICAL_SECTION_ENTER();
+    for (uint16_t i = index_id_lower_bound(p_desc->record_id); i < m_index.count; i++)
+    {
+        fds_index_entry_t const * const p_entry = &m_index.entries[m_index.by_id[i]];
+
+        if (p_entry->record_id != p_desc->record_id)
+        {
+            break;
+        }
+
+        if (index_entry_header(p_entry) != NULL)
+        {
+            *p_page              = p_entry->page;
+            p_desc->p_record     = m_pages[p_entry->page].p_addr + p_entry->offset;
+            p_desc->gc_run_count = m_gc.run_count;
+            found                = true;
+            break;
+        }
+    }
+    CRITICAL_SECTION_EXIT();
+
+    return found;
+}
+
+
+// Index-based equivalent of record_find(). Records are returned in the same order as a
+// flash scan would return them, and the search token has the same meaning.
+static ret_code_t index_find(uint16_t          const * p_file_id,
+                             uint16_t          const * p_record_key,
+                             fds_record_desc_t       * p_desc,
+                             fds_find_token_t        * p_token)
+{
+    ret_code_t ret = FDS_ERR_NOT_FOUND;
+    uint32_t   pos;
+
+    if (p_token->page >= FDS_DATA_PAGES)
+    {
+        return FDS_ERR_NOT_FOUND;
+    }
+
+    // Resume the search right after the record the token points to.
+    pos = (p_token->p_addr == NULL) ?
+          index_pos(p_token->page, 0) :
+          index_pos(p_token->page, (uint16_t)(p_token->p_addr - m_pages[p_token->page].p_addr)) + 1;
+
+    CRITICAL_SECTION_ENTER();
+    for (uint16_t i = index_lower_bound(pos); i < m_index.count; i++)
+    {
+        fds_index_entry_t const * const p_entry = &m_index.entries[i];
+
+        if (((p_file_id    != NULL) && (p_entry->file_id    != *p_file_id)) ||
+            ((p_record_key != NULL) && (p_entry->record_key != *p_record_key)))
+        {
+            continue;
+        }
+
+        if (index_entry_header(p_entry) == NULL)
+        {
+            continue;
+        }
+
+        p_token->page   = p_entry->page;
+        p_token->p_addr = m_pages[p_entry->page].p_addr + p_entry->offset;
+
+        p_desc->record_id    = p_entry->record_id;
+        p_desc->p_record     = p_token->p_addr;
+        p_desc->gc_run_count = m_gc.run_count;
+
+        ret = NRF_SUCCESS;
+        break;
+    }
+    CRITICAL_SECTION_EXIT();
+
+    if (ret != NRF_SUCCESS)
+    {
+        p_token->page   = FDS_DATA_PAGES;
+        p_token->p_addr = NULL;
+    }
+
+    return ret;
+}
+#endif // FDS_INDEX_ENABLED
+
+
 // Find a record given its descriptor and retrive the page in which the record is stored.
 // NOTE: Do not pass NULL as an argument for p_page.
 static bool record_find_by_desc(fds_record_desc_t * const p_desc, uint16_t * const p_page)
@@ -492,6 +909,13 @@ static bool record_find_by_desc(fds_record_desc_t * const p_desc, uint16_t * con
         return (page_from_record(p_page, p_desc->p_record) == NRF_SUCCESS);
     }
 
+#if (FDS_INDEX_ENABLED)
+    if (m_index.valid)
+    {
+        return index_find_by_id(p_desc, p_page);
+    }
+#endif
+
     // Otherwise, find the record in flash.
     for (*p_page = 0; *p_page < FDS_DATA_PAGES; (*p_page)++)
     {
@@ -533,6 +957,13 @@ static ret_code_t record_find(uint16_t          const * p_file_id,
         return FDS_ERR_NULL_ARG;
     }
 
+#if (FDS_INDEX_ENABLED)
+    if (m_index.valid)
+    {
+        return index_find(p_file_id, p_record_key, p_desc, p_token);
+    }
+#endif
+
     // Begin (or resume) searching for a record.
     for (; p_token->page < FDS_DATA_PAGES; p_token->page++)
     {
@@ -623,7 +1054,13 @@ static fds_op_t * queue_buf_get(nrf_atfifo_item_put_t * p_iput_ctx)
 {
     fds_op_t * const p_op = (fds_op_t*) nrf_atfifo_item_alloc(m_queue, p_iput_ctx);
 
-    memset(p_op, 0x00, sizeof(fds_op_t));
+    if (p_op != NULL)
+    {
+        memset(p_op, 0x00, sizeof(fds_op_t));
+#if (FDS_TELEMETRY_ENABLED)
+        p_op->timestamp = telemetry_timestamp();
+#endif
+    }
     return p_op;
 }
 
@@ -719,7 +1156,10 @@ static fds_init_opts_t pages_init(void)
 
                 // Scan the page to compute its write offset and determine whether or not the page
                 // can be garbage collected. Additionally, update the latest kwown record ID.
-                page_scan(p_page_addr, &m_pages[page].write_offset, &m_pages[page].can_gc);
+                page_scan(p_page_addr,
+                          &m_pages[page].write_offset,
+                          &m_pages[page].words_dirty,
+                          &m_pages[page].can_gc);
 
                 ret |= PAGE_DATA;
                 page++;
@@ -742,7 +1182,7 @@ static fds_init_opts_t pages_init(void)
                 m_swap_page.p_addr = p_page_addr;
                 // If the swap is promoted, this offset should be kept, otherwise,
                 // it should be set to FDS_PAGE_TAG_SIZE.
-                page_scan(p_page_addr, &m_swap_page.write_offset, NULL);
+                page_scan(p_page_addr, &m_swap_page.write_offset, NULL, NULL);
 
                 ret |= (m_swap_page.write_offset == FDS_PAGE_TAG_SIZE) ?
                         PAGE_SWAP_CLEAN : PAGE_SWAP_DIRTY;
@@ -827,7 +1267,12 @@ static ret_code_t record_header_flag_dirty(uint32_t * const p_record, uint16_t p
         return FDS_ERR_BUSY;
     }
 
-    m_pages[page_to_gc].can_gc = true;
+    m_pages[page_to_gc].can_gc       = true;
+    m_pages[page_to_gc].words_dirty += FDS_HEADER_SIZE + ((fds_header_t*)p_record)->length_words;
+
+#if (FDS_INDEX_ENABLED)
+    index_remove(page_to_gc, p_record);
+#endif
 
     return NRF_SUCCESS;
 }
@@ -908,6 +1353,23 @@ static ret_code_t record_write_data(fds_op_t * const p_op, uint32_t * const p_ad
 
 
 #if (FDS_CRC_CHECK_ON_READ)
+// Computes the CRC of a record from its header and its word-aligned data.
+static uint16_t record_crc(fds_header_t const * const p_header, void const * const p_data)
+{
+    uint16_t crc;
+
+    // First, compute the CRC for the first 6 bytes of the header which contain the
+    // record key, length and file ID, then, compute the CRC of the record ID (4 bytes).
+    crc = crc16_compute((uint8_t const *)p_header,             6, NULL);
+    crc = crc16_compute((uint8_t const *)&p_header->record_id, 4, &crc);
+
+    // Compute the CRC for the record data.
+    crc = crc16_compute_words((uint32_t const *)p_data, p_header->length_words, &crc);
+
+    return crc;
+}
+
+
 static bool crc_verify_success(uint16_t crc, uint16_t len_words, uint32_t const * const p_data)
 {
     uint16_t computed_crc;
@@ -917,9 +1379,9 @@ static bool crc_verify_success(uint16_t crc, uint16_t len_words, uint32_t const
     // CRC itself is stored. Then we compute the CRC for the rest of the record, from byte 8 of
     // the header (where the record ID begins) to the end of the record data.
     computed_crc = crc16_compute((uint8_t const *)p_data,  6, NULL);
-    computed_crc = crc16_compute((uint8_t const *)p_data + 8,
-                                 (FDS_HEADER_SIZE_ID + len_words) * sizeof(uint32_t),
-                                 &computed_crc);
+    computed_crc = crc16_compute_words(p_data + FDS_OFFSET_ID,
+                                       FDS_HEADER_SIZE_ID + len_words,
+                                       &computed_crc);
 
     return (computed_crc == crc);
 }
@@ -1063,6 +1525,14 @@ static ret_code_t gc_next_page(void)
         m_gc.cur_page     = 0;
         m_gc.p_record_src = NULL;
 
+#if (FDS_INDEX_ENABLED)
+        // GC may have freed enough records for the index to fit again.
+        if (!m_index.valid)
+        {
+            index_rebuild();
+        }
+#endif
+
         return FDS_OP_COMPLETED;
     }
 
@@ -1094,7 +1564,13 @@ static void gc_swap_pages(void)
     m_swap_page.write_offset            = FDS_PAGE_TAG_SIZE;
 
     // Page has been garbage collected
-    m_pages[m_gc.cur_page].can_gc = false;
+    m_pages[m_gc.cur_page].can_gc      = false;
+    m_pages[m_gc.cur_page].words_dirty = 0;
+
+#if (FDS_INDEX_ENABLED)
+    // The records on this page have moved.
+    index_page_rebuild(m_gc.cur_page);
+#endif
 }
 
 
@@ -1175,6 +1651,9 @@ static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
             }
             if (!write_reqd)
             {
+#if (FDS_INDEX_ENABLED)
+                index_rebuild();
+#endif
                 m_flags.initialized  = true;
                 m_flags.initializing = false;
                 return FDS_OP_COMPLETED;
@@ -1294,6 +1773,10 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
         case FDS_OP_WRITE_DONE:
             ret = FDS_OP_COMPLETED;
 
+#if (FDS_INDEX_ENABLED)
+            index_insert(p_op->write.page, p_write_addr);
+#endif
+
 #if (FDS_CRC_CHECK_ON_WRITE)
             if (!crc_verify_success(p_op->write.header.crc16,
                                     p_op->write.header.length_words,
@@ -1321,18 +1804,333 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
 }
 
 
-static ret_code_t delete_execute(uint32_t prev_ret, fds_op_t * const p_op)
+#if (FDS_WRITE_BATCH_ENABLED)
+// The size of the n-th record of a batch, including its header.
+static uint16_t batch_record_size(fds_op_t const * const p_op, uint16_t n)
 {
-    ret_code_t ret;
+    return (uint16_t)(FDS_HEADER_SIZE + p_op->batch.p_records[n].data.length_words);
+}
 
-    if (prev_ret != NRF_SUCCESS)
+
+// The total size of the first 'count' records of a batch.
+static uint16_t batch_records_size(fds_op_t const * const p_op, uint16_t count)
+{
+    uint16_t size = 0;
+
+    for (uint16_t i = 0; i < count; i++)
     {
-        return FDS_ERR_OPERATION_TIMEOUT;
+        size += batch_record_size(p_op, i);
     }
 
-    switch (p_op->del.step)
-    {
-        case FDS_OP_DEL_RECORD_FLAG_DIRTY:
+    return size;
+}
+
+
+// Copies the next words of the batch to the staging buffer, in the order in which they are
+// laid out in flash. The file ID and CRC are left erased; they are written on commit.
+// Returns the number of words copied.
+static uint16_t batch_stage(fds_op_t * const p_op)
+{
+    uint16_t copied = 0;
+
+    while ((copied < FDS_WRITE_BATCH_BUFFER_WORDS) &&
+           (p_op->batch.words_written + copied < p_op->batch.length_words))
+    {
+        fds_record_t const * const p_record = &p_op->batch.p_records[p_op->batch.rec];
+        uint16_t             const size     = batch_record_size(p_op, p_op->batch.rec);
+        uint16_t             const pos      = p_op->batch.words_written + copied
+                                            - p_op->batch.rec_offset;
+
+        if (pos < FDS_HEADER_SIZE)
+        {
+            fds_header_t const header =
+            {
+                .record_key   = p_record->key,
+                .length_words = (uint16_t)p_record->data.length_words,
+                .file_id      = FDS_FILE_ID_INVALID,
+                .crc16        = 0xFFFF,
+                .record_id    = p_op->batch.first_record_id + p_op->batch.rec,
+            };
+
+            memcpy(&m_batch_buf[copied], (uint32_t const *)&header + pos, sizeof(uint32_t));
+            copied++;
+        }
+        else
+        {
+            uint16_t const len = MIN(size - pos, FDS_WRITE_BATCH_BUFFER_WORDS - copied);
+
+            memcpy(&m_batch_buf[copied],
+                   (uint32_t const *)p_record->data.p_data + (pos - FDS_HEADER_SIZE),
+                   len * sizeof(uint32_t));
+            copied += len;
+        }
+
+        if (p_op->batch.words_written + copied == p_op->batch.rec_offset + size)
+        {
+            // Move on to the next record.
+            p_op->batch.rec_offset += size;
+            p_op->batch.rec++;
+        }
+    }
+
+    return copied;
+}
+
+
+// Counts the words at the start of a chunk which might have been written, that is, all words up
+// to the last one which is not erased. Flash is written one word at a time, in order. The first
+// word of every staged header is never erased, so the count always ends inside a record whose
+// header has been written.
+static uint16_t batch_words_programmed(uint32_t const * const p_chunk, uint16_t words)
+{
+    while ((words > 0) && (p_chunk[words - 1] == FDS_ERASED_WORD))
+    {
+        words--;
+    }
+
+    return words;
+}
+
+
+// Writes the file ID and CRC of the current record, which makes it valid.
+static ret_code_t batch_record_commit(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t                 ret;
+    fds_record_t const * const p_record = &p_op->batch.p_records[p_op->batch.rec];
+
+    m_batch_header.record_key   = p_record->key;
+    m_batch_header.length_words = (uint16_t)p_record->data.length_words;
+    m_batch_header.file_id      = p_record->file_id;
+    m_batch_header.crc16        = 0;
+    m_batch_header.record_id    = p_op->batch.first_record_id + p_op->batch.rec;
+
+#if (FDS_CRC_CHECK_ON_READ)
+    m_batch_header.crc16 = record_crc(&m_batch_header, p_record->data.p_data);
+#endif
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_OFFSET_IC),
+        &m_batch_header.file_id, FDS_HEADER_SIZE_IC * sizeof(uint32_t), NULL);
+
+    return (ret == NRF_SUCCESS) ? NRF_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+// Issues the next flash operation of a batch.
+static ret_code_t batch_step(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t ret;
+
+    switch (p_op->batch.step)
+    {
+        case FDS_OP_BATCH_WRITE:
+            if (p_op->batch.words_written < p_op->batch.length_words)
+            {
+                p_op->batch.words_pending = batch_stage(p_op);
+
+                ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + p_op->batch.words_written),
+                    m_batch_buf, p_op->batch.words_pending * sizeof(uint32_t), NULL);
+
+                return (ret == NRF_SUCCESS) ? FDS_OP_EXECUTING : FDS_ERR_BUSY;
+            }
+
+            // All headers and data have been written. Commit the records.
+            p_op->batch.step       = FDS_OP_BATCH_COMMIT;
+            p_op->batch.rec        = 0;
+            p_op->batch.rec_offset = 0;
+            // Fallthrough to FDS_OP_BATCH_COMMIT.
+
+        case FDS_OP_BATCH_COMMIT:
+            if (p_op->batch.rec < p_op->batch.count)
+            {
+                p_op->batch.words_pending = FDS_HEADER_SIZE_IC;
+
+                ret = batch_record_commit(p_op, p_addr + p_op->batch.rec_offset);
+
+                return (ret == NRF_SUCCESS) ? FDS_OP_EXECUTING : ret;
+            }
+            return FDS_OP_COMPLETED;
+
+        case FDS_OP_BATCH_ROLLBACK:
+            if (p_op->batch.rec < p_op->batch.committed)
+            {
+                p_op->batch.words_pending = FDS_HEADER_SIZE_TL;
+
+                ret = record_header_flag_dirty(p_addr + p_op->batch.rec_offset, p_op->batch.page);
+
+                return (ret == NRF_SUCCESS) ? FDS_OP_EXECUTING : ret;
+            }
+            return FDS_OP_COMPLETED;
+
+        default:
+            return FDS_ERR_INTERNAL;
+    }
+}
+
+
+// Accounts for the flash operation of a batch which has just completed.
+static ret_code_t batch_step_done(uint32_t prev_ret, fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t ret = NRF_SUCCESS;
+
+    switch (p_op->batch.step)
+    {
+        case FDS_OP_BATCH_WRITE:
+            if (prev_ret == NRF_SUCCESS)
+            {
+                p_op->batch.words_written += p_op->batch.words_pending;
+            }
+            else
+            {
+                // On timeout, the chunk might have been written partly. Count the words it
+                // wrote as written: the records they belong to are then skipped and accounted
+                // as dirty, instead of being left as free space that a later write would
+                // overwrite. Words that are still erased stay free, so that no holes will be
+                // left in the flash.
+                p_op->batch.words_written +=
+                    batch_words_programmed(p_addr + p_op->batch.words_written,
+                                           p_op->batch.words_pending);
+            }
+            break;
+
+        case FDS_OP_BATCH_COMMIT:
+            // On timeout, the record might have been committed. Roll it back with the others.
+            p_op->batch.committed++;
+
+            if (prev_ret == NRF_SUCCESS)
+            {
+#if (FDS_INDEX_ENABLED)
+                index_insert(p_op->batch.page, p_addr + p_op->batch.rec_offset);
+#endif
+
+#if (FDS_CRC_CHECK_ON_WRITE)
+                if (!crc_verify_success(m_batch_header.crc16,
+                                        m_batch_header.length_words,
+                                        p_addr + p_op->batch.rec_offset))
+                {
+                    ret = FDS_ERR_CRC_CHECK_FAILED;
+                }
+#endif
+            }
+            // Fallthrough to FDS_OP_BATCH_ROLLBACK.
+
+        case FDS_OP_BATCH_ROLLBACK:
+            p_op->batch.rec_offset += batch_record_size(p_op, p_op->batch.rec);
+            p_op->batch.rec++;
+            break;
+
+        default:
+            break;
+    }
+
+    p_op->batch.words_pending = 0;
+
+    return (prev_ret == NRF_SUCCESS) ? ret : FDS_ERR_OPERATION_TIMEOUT;
+}
+
+
+// Updates the page once a batch has either completed or failed.
+static void batch_offsets_update(fds_page_t * const p_page, fds_op_t const * p_op, bool success)
+{
+    uint16_t words_used = p_op->batch.length_words;
+
+    if (!success)
+    {
+        // Skip over every record whose header has been written, even partially, so that no
+        // holes will be left in the flash. Records which were written but are not valid
+        // (not committed, or rolled back) will be deleted the next time garbage collection
+        // is run. Records that were flagged as dirty have been accounted for already.
+        uint16_t words_invalid;
+
+        words_used = 0;
+        for (uint16_t i = 0; words_used < p_op->batch.words_written; i++)
+        {
+            words_used += batch_record_size(p_op, i);
+        }
+
+        words_invalid = words_used - batch_records_size(p_op, p_op->batch.committed);
+
+        if (words_invalid > 0)
+        {
+            p_page->can_gc       = true;
+            p_page->words_dirty += words_invalid;
+        }
+    }
+
+    p_page->write_offset   += words_used;
+    p_page->words_reserved -= p_op->batch.length_words;
+}
+
+
+// Executes batched write operations.
+static ret_code_t batch_execute(uint32_t prev_ret, fds_op_t * const p_op)
+{
+    ret_code_t         ret    = NRF_SUCCESS;
+    fds_page_t * const p_page = &m_pages[p_op->batch.page];
+    // The page offset is only updated once the whole batch has completed.
+    uint32_t   * const p_addr = (uint32_t*)(p_page->p_addr + p_page->write_offset);
+
+    if (p_op->batch.words_pending != 0)
+    {
+        ret = batch_step_done(prev_ret, p_op, p_addr);
+    }
+
+    while (true)
+    {
+        if (ret != NRF_SUCCESS)
+        {
+            if ((p_op->batch.step == FDS_OP_BATCH_ROLLBACK) || (p_op->batch.committed == 0))
+            {
+                // Nothing (more) can be undone.
+                break;
+            }
+
+            // Some records were committed already. Flag them as dirty, so that they are not
+            // left stored without the rest of the batch.
+            p_op->batch.result     = ret;
+            p_op->batch.step       = FDS_OP_BATCH_ROLLBACK;
+            p_op->batch.rec        = 0;
+            p_op->batch.rec_offset = 0;
+        }
+
+        ret = batch_step(p_op, p_addr);
+
+        if ((ret == FDS_OP_EXECUTING) || (ret == FDS_OP_COMPLETED))
+        {
+            break;
+        }
+    }
+
+    if (ret == FDS_OP_EXECUTING)
+    {
+        return ret;
+    }
+
+    // There won't be another callback for this operation, so update the page offset now.
+    if (p_op->batch.step == FDS_OP_BATCH_ROLLBACK)
+    {
+        // Report the error which caused the rollback.
+        ret = p_op->batch.result;
+    }
+
+    batch_offsets_update(p_page, p_op, (ret == FDS_OP_COMPLETED));
+
+    return ret;
+}
+#endif // FDS_WRITE_BATCH_ENABLED
+
+
+static ret_code_t delete_execute(uint32_t prev_ret, fds_op_t * const p_op)
+{
+    ret_code_t ret;
+
+    if (prev_ret != NRF_SUCCESS)
+    {
+        return FDS_ERR_OPERATION_TIMEOUT;
+    }
+
+    switch (p_op->del.step)
+    {
+        case FDS_OP_DEL_RECORD_FLAG_DIRTY:
             p_op->del.step = FDS_OP_DEL_DONE;
             ret = record_find_and_delete(p_op);
             break;
@@ -1360,12 +2158,14 @@ static ret_code_t delete_execute(uint32_t prev_ret, fds_op_t * const p_op)
 }
 
 
-static ret_code_t gc_execute(uint32_t prev_ret)
+static ret_code_t gc_execute(uint32_t prev_ret, fds_op_t * const p_op)
 {
     ret_code_t ret;
 
     if (prev_ret != NRF_SUCCESS)
     {
+        // Retry the last step next time GC is run.
+        m_gc.resume = true;
         return FDS_ERR_OPERATION_TIMEOUT;
     }
 
@@ -1375,39 +2175,83 @@ static ret_code_t gc_execute(uint32_t prev_ret)
     }
     else
     {
+        bool const page_done = (m_gc.state == GC_TAG_NEW_SWAP);
+
         gc_state_advance();
+
+        if (page_done)
+        {
+            p_op->gc.pages++;
+        }
     }
 
-    switch (m_gc.state)
+    // An incremental step yields to other operations between pages, once it has collected
+    // at least one page and used up its flash operations budget.
+    if (   (p_op->gc.incremental)
+        && (m_gc.state == GC_NEXT_PAGE)
+        && (p_op->gc.pages > 0)
+        && (p_op->gc.flash_ops >= p_op->gc.max_flash_ops))
     {
-        case GC_NEXT_PAGE:
-            ret = gc_next_page();
-            break;
+        ret = FDS_OP_COMPLETED;
+    }
+    else
+    {
+        switch (m_gc.state)
+        {
+            case GC_NEXT_PAGE:
+                ret = gc_next_page();
+                break;
 
-        case GC_FIND_NEXT_RECORD:
-            ret = gc_record_find_next();
-            break;
+            case GC_FIND_NEXT_RECORD:
+                ret = gc_record_find_next();
+                break;
 
-        case GC_COPY_RECORD:
-            ret = gc_record_copy();
-            break;
+            case GC_COPY_RECORD:
+                ret = gc_record_copy();
+                break;
 
-        case GC_ERASE_PAGE:
-            ret = gc_page_erase();
-            break;
+            case GC_ERASE_PAGE:
+                ret = gc_page_erase();
+                break;
 
-        case GC_PROMOTE_SWAP:
-            ret = gc_swap_promote();
-            break;
+            case GC_PROMOTE_SWAP:
+                ret = gc_swap_promote();
+                break;
 
-        case GC_TAG_NEW_SWAP:
-            ret = gc_tag_new_swap();
-            break;
+            case GC_TAG_NEW_SWAP:
+                ret = gc_tag_new_swap();
+                break;
 
-        default:
-            // Should not happen.
-            ret = FDS_ERR_INTERNAL;
-            break;
+            default:
+                // Should not happen.
+                ret = FDS_ERR_INTERNAL;
+                break;
+        }
+    }
+
+    if (ret == FDS_OP_EXECUTING)
+    {
+        p_op->gc.flash_ops++;
+
+        // Other operations are waiting for this flash operation to complete.
+        if (m_queued_op_cnt > 1)
+        {
+            p_op->gc.stall_ops++;
+            m_gc.stall_ops++;
+        }
+    }
+    else
+    {
+        if (p_op->gc.stall_ops > m_gc.stall_ops_max)
+        {
+            m_gc.stall_ops_max = p_op->gc.stall_ops;
+        }
+
+        if (m_gc.state != GC_BEGIN)
+        {
+            // GC has paused or failed. Pick up where it left off next time GC is run.
+            m_gc.resume = true;
+        }
     }
 
     // Either FDS_OP_EXECUTING, FDS_OP_COMPLETED, FDS_ERR_BUSY or FDS_ERR_INTERNAL.
@@ -1415,6 +2259,87 @@ static ret_code_t gc_execute(uint32_t prev_ret)
 }
 
 
+#if (FDS_GC_AUTO_ENABLED)
+// Get the number of words taken up by deleted records on all data pages.
+static uint32_t gc_auto_words_dirty(void)
+{
+    uint32_t words_dirty = 0;
+
+    for (uint16_t i = 0; i < FDS_DATA_PAGES; i++)
+    {
+        words_dirty += m_pages[i].words_dirty;
+    }
+
+    return words_dirty;
+}
+
+
+// Queue an incremental GC step if enough space is taken up by deleted records.
+// Called from queue_process() after an operation has completed.
+static void gc_auto_queue(fds_op_t const * const p_op, ret_code_t result)
+{
+    uint32_t              words_dirty;
+    fds_op_t            * p_gc_op;
+    nrf_atfifo_item_put_t iput_ctx;
+
+    if (p_op->op_code == FDS_OP_GC)
+    {
+        if (p_op->gc.is_auto)
+        {
+            m_gc.auto_queued = false;
+        }
+
+        // Continue a run that paused successfully. Once a run has finished or failed, back off:
+        // pages that could not be collected (because they have open records) keep their dirty
+        // words, and GC would otherwise run again after every operation. The next run starts
+        // when more words become dirty or when a record is closed.
+        if ((result != FDS_OP_COMPLETED) || (m_gc.state == GC_BEGIN))
+        {
+            m_gc.auto_backoff       = true;
+            m_gc.auto_backoff_words = gc_auto_words_dirty();
+            return;
+        }
+    }
+
+    if (m_gc.auto_queued)
+    {
+        return;
+    }
+
+    words_dirty = gc_auto_words_dirty();
+
+    if (words_dirty < FDS_GC_AUTO_THRESHOLD_WORDS)
+    {
+        return;
+    }
+
+    if (m_gc.auto_backoff && (words_dirty <= m_gc.auto_backoff_words))
+    {
+        return;
+    }
+
+    p_gc_op = queue_buf_get(&iput_ctx);
+    if (p_gc_op == NULL)
+    {
+        // The queue is full. Try again once the next operation completes.
+        return;
+    }
+
+    p_gc_op->op_code          = FDS_OP_GC;
+    p_gc_op->gc.incremental   = true;
+    p_gc_op->gc.max_flash_ops = FDS_GC_AUTO_STEP_FLASH_OPS;
+    p_gc_op->gc.is_auto       = true;
+
+    queue_buf_store(&iput_ctx);
+    m_gc.auto_queued  = true;
+    m_gc.auto_backoff = false;
+
+    // The queue is being processed, so there is no need to call queue_start().
+    (void) nrf_atomic_u32_add(&m_queued_op_cnt, 1);
+}
+#endif
+
+
 static void queue_process(ret_code_t result)
 {
     static fds_op_t              * m_p_cur_op;  // Current fds operation.
@@ -1426,6 +2351,9 @@ static void queue_process(ret_code_t result)
         {
             // Load the next from the queue if no operation is being executed.
             m_p_cur_op = queue_load(&m_iget_ctx);
+#if (FDS_TELEMETRY_ENABLED)
+            m_telemetry.op_started = telemetry_timestamp();
+#endif
         }
 
         /* We can reach here in three ways:
@@ -1454,9 +2382,15 @@ static void queue_process(ret_code_t result)
                 break;
 
             case FDS_OP_GC:
-                result = gc_execute(result);
+                result = gc_execute(result, m_p_cur_op);
                 break;
 
+#if (FDS_WRITE_BATCH_ENABLED)
+            case FDS_OP_WRITE_BATCH:
+                result = batch_execute(result, m_p_cur_op);
+                break;
+#endif
+
             default:
                 result = FDS_ERR_INTERNAL;
                 break;
@@ -1468,6 +2402,14 @@ static void queue_process(ret_code_t result)
             break;
         }
 
+#if (FDS_INDEX_ENABLED)
+        if (result == FDS_ERR_OPERATION_TIMEOUT)
+        {
+            // The state of the record being written or deleted is unknown.
+            m_index.valid = false;
+        }
+#endif
+
         // The operation has completed (either successfully or with an error).
         // - send an event to the user
         // - free the operation buffer
@@ -1484,8 +2426,15 @@ static void queue_process(ret_code_t result)
         };
 
         event_prepare(m_p_cur_op, &evt);
+#if (FDS_TELEMETRY_ENABLED)
+        telemetry_op_completed(m_p_cur_op, &evt);
+#endif
         event_send(&evt);
 
+#if (FDS_GC_AUTO_ENABLED)
+        gc_auto_queue(m_p_cur_op, result);
+#endif
+
         // Zero the pointer to the current operation so that this function
         // will fetch a new one from the queue next time it is run.
         m_p_cur_op = NULL;
@@ -1517,6 +2466,13 @@ static void queue_start(void)
 
 static void fs_event_handler(nrf_fstorage_evt_t * p_evt)
 {
+#if (FDS_TELEMETRY_ENABLED)
+    if ((p_evt->id == NRF_FSTORAGE_EVT_ERASE_RESULT) && (p_evt->result == NRF_SUCCESS))
+    {
+        telemetry_page_erased(p_evt->addr);
+    }
+#endif
+
     queue_process(p_evt->result);
 }
 
@@ -1603,14 +2559,8 @@ static ret_code_t write_enqueue(fds_record_desc_t         * const p_desc,
     }
 
 #if (FDS_CRC_CHECK_ON_READ)
-    // First, compute the CRC for the first 6 bytes of the header which contain the
-    // record key, length and file ID, then, compute the CRC of the record ID (4 bytes).
-    crc = crc16_compute((uint8_t*)&p_op->write.header,           6, NULL);
-    crc = crc16_compute((uint8_t*)&p_op->write.header.record_id, 4, &crc);
-
-    // Compute the CRC for the record data.
-    crc = crc16_compute((uint8_t*)p_record->data.p_data,
-                        p_record->data.length_words * sizeof(uint32_t), &crc);
+    // The data is word-aligned, checked above.
+    crc = record_crc(&p_op->write.header, p_record->data.p_data);
 #endif
 
     p_op->write.header.crc16 = crc;
@@ -1748,6 +2698,9 @@ ret_code_t fds_init(void)
         case ALREADY_INSTALLED:
         {
             // No initialization is necessary. Notify the application immediately.
+#if (FDS_INDEX_ENABLED)
+            index_rebuild();
+#endif
             m_flags.initialized  = true;
             m_flags.initializing = false;
             event_send(&evt_success);
@@ -1864,6 +2817,11 @@ ret_code_t fds_record_close(fds_record_desc_t * const p_desc)
             m_pages[page].records_open--;
             p_desc->record_is_open = false;
 
+#if (FDS_GC_AUTO_ENABLED)
+            // The page might be collectable now.
+            m_gc.auto_backoff = false;
+#endif
+
             ret = NRF_SUCCESS;
         }
         else
@@ -1987,6 +2945,107 @@ ret_code_t fds_record_update(fds_record_desc_t       * const p_desc,
 }
 
 
+#if (FDS_WRITE_BATCH_ENABLED)
+ret_code_t fds_record_write_batch(fds_record_desc_t       * p_descs,
+                                  fds_record_t      const * p_records,
+                                  uint16_t                  count)
+{
+    ret_code_t              ret;
+    uint16_t                page;
+    uint32_t                length_words = 0;
+    uint32_t                last_record_id;
+    fds_op_t              * p_op;
+    nrf_atfifo_item_put_t   iput_ctx;
+
+    if (!m_flags.initialized)
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+
+    if (p_records == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    if (count == 0)
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if ((p_records[i].file_id == FDS_FILE_ID_INVALID) ||
+            (p_records[i].key     == FDS_RECORD_KEY_DIRTY))
+        {
+            return FDS_ERR_INVALID_ARG;
+        }
+
+        if (!is_word_aligned(p_records[i].data.p_data))
+        {
+            return FDS_ERR_UNALIGNED_ADDR;
+        }
+
+        length_words += FDS_HEADER_SIZE + p_records[i].data.length_words;
+    }
+
+    // All records must fit on the same page.
+    if (length_words > FDS_PAGE_SIZE - FDS_PAGE_TAG_SIZE)
+    {
+        return FDS_ERR_RECORD_TOO_LARGE;
+    }
+
+    // Find a page where to write data.
+    // NOTE: write_space_reserve() adds the size of one record header.
+    ret = write_space_reserve((uint16_t)(length_words - FDS_HEADER_SIZE), &page);
+    if (ret != NRF_SUCCESS)
+    {
+        return ret;
+    }
+
+    // Get a buffer on the queue of operations.
+    p_op = queue_buf_get(&iput_ctx);
+    if (p_op == NULL)
+    {
+        CRITICAL_SECTION_ENTER();
+        write_space_free((uint16_t)(length_words - FDS_HEADER_SIZE), page);
+        CRITICAL_SECTION_EXIT();
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+    // The records get consecutive IDs.
+    last_record_id = nrf_atomic_u32_add(&m_latest_rec_id, count);
+
+    // Initialize the operation.
+    p_op->op_code               = FDS_OP_WRITE_BATCH;
+    p_op->batch.step            = FDS_OP_BATCH_WRITE;
+    p_op->batch.p_records       = p_records;
+    p_op->batch.first_record_id = last_record_id - count + 1;
+    p_op->batch.count           = count;
+    p_op->batch.page            = page;
+    p_op->batch.length_words    = (uint16_t)length_words;
+
+    queue_buf_store(&iput_ctx);
+
+    // Initialize the record descriptors, if provided.
+    if (p_descs != NULL)
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            p_descs[i].p_record       = NULL;
+            p_descs[i].record_id      = p_op->batch.first_record_id + i;
+            p_descs[i].record_is_open = false;
+            p_descs[i].gc_run_count   = m_gc.run_count;
+        }
+    }
+
+    // Start processing the queue, if necessary.
+    queue_start();
+
+    return NRF_SUCCESS;
+}
+#endif
+
+
 ret_code_t fds_record_delete(fds_record_desc_t * const p_desc)
 {
     fds_op_t * p_op;
@@ -2051,7 +3110,8 @@ ret_code_t fds_file_delete(uint16_t file_id)
 }
 
 
-ret_code_t fds_gc(void)
+// Enqueues garbage collection operations.
+static ret_code_t gc_enqueue(bool incremental, uint16_t max_flash_ops)
 {
     fds_op_t * p_op;
     nrf_atfifo_item_put_t iput_ctx;
@@ -2067,22 +3127,31 @@ ret_code_t fds_gc(void)
         return FDS_ERR_NO_SPACE_IN_QUEUES;
     }
 
-    p_op->op_code = FDS_OP_GC;
+    p_op->op_code          = FDS_OP_GC;
+    p_op->gc.incremental   = incremental;
+    p_op->gc.max_flash_ops = max_flash_ops;
 
     queue_buf_store(&iput_ctx);
 
-    if (m_gc.state != GC_BEGIN)
-    {
-        // Resume GC by retrying the last step.
-        m_gc.resume = true;
-    }
-
+    // If GC was interrupted, gc_execute() has flagged it to be resumed.
     queue_start();
 
     return NRF_SUCCESS;
 }
 
 
+ret_code_t fds_gc(void)
+{
+    return gc_enqueue(false, 0);
+}
+
+
+ret_code_t fds_gc_step(uint16_t max_flash_ops)
+{
+    return gc_enqueue(true, max_flash_ops);
+}
+
+
 ret_code_t fds_record_iterate(fds_record_desc_t * const p_desc,
                               fds_find_token_t  * const p_token)
 {
@@ -2189,9 +3258,236 @@ ret_code_t fds_stat(fds_stat_t * const p_stat)
                      &p_stat->dirty_records,
                      &p_stat->freeable_words,
                      &p_stat->corruption);
+
+        if ((m_gc.state != GC_BEGIN) && (m_gc.do_gc_page[page]) && (m_pages[page].can_gc))
+        {
+            p_stat->gc_pages_pending++;
+        }
+    }
+
+    p_stat->gc_in_progress   = (m_gc.state != GC_BEGIN);
+    p_stat->gc_run_count     = m_gc.run_count;
+    p_stat->gc_stall_ops_max = m_gc.stall_ops_max;
+    p_stat->gc_stall_ops     = m_gc.stall_ops;
+
+    return NRF_SUCCESS;
+}
+
+
+#if (FDS_TELEMETRY_ENABLED)
+void fds_telemetry_init(fds_timestamp_func_t timestamp_func, uint32_t counter_mask)
+{
+    CRITICAL_SECTION_ENTER();
+    m_telemetry.timestamp_func = timestamp_func;
+    m_telemetry.counter_mask   = counter_mask;
+    CRITICAL_SECTION_EXIT();
+}
+
+
+ret_code_t fds_page_erase_count_get(uint16_t page, uint32_t * const p_count)
+{
+    if (p_count == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    if (page >= FDS_VIRTUAL_PAGES)
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    *p_count = m_telemetry.page_erase_count[page];
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_op_latency_get(fds_evt_id_t op, fds_op_latency_t * const p_latency)
+{
+    if (p_latency == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    if ((uint32_t)op >= ARRAY_SIZE(m_telemetry.latency))
+    {
+        return FDS_ERR_INVALID_ARG;
     }
 
+    CRITICAL_SECTION_ENTER();
+    *p_latency = m_telemetry.latency[op];
+    CRITICAL_SECTION_EXIT();
+
     return NRF_SUCCESS;
 }
 
+
+void fds_op_latency_reset(void)
+{
+    CRITICAL_SECTION_ENTER();
+    memset(m_telemetry.latency, 0x00, sizeof(m_telemetry.latency));
+    CRITICAL_SECTION_EXIT();
+}
+#endif // FDS_TELEMETRY_ENABLED
+
+
+#if FDS_CLI_CMDS && NRF_CLI_ENABLED
+#include "nrf_cli.h"
+
+static void fds_cli_status(nrf_cli_t const * p_cli, size_t argc, char **argv)
+{
+    UNUSED_PARAMETER(argv);
+
+    fds_stat_t stat;
+
+    if (nrf_cli_help_requested(p_cli))
+    {
+        nrf_cli_help_print(p_cli, NULL, 0);
+        return;
+    }
+
+    if (argc > 1)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "Bad argument count");
+        return;
+    }
+
+    if (fds_stat(&stat) != NRF_SUCCESS)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "FDS is not initialized\r\n");
+        return;
+    }
+
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL,
+                    "Pages:\t\t%u available, %u pending garbage collection\r\n"
+                    "Records:\t%u valid, %u dirty, %u open\r\n"
+                    "Words:\t\t%u used, %u reserved, %u freeable, %u largest free\r\n"
+                    "GC:\t\t%u runs, %s, stalls %u ops (%u max)\r\n"
+                    "Corruption:\t%s\r\n",
+                    stat.pages_available, stat.gc_pages_pending,
+                    stat.valid_records, stat.dirty_records, stat.open_records,
+                    stat.words_used, stat.words_reserved, stat.freeable_words,
+                    stat.largest_contig,
+                    stat.gc_run_count, stat.gc_in_progress ? "in progress" : "idle",
+                    stat.gc_stall_ops, stat.gc_stall_ops_max,
+                    stat.corruption ? "yes" : "no");
+}
+
+
+#if (FDS_TELEMETRY_ENABLED)
+static void fds_cli_wear(nrf_cli_t const * p_cli, size_t argc, char **argv)
+{
+    UNUSED_PARAMETER(argv);
+
+    if (nrf_cli_help_requested(p_cli))
+    {
+        nrf_cli_help_print(p_cli, NULL, 0);
+        return;
+    }
+
+    if (argc > 1)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "Bad argument count");
+        return;
+    }
+
+    for (uint16_t page = 0; page < FDS_VIRTUAL_PAGES; page++)
+    {
+        uint32_t const addr = m_fs.start_addr + (page * FDS_PAGE_SIZE * sizeof(uint32_t));
+
+        nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL,
+                        "Page %u (0x%08x):\t%u erases%s\r\n",
+                        page, addr, m_telemetry.page_erase_count[page],
+                        (addr == (uint32_t)m_swap_page.p_addr) ? " (swap)" : "");
+    }
+}
+
+
+static void fds_cli_hist_print(nrf_cli_t const * p_cli, char const * p_name, uint32_t const * p_hist)
+{
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\t- %s:\t", p_name);
+
+    for (uint8_t i = 0; i < FDS_LATENCY_HIST_BUCKETS; i++)
+    {
+        if (p_hist[i] == 0)
+        {
+            continue;
+        }
+
+        if (i < FDS_LATENCY_HIST_BUCKETS - 1)
+        {
+            nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, " <%u:%u", (1u << i), p_hist[i]);
+        }
+        else
+        {
+            nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, " more:%u", p_hist[i]);
+        }
+    }
+
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\r\n");
+}
+
+
+static void fds_cli_latency(nrf_cli_t const * p_cli, size_t argc, char **argv)
+{
+    UNUSED_PARAMETER(argv);
+
+    // Indexed by event ID.
+    static char const * const op_names[] =
+    {
+        "init", "write", "update", "delete record", "delete file", "gc", "write batch"
+    };
+    STATIC_ASSERT(ARRAY_SIZE(op_names) == ARRAY_SIZE(m_telemetry.latency));
+
+    if (nrf_cli_help_requested(p_cli))
+    {
+        nrf_cli_help_print(p_cli, NULL, 0);
+        return;
+    }
+
+    if (argc > 1)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "Bad argument count");
+        return;
+    }
+
+    for (uint8_t op = 0; op < ARRAY_SIZE(op_names); op++)
+    {
+        fds_op_latency_t latency;
+
+        (void) fds_op_latency_get((fds_evt_id_t)op, &latency);
+
+        if (latency.count == 0)
+        {
+            continue;
+        }
+
+        nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL,
+                        "%s\r\n\t- Count:\t%u (%u errors)\r\n"
+                        "\t- Wait max:\t%u ticks\r\n"
+                        "\t- Exec max:\t%u ticks\r\n",
+                        op_names[op], latency.count, latency.errors,
+                        latency.wait_max, latency.exec_max);
+
+        fds_cli_hist_print(p_cli, "Wait", latency.wait_hist);
+        fds_cli_hist_print(p_cli, "Exec", latency.exec_hist);
+    }
+}
+#endif // FDS_TELEMETRY_ENABLED
+
+
+// Register "fds" command and its subcommands in CLI.
+NRF_CLI_CREATE_STATIC_SUBCMD_SET(fds_commands)
+{
+    NRF_CLI_CMD(status,  NULL, "Print file system statistics.", fds_cli_status),
+#if (FDS_TELEMETRY_ENABLED)
+    NRF_CLI_CMD(wear,    NULL, "Print the number of erases of each page.", fds_cli_wear),
+    NRF_CLI_CMD(latency, NULL, "Print the latency of each type of operation.", fds_cli_latency),
+#endif
+    NRF_CLI_SUBCMD_SET_END
+};
+
+NRF_CLI_CMD_REGISTER(fds, &fds_commands, "Commands for FDS management", fds_cli_status);
+#endif // FDS_CLI_CMDS
+
 #endif //NRF_MODULE_ENABLED(FDS)
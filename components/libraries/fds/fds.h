@@ -191,7 +191,8 @@ typedef enum
     FDS_EVT_UPDATE,     //!< Event for @ref fds_record_update.
     FDS_EVT_DEL_RECORD, //!< Event for @ref fds_record_delete.
     FDS_EVT_DEL_FILE,   //!< Event for @ref fds_file_delete.
-    FDS_EVT_GC          //!< Event for @ref fds_gc.
+    FDS_EVT_GC,         //!< Event for @ref fds_gc and @ref fds_gc_step.
+    FDS_EVT_WRITE_BATCH //!< Event for @ref fds_record_write_batch.
 } fds_evt_id_t;
 
 
@@ -217,6 +218,20 @@ typedef struct
             uint16_t file_id;
             uint16_t record_key;
         } del; //!< Information for @ref FDS_EVT_DEL_RECORD and @ref FDS_EVT_DEL_FILE events.
+        struct
+        {
+            /**@brief Whether garbage collection has finished.
+             *
+             * False if an incremental step started by @ref fds_gc_step paused while there are still
+             * pages left to collect.
+             */
+            bool is_complete;
+        } gc; //!< Information for @ref FDS_EVT_GC events.
+        struct
+        {
+            uint32_t first_record_id;   //!< The ID of the first record. The others follow in order.
+            uint16_t count;             //!< The number of records in the batch.
+        } batch; //!< Information for @ref FDS_EVT_WRITE_BATCH events.
     };
 } fds_evt_t;
 
@@ -257,9 +272,69 @@ typedef struct
      * @note: This flag is unrelated to CRC failures.
      */
     bool corruption;
+
+    /**@brief Garbage collection has started and not yet finished.
+     *
+     * This is the case while @ref fds_gc runs, and between incremental steps run by @ref fds_gc_step.
+     */
+    bool gc_in_progress;
+
+    /**@brief The number of pages that the current garbage collection run has yet to collect. */
+    uint16_t gc_pages_pending;
+
+    /**@brief The number of garbage collection runs started since initialization. */
+    uint16_t gc_run_count;
+
+    /**@brief The largest number of flash operations a single garbage collection operation issued
+     *        while other operations were waiting in the queue.
+     *
+     * Multiply by the duration of a flash operation to estimate the worst-case write stall.
+     */
+    uint16_t gc_stall_ops_max;
+
+    /**@brief The total number of garbage collection flash operations issued while other operations
+     *        were waiting in the queue.
+     */
+    uint32_t gc_stall_ops;
 } fds_stat_t;
 
 
+/**@brief   Number of buckets in the latency histograms of @ref fds_op_latency_t.
+ *
+ * Bucket 0 counts latencies of zero ticks, and bucket n counts latencies from 2^(n-1) to
+ * 2^n - 1 ticks. The last bucket also counts all longer latencies.
+ */
+#define FDS_LATENCY_HIST_BUCKETS    (16)
+
+
+/**@brief   Function that returns the current time, in ticks of a free-running counter. */
+typedef uint32_t (*fds_timestamp_func_t)(void);
+
+
+/**@brief   Latency statistics for one type of operation. All times are in timestamp ticks.
+ *
+ * See @ref fds_op_latency_get.
+ */
+typedef struct
+{
+    uint32_t count;     //!< The number of operations that have completed.
+    uint32_t errors;    //!< The number of operations that have completed with an error.
+    uint32_t wait_max;  //!< The longest time an operation waited in the queue.
+    uint32_t exec_max;  //!< The longest time an operation took to execute.
+
+    /**@brief Histogram of the time operations waited in the queue before they started executing.
+     *
+     * This is mostly time spent behind other operations, for example garbage collection.
+     */
+    uint32_t wait_hist[FDS_LATENCY_HIST_BUCKETS];
+
+    /**@brief Histogram of the time operations took to execute, from the first flash operation
+     *        to the event.
+     */
+    uint32_t exec_hist[FDS_LATENCY_HIST_BUCKETS];
+} fds_op_latency_t;
+
+
 /**@brief   FDS event handler function prototype.
  *
  * @param   p_evt   The event.
@@ -456,6 +531,47 @@ ret_code_t fds_record_delete(fds_record_desc_t * p_desc);
 ret_code_t fds_file_delete(uint16_t file_id);
 
 
+/**@brief   Function for writing several records as one transaction.
+ *
+ * The records are written next to each other on the same page, as one queued operation. The
+ * headers and data of all records are copied through a staging buffer of
+ * @ref FDS_WRITE_BATCH_BUFFER_WORDS words, so that contiguous words are written with as few flash
+ * operations as possible. The records are then committed one by one by writing the last word of
+ * their headers. If any step fails, records that were already committed are deleted again.
+ *
+ * @note The batch is not atomic. A power loss while the records are being committed, or a
+ *       failure while committed records are being deleted, can leave the first records of the
+ *       batch stored. After a failed batch, check which of its records exist.
+ *
+ * @note This function is only available if FDS_WRITE_BATCH_ENABLED is set in sdk_config.h.
+ *
+ * This function is asynchronous. Completion is reported through the @ref FDS_EVT_WRITE_BATCH
+ * event that is sent to the registered event handler function. The records get consecutive
+ * record IDs.
+ *
+ * @warning The array @p p_records and the data of each record must remain in memory until the
+ *          @ref FDS_EVT_WRITE_BATCH event is received.
+ *
+ * @param[out]  p_descs     Array of @p count descriptors, one for each record that is written.
+ *                          Pass NULL if you do not need the descriptors.
+ * @param[in]   p_records   Array of @p count records to write. The data of each record is
+ *                          required to be word aligned.
+ * @param[in]   count       The number of records.
+ *
+ * @retval  NRF_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NULL_ARG            If @p p_records is NULL.
+ * @retval  FDS_ERR_INVALID_ARG         If @p count is zero, or a file ID or record key is invalid.
+ * @retval  FDS_ERR_UNALIGNED_ADDR      If the data of a record is not aligned to a 4 byte boundary.
+ * @retval  FDS_ERR_RECORD_TOO_LARGE    If the records together do not fit in a virtual page.
+ * @retval  FDS_ERR_NO_SPACE_IN_FLASH   If there is not enough free space on any page.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
+ */
+ret_code_t fds_record_write_batch(fds_record_desc_t       * p_descs,
+                                  fds_record_t      const * p_records,
+                                  uint16_t                  count);
+
+
 /**@brief   Function for updating a record.
  *
  * Updating a record first writes a new record (@p p_record) to flash and then deletes the
@@ -639,6 +755,27 @@ ret_code_t fds_record_close(fds_record_desc_t * p_desc);
 ret_code_t fds_gc(void);
 
 
+/**@brief   Function for running one incremental garbage collection step.
+ *
+ * Unlike @ref fds_gc, which collects all pages in one queued operation, this function queues an
+ * operation that collects one page and then yields to other queued operations. If
+ * @p max_flash_ops is not zero, the step carries on with further pages as long as it has issued
+ * fewer than @p max_flash_ops flash operations. The budget is checked between pages, since a page
+ * must be collected in its entirety before the queue can safely process other operations.
+ *
+ * Successive calls continue the same garbage collection run. The @ref FDS_EVT_GC event reports
+ * whether the run has finished through its @c gc.is_complete field.
+ *
+ * @param[in]   max_flash_ops   Flash operations budget for this step, or zero to collect exactly
+ *                              one page.
+ *
+ * @retval  NRF_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
+ */
+ret_code_t fds_gc_step(uint16_t max_flash_ops);
+
+
 /**@brief   Function for obtaining a descriptor from a record ID.
  *
  * This function can be used to reconstruct a descriptor from a record ID, like the one that is
@@ -693,6 +830,66 @@ ret_code_t fds_record_id_from_desc(fds_record_desc_t const * p_desc,
 ret_code_t fds_stat(fds_stat_t * p_stat);
 
 
+/**@brief   Function for setting the time source used to measure the latency of operations.
+ *
+ * Until this function is called, operations are counted, but all latencies are zero.
+ * For example, use @ref app_timer_cnt_get as @p timestamp_func and 0x00FFFFFF as
+ * @p counter_mask, since the RTC counter is 24 bits wide.
+ *
+ * @note This function is only available if FDS_TELEMETRY_ENABLED is set in sdk_config.h.
+ *
+ * @param[in]   timestamp_func  Function that returns the value of a free-running counter.
+ * @param[in]   counter_mask    Mask of the bits that the counter uses. It is used to handle the
+ *                              counter wrapping around.
+ */
+void fds_telemetry_init(fds_timestamp_func_t timestamp_func, uint32_t counter_mask);
+
+
+/**@brief   Function for retrieving the number of times a virtual page has been erased.
+ *
+ * Pages are numbered in the order in which they are laid out in flash, from 0 to
+ * FDS_VIRTUAL_PAGES - 1. Since garbage collection moves the swap page around, the erase count
+ * follows the physical location and not the role of a page. Counters are kept in RAM and
+ * start from zero when the device is reset.
+ *
+ * @note This function is only available if FDS_TELEMETRY_ENABLED is set in sdk_config.h.
+ *
+ * @param[in]   page        The virtual page.
+ * @param[out]  p_count     The number of erase operations on the page.
+ *
+ * @retval  NRF_SUCCESS             If the count was returned successfully.
+ * @retval  FDS_ERR_NULL_ARG        If @p p_count is NULL.
+ * @retval  FDS_ERR_INVALID_ARG     If @p page is not a valid page.
+ */
+ret_code_t fds_page_erase_count_get(uint16_t page, uint32_t * p_count);
+
+
+/**@brief   Function for retrieving the latency statistics of a type of operation.
+ *
+ * Operations are identified by the event which reports their completion, for example
+ * @ref FDS_EVT_WRITE for @ref fds_record_write.
+ *
+ * @note This function is only available if FDS_TELEMETRY_ENABLED is set in sdk_config.h.
+ *
+ * @param[in]   op          The event of the operation.
+ * @param[out]  p_latency   The latency statistics.
+ *
+ * @retval  NRF_SUCCESS             If the statistics were returned successfully.
+ * @retval  FDS_ERR_NULL_ARG        If @p p_latency is NULL.
+ * @retval  FDS_ERR_INVALID_ARG     If @p op is not a valid event.
+ */
+ret_code_t fds_op_latency_get(fds_evt_id_t op, fds_op_latency_t * p_latency);
+
+
+/**@brief   Function for clearing the latency statistics of all operations.
+ *
+ * Erase counts are not cleared.
+ *
+ * @note This function is only available if FDS_TELEMETRY_ENABLED is set in sdk_config.h.
+ */
+void fds_op_latency_reset(void);
+
+
 /** @} */
 
 
@@ -109,6 +109,34 @@ extern "C" {
     #error "FDS requires at least two virtual pages."
 #endif
 
+#ifndef FDS_INDEX_ENABLED
+    #define FDS_INDEX_ENABLED   0
+#endif
+
+#ifndef FDS_GC_AUTO_ENABLED
+    #define FDS_GC_AUTO_ENABLED 0
+#endif
+
+#ifndef FDS_WRITE_BATCH_ENABLED
+    #define FDS_WRITE_BATCH_ENABLED 0
+#endif
+
+#ifndef FDS_TELEMETRY_ENABLED
+    #define FDS_TELEMETRY_ENABLED 0
+#endif
+
+#ifndef FDS_CLI_CMDS
+    #define FDS_CLI_CMDS 0
+#endif
+
+#if (FDS_WRITE_BATCH_ENABLED) && (FDS_WRITE_BATCH_BUFFER_WORDS < FDS_HEADER_SIZE)
+    #error "FDS_WRITE_BATCH_BUFFER_WORDS must be at least the size of a record header."
+#endif
+
+#if (FDS_INDEX_ENABLED) && ((FDS_INDEX_SIZE < 1) || (FDS_INDEX_SIZE > 0xFFFF))
+    #error "FDS_INDEX_SIZE must be between 1 and 65535."
+#endif
+
 
 // Page types.
 typedef enum
@@ -135,6 +163,7 @@ typedef struct
     uint16_t                write_offset;   // The page write offset, in 4-byte words.
     uint16_t                words_reserved; // The amount of words reserved.
     uint32_t volatile       records_open;   // The number of open records.
+    uint16_t                words_dirty;    // The amount of words taken up by deleted records.
     bool                    can_gc;         // Indicates that there are some records that have been deleted.
 } fds_page_t;
 
@@ -155,7 +184,8 @@ typedef enum
     FDS_OP_UPDATE,      // Update a record.
     FDS_OP_DEL_RECORD,  // Delete a record.
     FDS_OP_DEL_FILE,    // Delete a file.
-    FDS_OP_GC           // Run garbage collection.
+    FDS_OP_GC,          // Run garbage collection.
+    FDS_OP_WRITE_BATCH, // Write several records as one transaction.
 } fds_op_code_t;
 
 
@@ -180,6 +210,14 @@ typedef enum
 } fds_write_step_t;
 
 
+typedef enum
+{
+    FDS_OP_BATCH_WRITE,             // Write the headers (except file ID and CRC) and the data.
+    FDS_OP_BATCH_COMMIT,            // Write the file ID and CRC of each record.
+    FDS_OP_BATCH_ROLLBACK,          // Flag records that were already committed as dirty.
+} fds_batch_step_t;
+
+
 typedef enum
 {
     FDS_OP_DEL_RECORD_FLAG_DIRTY,   // Flag a record as dirty.
@@ -200,6 +238,9 @@ typedef enum
 typedef struct
 {
     fds_op_code_t op_code;                      // The opcode for the operation.
+#if (FDS_TELEMETRY_ENABLED)
+    uint32_t      timestamp;                    // When the operation was queued.
+#endif
     union
     {
         struct
@@ -221,6 +262,30 @@ typedef struct
             uint16_t          record_key;
             uint32_t          record_to_delete;
         } del;
+        struct
+        {
+            fds_record_t const * p_records;     // The records to write.
+            uint32_t          first_record_id;  // The ID of the first record. The others follow.
+            uint16_t          count;            // The number of records.
+            uint16_t          page;             // The page the flash space was reserved on.
+            uint16_t          length_words;     // The size of all records, including headers.
+            uint16_t          words_written;    // Words of the batch written to flash so far.
+            uint16_t          words_pending;    // Words of the flash write in progress.
+            uint16_t          rec;              // The record being written, committed or rolled back.
+            uint16_t          rec_offset;       // The offset of that record from the batch start.
+            uint16_t          committed;        // The number of records committed.
+            fds_batch_step_t  step;             // The current step the operation is at.
+            ret_code_t        result;           // The error that triggered a rollback.
+        } batch;
+        struct
+        {
+            bool              incremental;      // Whether to pause after a page has been collected.
+            uint16_t          max_flash_ops;    // Flash operations budget for an incremental step.
+            uint16_t          flash_ops;        // Flash operations issued by this operation so far.
+            uint16_t          pages;            // Pages collected by this operation so far.
+            uint16_t          stall_ops;        // Flash operations issued while other operations waited.
+            bool              is_auto;          // Whether the operation was queued automatically.
+        } gc;
     };
 } fds_op_t;
 
@@ -305,9 +370,29 @@ typedef struct
     uint16_t         run_count;                  // Total number of times GC was run.
     bool             do_gc_page[FDS_DATA_PAGES]; // Controls which pages to garbage collect.
     bool             resume;                     // Whether or not GC should be resumed.
+    bool             auto_queued;                // Whether an automatic GC step is in the queue.
+    bool             auto_backoff;               // Whether automatic GC waits for more deleted data or a closed record.
+    uint32_t         auto_backoff_words;         // Dirty words left when the last GC run finished.
+    uint32_t         stall_ops;                  // GC flash operations issued while other operations waited.
+    uint16_t         stall_ops_max;              // The largest stall_ops value of a single GC operation.
 } fds_gc_data_t;
 
 
+#if (FDS_INDEX_ENABLED)
+// An entry in the RAM index of valid records.
+// The location of a record is stored as a page index and an offset within that page, so that
+// entries stay correct when garbage collection swaps the flash address of a page.
+typedef struct
+{
+    uint32_t record_id;     // The record ID.
+    uint16_t file_id;       // The file ID of the record.
+    uint16_t record_key;    // The record key.
+    uint16_t page;          // The index of the page (in m_pages) on which the record is stored.
+    uint16_t offset;        // The offset of the record header within the page, in 4-byte words.
+} fds_index_entry_t;
+#endif
+
+
 // Macros to enable and disable application interrupts.
 #if defined (FDS_THREADS)
 
@@ -59,6 +59,14 @@
 #error NRF_FSTORAGE_SD_MAX_WRITE_SIZE must be a multiple of the word size.
 #endif
 
+#ifndef NRF_FSTORAGE_SD_STATS_ENABLED
+#define NRF_FSTORAGE_SD_STATS_ENABLED 0
+#endif
+
+#ifndef NRF_FSTORAGE_SD_CLI_CMDS
+#define NRF_FSTORAGE_SD_CLI_CMDS 0
+#endif
+
 
 /**@brief   fstorage operation codes. */
 typedef enum
@@ -154,6 +162,45 @@ static nrf_fstorage_sd_work_t   m_flags;        /* Internal status. */
 static nrf_fstorage_sd_op_t   * m_p_cur_op;     /* The current operation being executed. */
 static nrf_atfifo_item_get_t    m_iget_ctx;     /* Context for nrf_atfifo_item_get() and nrf_atfifo_item_free(). */
 
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+/* Statistics and the time source used to measure latency. */
+static struct
+{
+    nrf_fstorage_sd_timestamp_func_t timestamp_func;
+    uint32_t                         counter_mask;
+    uint32_t                         attempt_started;   /* When the current attempt was requested. */
+    nrf_fstorage_sd_stats_t          stats;
+} m_stats =
+{
+    .counter_mask = 0xFFFFFFFF,
+};
+
+
+static uint32_t stats_timestamp(void)
+{
+    return (m_stats.timestamp_func != NULL) ? m_stats.timestamp_func() : 0;
+}
+
+
+/* Record how long the SoftDevice took to complete the current attempt. */
+static void stats_attempt_completed(void)
+{
+    uint32_t wait   = (stats_timestamp() - m_stats.attempt_started) & m_stats.counter_mask;
+    uint8_t  bucket = 0;
+
+    m_stats.stats.wait_max = MAX(m_stats.stats.wait_max, wait);
+
+    /* See NRF_FSTORAGE_SD_LATENCY_HIST_BUCKETS. */
+    while ((wait != 0) && (bucket < NRF_FSTORAGE_SD_LATENCY_HIST_BUCKETS - 1))
+    {
+        wait >>= 1;
+        bucket++;
+    }
+
+    m_stats.stats.wait_hist[bucket]++;
+}
+#endif
+
 
 /* Send events to the application. */
 static void event_send(nrf_fstorage_sd_op_t const * p_op, ret_code_t result)
@@ -250,6 +297,10 @@ static void queue_process(void)
 
     m_flags.state = NRF_FSTORAGE_STATE_OP_EXECUTING;
 
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+    m_stats.attempt_started = stats_timestamp();
+#endif
+
     switch (m_p_cur_op->op_code)
     {
         case NRF_FSTORAGE_OP_WRITE:
@@ -269,6 +320,9 @@ static void queue_process(void)
     {
         case NRF_SUCCESS:
         {
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+            m_stats.stats.attempts++;
+#endif
             /* The operation was accepted by the SoftDevice.
              * If the SoftDevice is enabled, wait for a system event. Otherwise,
              * the SoftDevice call is synchronous and will not send an event so we simulate it. */
@@ -280,6 +334,9 @@ static void queue_process(void)
 
         case NRF_ERROR_BUSY:
         {
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+            m_stats.stats.busy++;
+#endif
             /* The SoftDevice is executing a flash operation that was not requested by fstorage.
              * Stop processing the queue until a system event is received. */
             m_flags.state = NRF_FSTORAGE_STATE_OP_PENDING;
@@ -359,13 +416,24 @@ static bool on_operation_failure(nrf_fstorage_sd_op_t const * p_op)
 
     m_flags.retries++;
 
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+    m_stats.stats.retries_max = MAX(m_stats.stats.retries_max, m_flags.retries);
+#endif
+
     if (m_flags.retries > NRF_FSTORAGE_SD_MAX_RETRIES)
     {
         /* Maximum amount of retries reached. Give up. */
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+        m_stats.stats.failures++;
+#endif
         m_flags.retries = 0;
         return true;
     }
 
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+    m_stats.stats.retries++;
+#endif
+
     return false;
 }
 
@@ -536,6 +604,10 @@ void nrf_fstorage_sys_evt_handler(uint32_t sys_evt, void * p_context)
             /* Handle the result of a flash operation initiated by this module. */
             bool operation_finished = false;
 
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+            stats_attempt_completed();
+#endif
+
             switch (sys_evt)
             {
                 case NRF_EVT_FLASH_OPERATION_SUCCESS:
@@ -607,6 +679,102 @@ void nrf_fstorage_sdh_state_handler(nrf_sdh_state_evt_t state, void * p_context)
 }
 
 
+#if NRF_FSTORAGE_SD_STATS_ENABLED
+void nrf_fstorage_sd_stats_init(nrf_fstorage_sd_timestamp_func_t timestamp_func,
+                                uint32_t                         counter_mask)
+{
+    CRITICAL_REGION_ENTER();
+    m_stats.timestamp_func = timestamp_func;
+    m_stats.counter_mask   = counter_mask;
+    CRITICAL_REGION_EXIT();
+}
+
+
+void nrf_fstorage_sd_stats_get(nrf_fstorage_sd_stats_t * p_stats)
+{
+    ASSERT(p_stats != NULL);
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_stats.stats;
+    CRITICAL_REGION_EXIT();
+}
+
+
+void nrf_fstorage_sd_stats_reset(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset(&m_stats.stats, 0x00, sizeof(m_stats.stats));
+    CRITICAL_REGION_EXIT();
+}
+#endif
+
+
+#if NRF_FSTORAGE_SD_STATS_ENABLED && NRF_FSTORAGE_SD_CLI_CMDS && NRF_CLI_ENABLED
+#include "nrf_cli.h"
+
+static void nrf_fstorage_sd_status(nrf_cli_t const * p_cli, size_t argc, char **argv)
+{
+    UNUSED_PARAMETER(argv);
+
+    nrf_fstorage_sd_stats_t stats;
+
+    if (nrf_cli_help_requested(p_cli))
+    {
+        nrf_cli_help_print(p_cli, NULL, 0);
+        return;
+    }
+
+    if (argc > 1)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "Bad argument count");
+        return;
+    }
+
+    nrf_fstorage_sd_stats_get(&stats);
+
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL,
+                    "nrf_fstorage_sd\r\n\t- Attempts:\t%u\r\n"
+                    "\t- Retries:\t%u (%u max, limit %u)\r\n"
+                    "\t- Failures:\t%u\r\n"
+                    "\t- SD busy:\t%u\r\n"
+                    "\t- Wait max:\t%u ticks\r\n"
+                    "\t- Wait:\t",
+                    stats.attempts,
+                    stats.retries, stats.retries_max, NRF_FSTORAGE_SD_MAX_RETRIES,
+                    stats.failures,
+                    stats.busy,
+                    stats.wait_max);
+
+    for (uint8_t i = 0; i < NRF_FSTORAGE_SD_LATENCY_HIST_BUCKETS; i++)
+    {
+        if (stats.wait_hist[i] == 0)
+        {
+            continue;
+        }
+
+        if (i < NRF_FSTORAGE_SD_LATENCY_HIST_BUCKETS - 1)
+        {
+            nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, " <%u:%u", (1u << i), stats.wait_hist[i]);
+        }
+        else
+        {
+            nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, " more:%u", stats.wait_hist[i]);
+        }
+    }
+
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\r\n");
+}
+// Register "fstorage" command and its subcommands in CLI.
+NRF_CLI_CREATE_STATIC_SUBCMD_SET(nrf_fstorage_sd_commands)
+{
+     NRF_CLI_CMD(status, NULL, "Print statistics of flash operations.", nrf_fstorage_sd_status),
+     NRF_CLI_SUBCMD_SET_END
+};
+
+NRF_CLI_CMD_REGISTER(fstorage, &nrf_fstorage_sd_commands, "Commands for fstorage management", nrf_fstorage_sd_status);
+#endif
+
+
 /* Exported API implementation. */
 nrf_fstorage_api_t nrf_fstorage_sd =
 {
@@ -67,6 +67,72 @@ extern "C" {
 extern nrf_fstorage_api_t nrf_fstorage_sd;
 
 
+/**@brief   Number of buckets in the latency histogram of @ref nrf_fstorage_sd_stats_t.
+ *
+ * Bucket 0 counts latencies of zero ticks, and bucket n counts latencies from 2^(n-1) to
+ * 2^n - 1 ticks. The last bucket also counts all longer latencies.
+ */
+#define NRF_FSTORAGE_SD_LATENCY_HIST_BUCKETS    (16)
+
+
+/**@brief   Function that returns the current time, in ticks of a free-running counter. */
+typedef uint32_t (*nrf_fstorage_sd_timestamp_func_t)(void);
+
+
+/**@brief   Statistics of the flash operations requested to the SoftDevice.
+ *
+ * Write operations are split in chunks of at most NRF_FSTORAGE_SD_MAX_WRITE_SIZE bytes, and
+ * erase operations in pages. Each chunk or page is requested to the SoftDevice separately, and
+ * is counted as one attempt.
+ */
+typedef struct
+{
+    uint32_t attempts;      //!< Number of chunks or pages requested to the SoftDevice.
+    uint32_t retries;       //!< Number of attempts that timed out and were retried.
+    uint32_t retries_max;   //!< The largest number of retries needed by a single chunk or page.
+    uint32_t failures;      //!< Number of operations that failed with @ref NRF_ERROR_TIMEOUT.
+    uint32_t busy;          //!< Number of times the SoftDevice was busy with another flash operation.
+    uint32_t wait_max;      //!< The longest time the SoftDevice took to complete an attempt, in ticks.
+
+    /**@brief Histogram of the time the SoftDevice took to complete an attempt, in ticks.
+     *
+     * This is mostly the time spent waiting for a timeslot in which flash can be accessed.
+     */
+    uint32_t wait_hist[NRF_FSTORAGE_SD_LATENCY_HIST_BUCKETS];
+} nrf_fstorage_sd_stats_t;
+
+
+/**@brief   Function for setting the time source used to measure latency.
+ *
+ * Until this function is called, attempts are counted, but all latencies are zero.
+ * For example, use @ref app_timer_cnt_get as @p timestamp_func and 0x00FFFFFF as
+ * @p counter_mask, since the RTC counter is 24 bits wide.
+ *
+ * @note This function is only available if NRF_FSTORAGE_SD_STATS_ENABLED is set in sdk_config.h.
+ *
+ * @param[in]   timestamp_func  Function that returns the value of a free-running counter.
+ * @param[in]   counter_mask    Mask of the bits that the counter uses.
+ */
+void nrf_fstorage_sd_stats_init(nrf_fstorage_sd_timestamp_func_t timestamp_func,
+                                uint32_t                         counter_mask);
+
+
+/**@brief   Function for retrieving the statistics of the SoftDevice implementation.
+ *
+ * @note This function is only available if NRF_FSTORAGE_SD_STATS_ENABLED is set in sdk_config.h.
+ *
+ * @param[out]  p_stats     The statistics.
+ */
+void nrf_fstorage_sd_stats_get(nrf_fstorage_sd_stats_t * p_stats);
+
+
+/**@brief   Function for clearing the statistics of the SoftDevice implementation.
+ *
+ * @note This function is only available if NRF_FSTORAGE_SD_STATS_ENABLED is set in sdk_config.h.
+ */
+void nrf_fstorage_sd_stats_reset(void);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,21 @@
  * @{
  * @ingroup  nrf_log
  * @brief Flash logger backend.
+ *
+ * Each flash page of the area is a sector of a ring buffer. A page starts with a header holding
+ * a sequence number, the timestamp of the first entry and a severity index which is written when
+ * the page is full. When all pages are used, the backend stops writing and the earliest logs are
+ * kept until the area is erased (see @ref nrf_log_backend_flash_erase). If
+ * @ref NRF_LOG_BACKEND_FLASH_OVERWRITE_ENABLED is set, the oldest page is erased and reused
+ * instead. In that case, if only one page is configured, the whole log is lost when the page is
+ * full.
+ *
+ * Entries are compressed: timestamps are stored as deltas, module ID is omitted if it is the same
+ * as in the previous entry, format strings are replaced by indexes into a dictionary of recently
+ * used strings and arguments are stored as variable length integers. Compression context is
+ * reset at the beginning of each page, so pages can be decoded independently. Thanks to that,
+ * reading entries of given severity or newer than given timestamp skips pages which cannot
+ * contain matching entries.
  */
 
 #ifndef NRF_LOG_BACKEND_FLASH_H
@@ -57,6 +72,10 @@
 extern "C" {
 #endif
 
+#ifndef NRF_LOG_BACKEND_FLASH_OVERWRITE_ENABLED
+#define NRF_LOG_BACKEND_FLASH_OVERWRITE_ENABLED 0
+#endif
+
 /** @brief Flashlog logger backend API. */
 extern const nrf_log_backend_api_t nrf_log_backend_flashlog_api;
 
@@ -93,6 +112,33 @@ typedef struct {
  */
 ret_code_t nrf_log_backend_flash_init(nrf_fstorage_api_t const * p_fs_api);
 
+/**
+ * @brief Function for finding a log entry stored in flash matching the query.
+ *
+ * Log messages stored in flash can be read one by one starting from the oldest one. Pages
+ * which do not contain entries of requested severity and pages older than requested timestamp
+ * are not decoded. Timestamp filtering assumes that the timestamp does not wrap around.
+ *
+ * @note Returned header and data are valid until the next call of the function.
+ *
+ * @param[in, out] p_token   Token reused between consecutive readings of log entries.
+ *                           Token must be set to 0 to read the first entry.
+ * @param[in]      severity  The highest severity level of returned entries.
+ *                           @ref NRF_LOG_SEVERITY_INFO includes raw entries.
+ * @param[in]      timestamp Entries with lower timestamp are skipped.
+ * @param[out]     pp_header Pointer to the entry header.
+ * @param[out]     pp_data   Pointer to the data part of the entry (arguments or data in case of hexdump).
+ *
+ * @retval NRF_SUCCESS             Entry was successfully read.
+ * @retval NRF_ERROR_NOT_SUPPORTED fstorage API does not support direct reading.
+ * @retval NRF_ERROR_NOT_FOUND     Entry not found. Last entry was already reached or area is empty.
+ */
+ret_code_t nrf_log_backend_flash_next_entry_find(uint32_t *           p_token,
+                                                 nrf_log_severity_t   severity,
+                                                 uint32_t             timestamp,
+                                                 nrf_log_header_t * * pp_header,
+                                                 uint8_t * *          pp_data);
+
 /**
  * @brief Function for getting a log entry stored in flash.
  *
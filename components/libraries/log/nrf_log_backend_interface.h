@@ -93,6 +93,17 @@ typedef struct
      * @brief @ref nrf_log_backend_flush
      */
     void (*flush)(nrf_log_backend_t const * p_backend);
+
+    /**
+     * @brief @ref nrf_log_backend_put_batch
+     *
+     * Optional. If not provided, entries from a batch are forwarded one by one using
+     * @ref nrf_log_backend_put.
+     */
+    void (*put_batch)(nrf_log_backend_t const * p_backend,
+                      nrf_log_entry_t *         p_batch,
+                      uint32_t                  count,
+                      uint32_t                  accepted);
 } nrf_log_backend_api_t;
 
 /**
@@ -158,6 +169,23 @@ NRF_SECTION_DEF(NRF_LOG_BACKEND_SECTION_NAME, nrf_log_backend_t);
 __STATIC_INLINE void nrf_log_backend_put(nrf_log_backend_t const * const p_backend,
                                          nrf_log_entry_t * p_msg);
 
+/**
+ * @brief Function for putting a batch of log entries to the backend.
+ *
+ * Used when @ref NRF_LOG_BATCH_DEQUEUE_ENABLED is set. Entries are stored one after another in
+ * a single message (see @ref nrf_log_batch_entry_size_get). The backend must process only the
+ * entries that passed its filters and should output them in a single transaction.
+ *
+ * @param[in] p_backend Pointer to the backend instance.
+ * @param[in] p_batch   Pointer to message with the batch of log entries.
+ * @param[in] count     Number of entries in the batch.
+ * @param[in] accepted  Bit mask of entries accepted by the backend (bit n set for entry n).
+ */
+__STATIC_INLINE void nrf_log_backend_put_batch(nrf_log_backend_t const * const p_backend,
+                                               nrf_log_entry_t * p_batch,
+                                               uint32_t          count,
+                                               uint32_t          accepted);
+
 /**
  * @brief Function for reconfiguring backend to panic mode.
  *
@@ -225,6 +253,14 @@ __STATIC_INLINE void nrf_log_backend_put(nrf_log_backend_t const * const p_backe
     p_backend->p_api->put(p_backend, p_msg);
 }
 
+__STATIC_INLINE void nrf_log_backend_put_batch(nrf_log_backend_t const * const p_backend,
+                                               nrf_log_entry_t * p_batch,
+                                               uint32_t          count,
+                                               uint32_t          accepted)
+{
+    p_backend->p_api->put_batch(p_backend, p_batch, count, accepted);
+}
+
 __STATIC_INLINE void nrf_log_backend_panic_set(nrf_log_backend_t const * const p_backend)
 {
     p_backend->p_api->panic_set(p_backend);
@@ -68,6 +68,19 @@ extern "C" {
  */
 typedef uint32_t (*nrf_log_timestamp_func_t)(void);
 
+/**
+ * @brief Logger processing statistics.
+ */
+typedef struct
+{
+    uint32_t processed; //!< Number of log entries forwarded to the backends.
+    uint32_t dropped;   //!< Number of log entries lost due to buffer overflow or lack of memory.
+    uint32_t batches;   //!< Number of processed batches.
+    uint16_t max_batch; //!< Largest number of log entries processed in a single batch.
+    uint32_t rate;      //!< Number of log entries processed per second since the statistics passed in.
+    uint32_t timestamp; //!< Timestamp at which the statistics were taken. 0 if timestamps are disabled.
+} nrf_log_frontend_stats_t;
+
 
 /**@brief Macro for initializing the logs.
  *
@@ -153,13 +166,27 @@ void nrf_log_panic(void);
  * @brief Function for handling a single log entry.
  *
  * Use this function only if the logs are buffered. It takes a single entry from the
- * buffer and attempts to process it.
+ * buffer and attempts to process it. If @ref NRF_LOG_BATCH_DEQUEUE_ENABLED is set, it takes
+ * up to @ref NRF_LOG_BATCH_MAX_ENTRIES entries and processes them as a single batch.
  *
  * @retval true  If there are more entries to process.
  * @retval false If there are no more entries to process.
  */
 bool nrf_log_frontend_dequeue(void);
 
+/**
+ * @brief Function for getting logger processing statistics.
+ *
+ * Available only if @ref NRF_LOG_BATCH_DEQUEUE_ENABLED is set. The rate is measured from the
+ * statistics that @p p_stats holds when the function is called, so each caller keeps its own
+ * baseline by passing the same structure again. A zeroed structure gives the rate since the logger
+ * was started. The rate is calculated only if timestamps are enabled
+ * (@ref NRF_LOG_USES_TIMESTAMP). Otherwise, it is set to 0.
+ *
+ * @param[in,out] p_stats Statistics. Previous statistics on input.
+ */
+void nrf_log_frontend_stats_get(nrf_log_frontend_stats_t * p_stats);
+
 /**
  * @brief Function for getting number of independent log modules registered into the logger.
  *
@@ -63,6 +63,7 @@ typedef struct
     uint16_t            dropped;
     nrf_log_severity_t  severity;
     uint8_t             use_colors;
+    bool                defer_flush; ///< If set, output is not flushed after the entry.
 } nrf_log_str_formatter_entry_params_t;
 
 
@@ -47,6 +47,7 @@
 #include "nrf_queue.h"
 #include "app_error.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #if (NRF_LOG_BACKEND_FLASHLOG_ENABLED == 0) && (NRF_LOG_BACKEND_CRASHLOG_ENABLED == 0)
 #error "No flash backend enabled."
@@ -99,6 +100,85 @@ STATIC_ASSERT(NRF_LOG_BACKEND_FLASH_SER_BUFFER_SIZE >= STD_LOG_MSG_MAX_LEN);
 #define RUNTIME_START_ADDR ((NRF_LOG_BACKEND_FLASH_START_PAGE == 0) ? \
                (CODE_PAGE_SIZE*CEIL_DIV((uint32_t)CODE_END, CODE_PAGE_SIZE)) : FLASH_LOG_START_ADDR)
 #endif
+
+/** @brief Value of the page header field which marks page as used by the flash log. Includes
+ *         format version. */
+#define FLASH_LOG_PAGE_MAGIC       0x4C4F4701
+
+/** @brief Value of the severity index of the page which is still being written. */
+#define FLASH_LOG_PAGE_OPEN        0xFFFFFFFF
+
+/** @brief Number of format string addresses kept in the compression dictionary. */
+#define FLASH_LOG_DICT_SIZE        16
+
+/** @brief Maximum length of a 32 bit value encoded as varint. */
+#define VARINT_MAX_LEN             5
+
+/** @brief Maximum length of encoded entry excluding arguments or data.
+ *
+ * Control byte, timestamp delta, module ID and format string (or hexdump length).
+ */
+#define ENTRY_HEADER_MAX_LEN       (1 + VARINT_MAX_LEN + 3 + 4)
+
+/** @brief Maximum length of encoded standard entry. */
+#define STD_ENTRY_MAX_LEN          (ENTRY_HEADER_MAX_LEN + NRF_LOG_MAX_NUM_OF_ARGS*VARINT_MAX_LEN)
+
+/** @brief Maximum length of encoded hexdump entry. */
+#define HEXDUMP_ENTRY_MAX_LEN      (ENTRY_HEADER_MAX_LEN + FLASH_LOG_MAX_PAYLOAD_SIZE)
+
+/** @brief Maximum length of encoded entry. */
+#define ENTRY_MAX_LEN              MAX(STD_ENTRY_MAX_LEN, HEXDUMP_ENTRY_MAX_LEN)
+
+/** @brief Entry control byte fields. */
+#define ENTRY_CTRL_SEVERITY_MASK   0x07
+#define ENTRY_CTRL_HEXDUMP         0x08
+#define ENTRY_CTRL_SAME_MODULE     0x10
+#define ENTRY_CTRL_NARGS_POS       5
+
+/** @brief Module ID which never matches the previous entry. Used at the beginning of a page. */
+#define MODULE_ID_INVALID          0xFFFFFFFF
+
+/** @brief Bit in the severity index which is always cleared in a closed page. */
+#define SEVERITY_INDEX_CLOSED      0x01
+
+/**
+ * @brief Header placed at the beginning of every page.
+ *
+ * Entries follow the header. Erased word (0xFF) in place of the next entry marks the end of
+ * the page. Severity index is the first field so that it can be written once the page is full
+ * without writing any word twice.
+ */
+typedef struct
+{
+    uint32_t severity_index; /**< Cleared bit (1 << severity) if page contains an entry of that severity. */
+    uint32_t magic;          /**< @ref FLASH_LOG_PAGE_MAGIC. */
+    uint32_t seq;            /**< Sequence number of the page, incremented for every new page. */
+    uint32_t timestamp;      /**< Timestamp of the first entry in the page. */
+} flash_log_page_hdr_t;
+
+/**
+ * @brief Compression context.
+ *
+ * Context is reset at the beginning of every page so that each page can be decoded on its own.
+ */
+typedef struct
+{
+    uint32_t timestamp;                      /**< Timestamp of the previous entry. */
+    uint32_t module_id;                      /**< Module ID of the previous entry. */
+    uint32_t severities;                     /**< Severities of entries in the page, see @ref flash_log_page_hdr_t. */
+    uint32_t dict[FLASH_LOG_DICT_SIZE];      /**< Recently used format strings, most recent first. */
+} flash_log_ctx_t;
+
+/** @brief Write state of the current page. */
+typedef enum
+{
+    PAGE_STATE_NONE,    /**< No page is open. Next page must be erased. */
+    PAGE_STATE_OPEN,    /**< Entries are appended to the current page. */
+    PAGE_STATE_CLOSING, /**< Severity index of the current page is being written. */
+    PAGE_STATE_ERASING, /**< Next page is being erased. */
+    PAGE_STATE_ERASED,  /**< Next page is erased. Next entry is written together with the page header. */
+} page_state_t;
+
 static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt);
 
 /** @brief Message queue for run time flash log. */
@@ -142,12 +222,33 @@ typedef enum
     LOG_BACKEND_FLASH_IN_PANIC, /**< Flash backend is in panic mode. Incoming messages are written to flash in synchronous mode. */
 } log_backend_flash_state_t;
 
+/** @brief Reader state. */
+typedef struct
+{
+    uint32_t        addr;      /**< Address of the next entry. */
+    uint32_t        page_addr; /**< Address of the page being read. */
+    uint32_t        seq;       /**< Sequence number of the page being read. */
+    flash_log_ctx_t ctx;       /**< Decompression context. */
+} flash_log_reader_t;
+
 static log_backend_flash_state_t m_state;                      /**< Flash logger backend state. */
 static nrf_atomic_flag_t         m_busy_flag;                  /**< Flag indicating if module performs flash writing. */
-static uint32_t                  m_flash_buf[FLASH_LOG_SER_BUFFER_WORDS]; /**< Buffer used for serializing messages. */
+static uint32_t                  m_ser_buf[FLASH_LOG_SER_BUFFER_WORDS]; /**< Buffer used for serializing messages. */
+static uint32_t                  m_flash_buf[CEIL_DIV(sizeof(flash_log_page_hdr_t) + ENTRY_MAX_LEN,
+                                                      sizeof(uint32_t))]; /**< Buffer with encoded entry being written. */
 static uint32_t                  m_curr_addr;                  /**< Address of free spot in the storage area. */
 static size_t                    m_curr_len;                   /**< Length of current message being written. */
 static uint32_t                  m_dropped;                    /**< Number of dropped messages. */
+static page_state_t              m_page_state;                 /**< Write state of the current page. */
+static uint32_t                  m_page_addr;                  /**< Address of the current page. */
+static uint32_t                  m_next_page_addr;             /**< Address of the page opened when the current one is full. */
+static uint32_t                  m_page_seq;                   /**< Sequence number of the next page. */
+static uint32_t                  m_severity_index;             /**< Severity index being written to the current page. */
+static flash_log_ctx_t           m_wr_ctx;                     /**< Compression context of the current page. */
+static flash_log_ctx_t           m_wr_ctx_next;                /**< Compression context after the entry being written. */
+static nrf_log_entry_t *         mp_pending_msg;               /**< Message waiting for a page to be opened. */
+static flash_log_reader_t        m_reader;                     /**< State of reading entries. */
+static uint32_t                  m_rd_buf[FLASH_LOG_SER_BUFFER_WORDS]; /**< Buffer with the last decoded entry. */
 
 /** @brief Log message string injected when entering panic mode. */
 static const char crashlog_str[] =  "-----------CRASHLOG------------\r\n";
@@ -217,43 +318,480 @@ static bool msg_to_buf(nrf_log_entry_t * p_msg, uint8_t * p_buf, size_t * p_len)
 }
 
 /**
- * @brief Function for getting logger message stored in flash.
+ * @brief Function for encoding a value as varint (7 bits per byte, least significant first).
  *
- * @param[in]  p_buf     Pointer to the location where message is stored.
- * @param[out] pp_header Pointer to the log message header.
- * @param[out] pp_data   Pointer to the log message data (arguments or data in case of hexdump).
+ * @return Pointer to the byte following the encoded value.
+ */
+static uint8_t * varint_put(uint8_t * p_buf, uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        *p_buf++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *p_buf++ = (uint8_t)value;
+    return p_buf;
+}
+
+/**
+ * @brief Function for decoding a varint.
  *
- * @return True if message was successfully fetched, false otherwise.
+ * @return Pointer to the byte following the encoded value or NULL if data is malformed.
  */
-static bool msg_from_buf(uint32_t *           p_buf,
-                         nrf_log_header_t * * pp_header,
-                         uint8_t * *          pp_data,
-                         uint32_t *           p_len)
+static uint8_t const * varint_get(uint8_t const * p_buf, uint8_t const * p_end, uint32_t * p_value)
 {
-    *pp_header = (nrf_log_header_t *)p_buf;
-    *pp_data = (uint8_t *)&p_buf[LOG_HEADER_LEN_WORDS];
+    uint32_t value = 0;
+    uint32_t shift;
 
-    uint32_t data_len;
+    for (shift = 0; (shift < 7*VARINT_MAX_LEN) && (p_buf < p_end); shift += 7)
+    {
+        uint8_t byte = *p_buf++;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            *p_value = value;
+            return p_buf;
+        }
+    }
+    return NULL;
+}
+
+/** @brief Function for mapping signed argument to unsigned value so that small negative numbers
+ *         are encoded on few bytes. */
+static uint32_t zigzag_encode(uint32_t value)
+{
+    return (value << 1) ^ (uint32_t)((int32_t)value >> 31);
+}
+
+static uint32_t zigzag_decode(uint32_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
 
-    switch ((*pp_header)->base.generic.type)
+/**
+ * @brief Function for resetting compression context at the beginning of the page.
+ */
+static void ctx_reset(flash_log_ctx_t * p_ctx, uint32_t timestamp)
+{
+    memset(p_ctx, 0, sizeof(flash_log_ctx_t));
+    p_ctx->timestamp = timestamp;
+    p_ctx->module_id = MODULE_ID_INVALID;
+}
+
+/**
+ * @brief Function for moving format string to the front of the dictionary.
+ *
+ * @param p_ctx Compression context.
+ * @param idx   Index of the format string in the dictionary. If it equals dictionary size,
+ *              the least recently used string is replaced.
+ * @param addr  Address of the format string.
+ */
+static void dict_update(flash_log_ctx_t * p_ctx, uint32_t idx, uint32_t addr)
+{
+    if (idx >= FLASH_LOG_DICT_SIZE)
     {
-        case HEADER_TYPE_STD:
+        idx = FLASH_LOG_DICT_SIZE - 1;
+    }
+    memmove(&p_ctx->dict[1], &p_ctx->dict[0], idx * sizeof(uint32_t));
+    p_ctx->dict[0] = addr;
+}
+
+/**
+ * @brief Function for encoding a logger entry.
+ *
+ * Entry starts with a control byte holding severity, type, number of arguments and a flag
+ * indicating that module ID is the same as in the previous entry. Control byte is followed by
+ * timestamp delta and module ID (if different) encoded as varints. Standard entry contains
+ * the format string as varint ((address << 1) or (dictionary index << 1 | 1)) followed by
+ * zigzag varint arguments. Hexdump entry contains data length and raw data.
+ *
+ * @param[in,out] p_ctx    Compression context.
+ * @param[in]     p_header Logger entry header.
+ * @param[in]     p_data   Arguments or data in case of hexdump.
+ * @param[out]    p_buf    Output buffer, at least @ref ENTRY_MAX_LEN bytes long.
+ *
+ * @return Length of the encoded entry aligned to word size.
+ */
+static uint32_t entry_encode(flash_log_ctx_t *        p_ctx,
+                             nrf_log_header_t const * p_header,
+                             uint8_t const *          p_data,
+                             uint8_t *                p_buf)
+{
+    uint8_t * p_dst = &p_buf[1];
+    uint32_t  severity;
+    uint8_t   ctrl;
+
+    p_dst = varint_put(p_dst, p_header->timestamp - p_ctx->timestamp);
+    p_ctx->timestamp = p_header->timestamp;
+
+    if (p_header->base.generic.type == HEADER_TYPE_STD)
+    {
+        uint32_t addr = p_header->base.std.addr;
+        uint32_t i;
+
+        severity = p_header->base.std.severity;
+        ctrl     = (uint8_t)(severity | (p_header->base.std.nargs << ENTRY_CTRL_NARGS_POS));
+
+        if (p_header->module_id == p_ctx->module_id)
         {
-            data_len = ((*pp_header)->base.std.nargs)*sizeof(uint32_t);
-            break;
+            ctrl |= ENTRY_CTRL_SAME_MODULE;
         }
-        case HEADER_TYPE_HEXDUMP:
+        else
+        {
+            p_dst = varint_put(p_dst, p_header->module_id);
+        }
+
+        for (i = 0; i < FLASH_LOG_DICT_SIZE; i++)
         {
+            if (p_ctx->dict[i] == addr)
+            {
+                break;
+            }
+        }
+        p_dst = varint_put(p_dst, (i < FLASH_LOG_DICT_SIZE) ? ((i << 1) | 1) : (addr << 1));
+        dict_update(p_ctx, i, addr);
 
-            data_len = saturate_align_length((*pp_header)->base.hexdump.len);
+        for (i = 0; i < p_header->base.std.nargs; i++)
+        {
+            uint32_t arg;
+            memcpy(&arg, &p_data[i * sizeof(uint32_t)], sizeof(uint32_t));
+            p_dst = varint_put(p_dst, zigzag_encode(arg));
+        }
+    }
+    else
+    {
+        uint32_t len = MIN(p_header->base.hexdump.len, FLASH_LOG_MAX_PAYLOAD_SIZE);
+
+        severity = p_header->base.hexdump.severity;
+        ctrl     = (uint8_t)(severity | ENTRY_CTRL_HEXDUMP);
+
+        if (p_header->module_id == p_ctx->module_id)
+        {
+            ctrl |= ENTRY_CTRL_SAME_MODULE;
+        }
+        else
+        {
+            p_dst = varint_put(p_dst, p_header->module_id);
+        }
+
+        p_dst = varint_put(p_dst, len);
+        memcpy(p_dst, p_data, len);
+        p_dst += len;
+    }
+
+    p_buf[0]          = ctrl;
+    p_ctx->module_id  = p_header->module_id;
+    p_ctx->severities |= (1UL << severity);
+
+    // Entries are word aligned. Padding is skipped when decoding.
+    while (((p_dst - p_buf) % sizeof(uint32_t)) != 0)
+    {
+        *p_dst++ = 0xFF;
+    }
+
+    return (uint32_t)(p_dst - p_buf);
+}
+
+/**
+ * @brief Function for decoding a logger entry.
+ *
+ * @param[in,out] p_ctx    Decompression context.
+ * @param[in]     p_src    Encoded entry.
+ * @param[in]     p_end    End of the page.
+ * @param[out]    p_header Decoded header.
+ * @param[out]    p_data   Decoded arguments or data in case of hexdump.
+ *
+ * @return Length of the encoded entry aligned to word size or 0 if end of the page was reached.
+ */
+static uint32_t entry_decode(flash_log_ctx_t *  p_ctx,
+                             uint8_t const *    p_src,
+                             uint8_t const *    p_end,
+                             nrf_log_header_t * p_header,
+                             uint8_t *          p_data)
+{
+    uint8_t const * p_ptr = &p_src[1];
+    uint32_t        value;
+
+    if (p_src >= p_end)
+    {
+        return 0;
+    }
+
+    uint8_t  ctrl     = p_src[0];
+    uint32_t severity = ctrl & ENTRY_CTRL_SEVERITY_MASK;
+
+    // Erased flash or corrupted entry.
+    if ((severity == NRF_LOG_SEVERITY_NONE) || (severity > NRF_LOG_SEVERITY_INFO_RAW))
+    {
+        return 0;
+    }
+
+    memset(p_header, 0, sizeof(nrf_log_header_t));
+
+    p_ptr = varint_get(p_ptr, p_end, &value);
+    if (p_ptr == NULL)
+    {
+        return 0;
+    }
+    p_header->timestamp = p_ctx->timestamp + value;
+
+    if (ctrl & ENTRY_CTRL_SAME_MODULE)
+    {
+        value = p_ctx->module_id;
+    }
+    else if ((p_ptr = varint_get(p_ptr, p_end, &value)) == NULL)
+    {
+        return 0;
+    }
+    p_header->module_id = (uint16_t)value;
+
+    if ((ctrl & ENTRY_CTRL_HEXDUMP) == 0)
+    {
+        uint32_t nargs = ctrl >> ENTRY_CTRL_NARGS_POS;
+        uint32_t addr;
+        uint32_t i;
+
+        p_ptr = varint_get(p_ptr, p_end, &value);
+        if ((p_ptr == NULL) || (nargs > NRF_LOG_MAX_NUM_OF_ARGS))
+        {
+            return 0;
+        }
+
+        if (value & 1)
+        {
+            i = value >> 1;
+            if (i >= FLASH_LOG_DICT_SIZE)
+            {
+                return 0;
+            }
+            addr = p_ctx->dict[i];
+        }
+        else
+        {
+            i    = FLASH_LOG_DICT_SIZE;
+            addr = value >> 1;
+        }
+        dict_update(p_ctx, i, addr);
+
+        for (i = 0; i < nargs; i++)
+        {
+            p_ptr = varint_get(p_ptr, p_end, &value);
+            if (p_ptr == NULL)
+            {
+                return 0;
+            }
+            value = zigzag_decode(value);
+            memcpy(&p_data[i * sizeof(uint32_t)], &value, sizeof(uint32_t));
+        }
+
+        p_header->base.std.type     = HEADER_TYPE_STD;
+        p_header->base.std.severity = severity;
+        p_header->base.std.nargs    = nargs;
+        p_header->base.std.addr     = addr & STD_ADDR_MASK;
+    }
+    else
+    {
+        p_ptr = varint_get(p_ptr, p_end, &value);
+        if ((p_ptr == NULL) || (value > FLASH_LOG_MAX_PAYLOAD_SIZE) || (value > (p_end - p_ptr)))
+        {
+            return 0;
+        }
+        memcpy(p_data, p_ptr, value);
+        p_ptr += value;
+
+        p_header->base.hexdump.type     = HEADER_TYPE_HEXDUMP;
+        p_header->base.hexdump.severity = severity;
+        p_header->base.hexdump.len      = value;
+    }
+
+    p_ctx->timestamp  = p_header->timestamp;
+    p_ctx->module_id  = p_header->module_id;
+    p_ctx->severities |= (1UL << severity);
+
+    return (uint32_t)(CEIL_DIV(p_ptr - p_src, sizeof(uint32_t)) * sizeof(uint32_t));
+}
+
+/**
+ * @brief Function for getting address of the page following the given one in the ring.
+ */
+static uint32_t page_next_get(uint32_t page_addr)
+{
+    page_addr += CODE_PAGE_SIZE;
+    return (page_addr < (RUNTIME_START_ADDR + FLASH_LOG_SIZE)) ? page_addr : RUNTIME_START_ADDR;
+}
+
+/**
+ * @brief Function for finding the page with the lowest sequence number not lower than given one.
+ *
+ * @return Address of the page or 0 if not found.
+ */
+static uint32_t page_find(uint32_t seq)
+{
+    uint32_t found_addr = 0;
+    uint32_t found_seq  = 0;
+    uint32_t page_addr  = RUNTIME_START_ADDR;
+    uint32_t i;
+
+    for (i = 0; i < NRF_LOG_BACKEND_PAGES; i++, page_addr += CODE_PAGE_SIZE)
+    {
+        flash_log_page_hdr_t const * p_hdr = (flash_log_page_hdr_t const *)page_addr;
+
+        if ((p_hdr->magic == FLASH_LOG_PAGE_MAGIC) &&
+            (p_hdr->seq >= seq) &&
+            ((found_addr == 0) || (p_hdr->seq < found_seq)))
+        {
+            found_addr = page_addr;
+            found_seq  = p_hdr->seq;
+        }
+    }
+    return found_addr;
+}
+
+/**
+ * @brief Function for starting the flash operation which moves the page state forward.
+ *
+ * Full page is closed by writing its severity index, then the next page is erased. If
+ * @ref NRF_LOG_BACKEND_FLASH_OVERWRITE_ENABLED is not set, a page holding logs is not erased.
+ *
+ * @param fstorage_blocking If true, the operation is completed when the function returns.
+ *
+ * @retval NRF_ERROR_INVALID_ADDR Area is full and the oldest logs are kept.
+ * @return Error code returned by fstorage.
+ */
+static ret_code_t page_op_start(bool fstorage_blocking)
+{
+    ret_code_t err_code;
+
+    if (m_page_state == PAGE_STATE_OPEN)
+    {
+        m_page_state     = PAGE_STATE_CLOSING;
+        m_severity_index = ~(m_wr_ctx.severities | SEVERITY_INDEX_CLOSED);
+        err_code = nrf_fstorage_write(&m_log_flash_fstorage,
+                                      m_page_addr + offsetof(flash_log_page_hdr_t, severity_index),
+                                      &m_severity_index,
+                                      sizeof(m_severity_index),
+                                      NULL);
+        if (err_code != NRF_SUCCESS)
+        {
+            m_page_state = PAGE_STATE_OPEN;
+        }
+        else if (fstorage_blocking)
+        {
+            m_page_state = PAGE_STATE_NONE;
+        }
+    }
+    else if (!NRF_LOG_BACKEND_FLASH_OVERWRITE_ENABLED &&
+             (((flash_log_page_hdr_t const *)m_next_page_addr)->magic == FLASH_LOG_PAGE_MAGIC))
+    {
+        // Area is full. Reported the same way as writing outside of the area.
+        err_code = NRF_ERROR_INVALID_ADDR;
+    }
+    else
+    {
+        m_page_state = PAGE_STATE_ERASING;
+        err_code = nrf_fstorage_erase(&m_log_flash_fstorage, m_next_page_addr, 1, NULL);
+        if (err_code != NRF_SUCCESS)
+        {
+            m_page_state = PAGE_STATE_NONE;
+        }
+        else if (fstorage_blocking)
+        {
+            m_page_state = PAGE_STATE_ERASED;
+        }
+    }
+    return err_code;
+}
+
+/**
+ * @brief Function for starting writing of a logger entry.
+ *
+ * If the entry does not fit into the current page, a new page is opened first. If flash
+ * operations are not blocking, the function returns after starting a page operation and it must
+ * be called again once the operation completes.
+ *
+ * @param p_header          Logger entry header.
+ * @param p_data            Arguments or data in case of hexdump.
+ * @param p_param           Parameter passed to fstorage with the entry write.
+ * @param fstorage_blocking If true it indicates that flash operations are blocking.
+ *
+ * @retval NRF_SUCCESS    Entry write started (or completed if flash operations are blocking).
+ * @retval NRF_ERROR_BUSY Page operation started. Entry must be written once it completes.
+ * @return Error code returned by fstorage.
+ */
+static ret_code_t entry_write(nrf_log_header_t const * p_header,
+                              uint8_t const *          p_data,
+                              void *                   p_param,
+                              bool                     fstorage_blocking)
+{
+    uint8_t *  p_buf = (uint8_t *)m_flash_buf;
+    uint32_t   addr;
+    ret_code_t err_code;
+
+    while (true)
+    {
+        if (m_page_state == PAGE_STATE_OPEN)
+        {
+            m_wr_ctx_next = m_wr_ctx;
+            m_curr_len    = entry_encode(&m_wr_ctx_next, p_header, p_data, p_buf);
+            addr          = m_curr_addr;
+            if ((addr + m_curr_len) <= (m_page_addr + CODE_PAGE_SIZE))
+            {
+                break;
+            }
+        }
+        else if (m_page_state == PAGE_STATE_ERASED)
+        {
+            flash_log_page_hdr_t * p_page_hdr = (flash_log_page_hdr_t *)m_flash_buf;
+
+            // Severity index is left erased until the page is closed.
+            p_page_hdr->magic     = FLASH_LOG_PAGE_MAGIC;
+            p_page_hdr->seq       = m_page_seq;
+            p_page_hdr->timestamp = p_header->timestamp;
+
+            ctx_reset(&m_wr_ctx_next, p_header->timestamp);
+            m_curr_len = entry_encode(&m_wr_ctx_next,
+                                      p_header,
+                                      p_data,
+                                      &p_buf[sizeof(flash_log_page_hdr_t)]);
+            m_curr_len += sizeof(flash_log_page_hdr_t) - sizeof(p_page_hdr->severity_index);
+            p_buf       = (uint8_t *)&p_page_hdr->magic;
+            addr        = m_next_page_addr + sizeof(p_page_hdr->severity_index);
             break;
         }
-        default:
-            return false;
+
+        err_code = page_op_start(fstorage_blocking);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+        if (!fstorage_blocking)
+        {
+            return NRF_ERROR_BUSY;
+        }
     }
 
-    *p_len = LOG_HEADER_LEN + data_len;
-    return true;
+    // Message is no longer pending. Flash operations may complete before the function returns.
+    mp_pending_msg = NULL;
+
+    return nrf_fstorage_write(&m_log_flash_fstorage, addr, p_buf, m_curr_len, p_param);
+}
+
+/**
+ * @brief Function for updating the write state after an entry was written.
+ */
+static void entry_write_done(void)
+{
+    if (m_page_state == PAGE_STATE_ERASED)
+    {
+        m_page_addr      = m_next_page_addr;
+        m_next_page_addr = page_next_get(m_page_addr);
+        m_curr_addr      = m_page_addr + sizeof(uint32_t);
+        m_page_state     = PAGE_STATE_OPEN;
+        m_page_seq++;
+    }
+    m_curr_addr += m_curr_len;
+    m_curr_len   = 0;
+    m_wr_ctx     = m_wr_ctx_next;
 }
 
 /**
@@ -273,24 +811,29 @@ static void log_msg_queue_process(nrf_queue_t const * p_queue, bool fstorage_blo
 {
     nrf_log_entry_t * p_msg;
     bool              busy = false;
-    while (nrf_queue_pop(p_queue, &p_msg) == NRF_SUCCESS)
+    while ((mp_pending_msg != NULL) || (nrf_queue_pop(p_queue, &mp_pending_msg) == NRF_SUCCESS))
     {
         ret_code_t err_code;
+        size_t     len = sizeof(m_ser_buf);
 
-        m_curr_len = sizeof(m_flash_buf);
-        if (!msg_to_buf(p_msg, (uint8_t *)m_flash_buf, &m_curr_len))
+        p_msg = mp_pending_msg;
+        if (!msg_to_buf(p_msg, (uint8_t *)m_ser_buf, &len))
         {
+            mp_pending_msg = NULL;
             nrf_memobj_put(p_msg);
             continue;
         }
 
-        err_code = nrf_fstorage_write(&m_log_flash_fstorage, m_curr_addr, m_flash_buf, m_curr_len, p_msg);
+        err_code = entry_write((nrf_log_header_t *)m_ser_buf,
+                               (uint8_t *)&m_ser_buf[LOG_HEADER_LEN_WORDS],
+                               p_msg,
+                               fstorage_blocking);
 
         if (err_code == NRF_SUCCESS)
         {
             if (fstorage_blocking)
             {
-                m_curr_addr += m_curr_len;
+                entry_write_done();
 
                 nrf_memobj_put(p_msg);
             }
@@ -300,16 +843,24 @@ static void log_msg_queue_process(nrf_queue_t const * p_queue, bool fstorage_blo
                 break;
             }
         }
+        else if (err_code == NRF_ERROR_BUSY)
+        {
+            // New page is being prepared. Message is written when it is ready.
+            busy = true;
+            break;
+        }
         else if (!fstorage_blocking && (err_code == NRF_ERROR_NO_MEM))
         {
             // fstorage queue got full. Drop entry.
+            mp_pending_msg = NULL;
             nrf_memobj_put(p_msg);
             m_dropped++;
             break;
         }
         else if (err_code == NRF_ERROR_INVALID_ADDR)
         {
-            // Trying to write outside the area, flash log is full. Skip any new writes.
+            // Trying to write outside the area. Skip any new writes.
+            mp_pending_msg = NULL;
             nrf_memobj_put(p_msg);
             m_state = LOG_BACKEND_FLASH_INACTIVE;
         }
@@ -343,16 +894,28 @@ static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt)
         {
             case NRF_FSTORAGE_EVT_WRITE_RESULT:
             {
-                if (p_evt->result == NRF_SUCCESS)
+                if (m_page_state == PAGE_STATE_CLOSING)
                 {
-                    m_curr_addr += m_curr_len;
-                    m_curr_len = 0;
+                    // Severity index written. Failure only makes queries read the whole page.
+                    m_page_state = PAGE_STATE_NONE;
                     log_msg_queue_process(mp_flashlog_queue, false);
+                    break;
+                }
+
+                if (p_evt->result == NRF_SUCCESS)
+                {
+                    entry_write_done();
                 }
                 else
                 {
                     m_dropped++;
+                    if (m_page_state == PAGE_STATE_ERASED)
+                    {
+                        // Page header may be partially written. Erase the page again.
+                        m_page_state = PAGE_STATE_NONE;
+                    }
                 }
+                log_msg_queue_process(mp_flashlog_queue, false);
 
                 if (p_evt->p_param)
                 {
@@ -360,6 +923,29 @@ static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt)
                 }
                 break;
             }
+            case NRF_FSTORAGE_EVT_ERASE_RESULT:
+            {
+                if (m_page_state == PAGE_STATE_ERASING)
+                {
+                    if (p_evt->result == NRF_SUCCESS)
+                    {
+                        m_page_state = PAGE_STATE_ERASED;
+                    }
+                    else
+                    {
+                        // Drop the message waiting for the page. Next message retries the erase.
+                        m_page_state = PAGE_STATE_NONE;
+                        if (mp_pending_msg != NULL)
+                        {
+                            nrf_memobj_put(mp_pending_msg);
+                            mp_pending_msg = NULL;
+                            m_dropped++;
+                        }
+                    }
+                    log_msg_queue_process(mp_flashlog_queue, false);
+                }
+                break;
+            }
             default:
                 break;
         }
@@ -465,13 +1051,13 @@ static void crashlog_marker_inject(void)
                 }
             },
             .module_id = 0,
-            .timestamp = 0,
+            .timestamp = m_wr_ctx.timestamp,
     };
-    m_flash_buf[0] = crashlog_marker_hdr.base.raw;
-    m_flash_buf[1] = crashlog_marker_hdr.module_id;
-    m_flash_buf[2] = crashlog_marker_hdr.timestamp;
-    (void)nrf_fstorage_write(&m_log_flash_fstorage, m_curr_addr, m_flash_buf, LOG_HEADER_LEN, NULL);
-    m_curr_addr += LOG_HEADER_LEN;
+
+    if (entry_write(&crashlog_marker_hdr, NULL, NULL, true) == NRF_SUCCESS)
+    {
+        entry_write_done();
+    }
 }
 
 
@@ -484,6 +1070,12 @@ void nrf_log_backend_crashlog_panic_set(nrf_log_backend_t const * p_backend)
         /* In case of Softdevice MWU may protect access to NVMC. */
         NVIC_DisableIRQ(MWU_IRQn);
 
+        /* Page operation interrupted by the panic is repeated. */
+        if ((m_page_state == PAGE_STATE_CLOSING) || (m_page_state == PAGE_STATE_ERASING))
+        {
+            m_page_state = PAGE_STATE_NONE;
+        }
+
         log_msg_queue_process(mp_flashlog_queue, true);
 
         crashlog_marker_inject();
@@ -497,20 +1089,156 @@ void nrf_log_backend_crashlog_panic_set(nrf_log_backend_t const * p_backend)
 }
 
 /**
- * @brief Function for determining first empty location in area dedicated for flash logger backend.
+ * @brief Function for opening the first page, starting from the given one, which may contain
+ *        entries matching the query.
+ *
+ * Page is skipped if its severity index shows that it has no entries of requested severities or
+ * if the next page starts before requested timestamp.
+ *
+ * @param page_addr  Address of the page.
+ * @param severities Mask of requested severities.
+ * @param timestamp  Requested timestamp.
+ *
+ * @return True if page was opened, false if there are no more pages.
  */
-static uint32_t empty_addr_get(void)
+static bool reader_page_open(uint32_t page_addr, uint32_t severities, uint32_t timestamp)
 {
-    uint32_t token = 0;
-    nrf_log_header_t * p_dummy_header;
-    uint8_t * p_dummy_data;
+    while (page_addr != 0)
+    {
+        flash_log_page_hdr_t const * p_hdr     = (flash_log_page_hdr_t const *)page_addr;
+        uint32_t                     next_addr = page_find(p_hdr->seq + 1);
+        bool                         skip      = false;
+
+        if ((p_hdr->severity_index != FLASH_LOG_PAGE_OPEN) &&
+            ((~p_hdr->severity_index & severities) == 0))
+        {
+            skip = true;
+        }
+        if ((next_addr != 0) && (((flash_log_page_hdr_t const *)next_addr)->timestamp < timestamp))
+        {
+            skip = true;
+        }
+
+        if (!skip)
+        {
+            m_reader.page_addr = page_addr;
+            m_reader.seq       = p_hdr->seq;
+            m_reader.addr      = page_addr + sizeof(flash_log_page_hdr_t);
+            ctx_reset(&m_reader.ctx, p_hdr->timestamp);
+            return true;
+        }
+        page_addr = next_addr;
+    }
+    return false;
+}
+
+/**
+ * @brief Function for decoding next entry of the page being read.
+ *
+ * @return True if entry was decoded, false if end of the page was reached.
+ */
+static bool reader_entry_get(nrf_log_header_t * * pp_header, uint8_t * * pp_data)
+{
+    nrf_log_header_t * p_header = (nrf_log_header_t *)m_rd_buf;
+    uint8_t *          p_data   = (uint8_t *)&m_rd_buf[LOG_HEADER_LEN_WORDS];
+    uint32_t           len;
+
+    len = entry_decode(&m_reader.ctx,
+                       (uint8_t const *)m_reader.addr,
+                       (uint8_t const *)(m_reader.page_addr + CODE_PAGE_SIZE),
+                       p_header,
+                       p_data);
+    if (len == 0)
+    {
+        return false;
+    }
+
+    m_reader.addr += len;
+    *pp_header     = p_header;
+    *pp_data       = p_data;
+    return true;
+}
+
+/**
+ * @brief Function for restoring reader state for given token.
+ *
+ * Page is decoded from the beginning because entries depend on the previous ones.
+ */
+static bool reader_seek(uint32_t token)
+{
+    nrf_log_header_t * p_header;
+    uint8_t *          p_data;
+    uint32_t           page_addr = RUNTIME_START_ADDR +
+                                   ((token - RUNTIME_START_ADDR) / CODE_PAGE_SIZE) * CODE_PAGE_SIZE;
+
+    if ((token < RUNTIME_START_ADDR) ||
+        (token >= RUNTIME_START_ADDR + FLASH_LOG_SIZE) ||
+        (((flash_log_page_hdr_t const *)page_addr)->magic != FLASH_LOG_PAGE_MAGIC))
+    {
+        return false;
+    }
+
+    UNUSED_RETURN_VALUE(reader_page_open(page_addr, UINT32_MAX, 0));
+    while (m_reader.addr < token)
+    {
+        if (!reader_entry_get(&p_header, &p_data))
+        {
+            break;
+        }
+    }
+    return (m_reader.addr == token);
+}
 
-    while(nrf_log_backend_flash_next_entry_get(&token, &p_dummy_header, &p_dummy_data) == NRF_SUCCESS)
+/**
+ * @brief Function for determining the current page and first empty location in area dedicated
+ *        for flash logger backend.
+ */
+static void write_state_restore(void)
+{
+    nrf_log_header_t * p_header;
+    uint8_t *          p_data;
+    uint32_t           page_addr = RUNTIME_START_ADDR;
+    uint32_t           last_addr = 0;
+    uint32_t           i;
+
+    m_page_state     = PAGE_STATE_NONE;
+    m_page_seq       = 0;
+    m_next_page_addr = RUNTIME_START_ADDR;
+    m_curr_addr      = RUNTIME_START_ADDR;
+    mp_pending_msg   = NULL;
+
+    for (i = 0; i < NRF_LOG_BACKEND_PAGES; i++, page_addr += CODE_PAGE_SIZE)
     {
+        flash_log_page_hdr_t const * p_hdr = (flash_log_page_hdr_t const *)page_addr;
+
+        if ((p_hdr->magic == FLASH_LOG_PAGE_MAGIC) && (p_hdr->seq >= m_page_seq))
+        {
+            m_page_seq = p_hdr->seq + 1;
+            last_addr  = page_addr;
+        }
+    }
 
+    if (last_addr == 0)
+    {
+        return;
     }
 
-    return token;
+    m_next_page_addr = page_next_get(last_addr);
+
+    if (((flash_log_page_hdr_t const *)last_addr)->severity_index == FLASH_LOG_PAGE_OPEN)
+    {
+        // Newest page was not closed. New entries are appended to it.
+        UNUSED_RETURN_VALUE(reader_page_open(last_addr, UINT32_MAX, 0));
+        while (reader_entry_get(&p_header, &p_data))
+        {
+        }
+
+        m_page_addr  = last_addr;
+        m_curr_addr  = m_reader.addr;
+        m_wr_ctx     = m_reader.ctx;
+        m_page_state = PAGE_STATE_OPEN;
+    }
+    m_reader.addr = 0;
 }
 
 
@@ -531,37 +1259,90 @@ ret_code_t nrf_log_backend_flash_init(nrf_fstorage_api_t const * p_fs_api)
         return err_code;
     }
 
-    m_curr_addr = empty_addr_get();
+    if (nrf_fstorage_rmap(&m_log_flash_fstorage, start_addr) == NULL)
+    {
+        //Supports only memories which can be mapped for reading.
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    write_state_restore();
     m_state  = LOG_BACKEND_FLASH_ACTIVE;
 
     return err_code;
 }
 
 
-ret_code_t nrf_log_backend_flash_next_entry_get(uint32_t *                p_token,
-                                                nrf_log_header_t * *      pp_header,
-                                                uint8_t * *               pp_data)
+ret_code_t nrf_log_backend_flash_next_entry_find(uint32_t *           p_token,
+                                                 nrf_log_severity_t   severity,
+                                                 uint32_t             timestamp,
+                                                 nrf_log_header_t * * pp_header,
+                                                 uint8_t * *          pp_data)
 {
-    uint32_t * p_addr = p_token;
-    uint32_t   len;
-
-    *p_addr = (*p_addr == 0) ? RUNTIME_START_ADDR : *p_addr;
+    uint32_t severities = 0;
+    uint32_t i;
 
-    if (nrf_fstorage_rmap(&m_log_flash_fstorage, *p_addr) == NULL)
+    if (nrf_fstorage_rmap(&m_log_flash_fstorage, RUNTIME_START_ADDR) == NULL)
     {
         //Supports only memories which can be mapped for reading.
         return NRF_ERROR_NOT_SUPPORTED;
     }
 
-    if (msg_from_buf((uint32_t *)*p_addr, pp_header, pp_data, &len))
+    for (i = NRF_LOG_SEVERITY_ERROR; i <= severity; i++)
     {
-        *p_addr += len;
-        return NRF_SUCCESS;
+        severities |= (1UL << i);
     }
-    else
+    if (severity >= NRF_LOG_SEVERITY_INFO)
+    {
+        severities |= (1UL << NRF_LOG_SEVERITY_INFO_RAW);
+    }
+
+    if (*p_token == 0)
+    {
+        if (!reader_page_open(page_find(0), severities, timestamp))
+        {
+            return NRF_ERROR_NOT_FOUND;
+        }
+    }
+    else if ((*p_token != m_reader.addr) && !reader_seek(*p_token))
     {
         return NRF_ERROR_NOT_FOUND;
     }
+
+    while (true)
+    {
+        if (!reader_entry_get(pp_header, pp_data))
+        {
+            // End of the page reached, continue with the next one.
+            if (!reader_page_open(page_find(m_reader.seq + 1), severities, timestamp))
+            {
+                *p_token = m_reader.addr;
+                return NRF_ERROR_NOT_FOUND;
+            }
+            continue;
+        }
+
+        uint32_t entry_severity = ((*pp_header)->base.generic.type == HEADER_TYPE_STD) ?
+                                  (*pp_header)->base.std.severity :
+                                  (*pp_header)->base.hexdump.severity;
+
+        if ((severities & (1UL << entry_severity)) && ((*pp_header)->timestamp >= timestamp))
+        {
+            *p_token = m_reader.addr;
+            return NRF_SUCCESS;
+        }
+    }
+}
+
+
+ret_code_t nrf_log_backend_flash_next_entry_get(uint32_t *                p_token,
+                                                nrf_log_header_t * *      pp_header,
+                                                uint8_t * *               pp_data)
+{
+    return nrf_log_backend_flash_next_entry_find(p_token,
+                                                 NRF_LOG_SEVERITY_DEBUG,
+                                                 0,
+                                                 pp_header,
+                                                 pp_data);
 }
 
 
@@ -571,8 +1352,11 @@ ret_code_t nrf_log_backend_flash_erase(void)
 
     m_state = LOG_BACKEND_FLASH_INACTIVE;
     err_code = nrf_fstorage_erase(&m_log_flash_fstorage, RUNTIME_START_ADDR, NRF_LOG_BACKEND_PAGES, NULL);
-    
-    m_curr_addr = RUNTIME_START_ADDR;
+
+    m_curr_addr      = RUNTIME_START_ADDR;
+    m_next_page_addr = RUNTIME_START_ADDR;
+    m_page_state     = PAGE_STATE_NONE;
+    m_reader.addr    = 0;
 
     return err_code;
 }
@@ -595,6 +1379,8 @@ const nrf_log_backend_api_t nrf_log_backend_crashlog_api = {
 
 #if NRF_LOG_BACKEND_FLASH_CLI_CMDS
 #include "nrf_cli.h"
+#include <stdlib.h>
+#include <string.h>
 
 static uint8_t m_buffer[64];
 static nrf_cli_t const * mp_cli;
@@ -673,21 +1459,67 @@ static void entry_process(nrf_cli_t const * p_cli, nrf_log_header_t * p_header,
 }
 
 
+/**
+ * @brief Function for parsing severity name.
+ *
+ * @return True if name is valid.
+ */
+static bool severity_parse(char const * p_name, nrf_log_severity_t * p_severity)
+{
+    static char const * const severity_names[] = {"error", "warning", "info", "debug"};
+    uint32_t i;
+
+    for (i = 0; i < ARRAY_SIZE(severity_names); i++)
+    {
+        if (strcmp(p_name, severity_names[i]) == 0)
+        {
+            *p_severity = (nrf_log_severity_t)(NRF_LOG_SEVERITY_ERROR + i);
+            return true;
+        }
+    }
+    return false;
+}
+
+
 static void flashlog_read_cmd(nrf_cli_t const * p_cli, size_t argc, char ** argv)
 {
     if (nrf_cli_help_requested(p_cli))
     {
         nrf_cli_help_print(p_cli, NULL, 0);
+        return;
     }
 
-    uint32_t           token  = 0;
-    uint8_t *          p_data = NULL;
-    bool               empty  = true;
+    uint32_t           token     = 0;
+    uint32_t           timestamp = 0;
+    uint8_t *          p_data    = NULL;
+    bool               empty     = true;
+    nrf_log_severity_t severity  = NRF_LOG_SEVERITY_DEBUG;
     nrf_log_header_t * p_header;
 
+    if (argc > 3)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "%s: bad parameter count\r\n", argv[0]);
+        return;
+    }
+
+    if ((argc > 1) && !severity_parse(argv[1], &severity))
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "%s: wrong severity: %s\r\n", argv[0], argv[1]);
+        return;
+    }
+
+    if (argc > 2)
+    {
+        timestamp = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+
     while (1)
     {
-        if (nrf_log_backend_flash_next_entry_get(&token, &p_header, &p_data) == NRF_SUCCESS)
+        if (nrf_log_backend_flash_next_entry_find(&token,
+                                                  severity,
+                                                  timestamp,
+                                                  &p_header,
+                                                  &p_data) == NRF_SUCCESS)
         {
             entry_process(p_cli, p_header, p_data);
             empty = false;
@@ -712,13 +1544,49 @@ static void flashlog_status_cmd(nrf_cli_t const * p_cli, size_t argc, char ** ar
         nrf_cli_help_print(p_cli, NULL, 0);
     }
 
+    uint32_t pages      = 0;
+    uint32_t used       = 0;
+    uint32_t oldest_seq = 0;
+    uint32_t newest_seq = 0;
+    uint32_t page_addr  = RUNTIME_START_ADDR;
+    uint32_t i;
+
+    for (i = 0; i < NRF_LOG_BACKEND_PAGES; i++, page_addr += CODE_PAGE_SIZE)
+    {
+        flash_log_page_hdr_t const * p_hdr = (flash_log_page_hdr_t const *)page_addr;
+
+        if (p_hdr->magic != FLASH_LOG_PAGE_MAGIC)
+        {
+            continue;
+        }
+
+        if ((pages == 0) || (p_hdr->seq < oldest_seq))
+        {
+            oldest_seq = p_hdr->seq;
+        }
+        if ((pages == 0) || (p_hdr->seq > newest_seq))
+        {
+            newest_seq = p_hdr->seq;
+        }
+        pages++;
+        used += ((m_page_state != PAGE_STATE_NONE) && (page_addr == m_page_addr)) ?
+                (m_curr_addr - m_page_addr) : CODE_PAGE_SIZE;
+    }
+
     nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "Flash log status:\r\n");
     nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\t\t- Location (address: 0x%08X, length: %d)\r\n",
                                                                 RUNTIME_START_ADDR, FLASH_LOG_SIZE);
     nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\t\t- Current usage:%d%% (%d of %d bytes used)\r\n",
-                                       100ul * (m_curr_addr - RUNTIME_START_ADDR)/FLASH_LOG_SIZE,
-                                       m_curr_addr - RUNTIME_START_ADDR,
+                                       100ul * used/FLASH_LOG_SIZE,
+                                       used,
                                        FLASH_LOG_SIZE);
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\t\t- Pages used: %d of %d\r\n",
+                                           pages, NRF_LOG_BACKEND_PAGES);
+    if (pages > 0)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\t\t- Page sequence: %u - %u\r\n",
+                                               oldest_seq, newest_seq);
+    }
     nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\t\t- Dropped logs: %d\r\n", m_dropped);
 
 
@@ -728,7 +1596,8 @@ static void flashlog_status_cmd(nrf_cli_t const * p_cli, size_t argc, char ** ar
 NRF_CLI_CREATE_STATIC_SUBCMD_SET(m_flashlog_cmd)
 {
     NRF_CLI_CMD(clear,   NULL, "Remove logs",      flashlog_clear_cmd),
-    NRF_CLI_CMD(read,    NULL, "Read stored logs", flashlog_read_cmd),
+    NRF_CLI_CMD(read,    NULL, "Read stored logs: read [error|warning|info|debug [<timestamp>]]",
+                flashlog_read_cmd),
     NRF_CLI_CMD(status,  NULL, "Flash log status", flashlog_status_cmd),
     NRF_CLI_SUBCMD_SET_END
 };
@@ -42,36 +42,237 @@
 #include "nrf_log_backend_serial.h"
 #include "nrf_log_str_formatter.h"
 #include "nrf_log_internal.h"
+#include <string.h>
 
-void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
-                               nrf_log_entry_t * p_msg,
-                               uint8_t * p_buffer,
-                               uint32_t  length,
-                               nrf_fprintf_fwrite tx_func)
+#if NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED
+/**
+ * @brief Function for appending data to the output buffer.
+ *
+ * The buffer is passed to the transmit function whenever it gets full.
+ */
+static void bin_write(nrf_fprintf_ctx_t * p_ctx, void const * p_data, size_t len)
 {
-    nrf_memobj_get(p_msg);
+    uint8_t const * p_src = (uint8_t const *)p_data;
 
-    nrf_fprintf_ctx_t fprintf_ctx = {
-            .p_io_buffer = (char *)p_buffer,
-            .io_buffer_size = length,
-            .io_buffer_cnt = 0,
-            .auto_flush = false,
-            .p_user_ctx = NULL,
-            .fwrite = tx_func
-    };
+    while (len > 0)
+    {
+        size_t chunk_len = MIN(len, p_ctx->io_buffer_size - p_ctx->io_buffer_cnt);
+
+        memcpy(&p_ctx->p_io_buffer[p_ctx->io_buffer_cnt], p_src, chunk_len);
+        p_ctx->io_buffer_cnt += chunk_len;
+        p_src                += chunk_len;
+        len                  -= chunk_len;
+
+        if (p_ctx->io_buffer_cnt == p_ctx->io_buffer_size)
+        {
+            nrf_fprintf_buffer_flush(p_ctx);
+        }
+    }
+}
+
+/**
+ * @brief Function for writing a frame header.
+ */
+static void bin_frame_start(nrf_fprintf_ctx_t * p_ctx, uint8_t sync, size_t len)
+{
+    uint8_t frame_header[] = {sync, (uint8_t)len};
+
+    bin_write(p_ctx, frame_header, sizeof(frame_header));
+}
+
+/**
+ * @brief Function for sending the strings of the %s arguments of a standard entry.
+ *
+ * Strings can be located in RAM (see @ref NRF_LOG_PUSH), where the host cannot read them. Each
+ * string is sent in a data frame, in the order of the arguments. The format string is parsed the
+ * same way as by nrf_fprintf.
+ *
+ * @param p_fmt  Format string.
+ * @param p_args Arguments of the entry.
+ * @param nargs  Number of arguments.
+ * @param p_ctx  Pointer to the fprintf context used for buffering the output.
+ */
+static void bin_strings_write(char const *        p_fmt,
+                              uint32_t const *    p_args,
+                              uint32_t            nargs,
+                              nrf_fprintf_ctx_t * p_ctx)
+{
+    uint32_t arg = 0;
+    char     c;
+
+    while ((c = *p_fmt++) != '\0')
+    {
+        if (c != '%')
+        {
+            continue;
+        }
+
+        while ((*p_fmt == '-') || (*p_fmt == '0') || (*p_fmt == '+'))
+        {
+            p_fmt++;
+        }
+        if (*p_fmt == '*')
+        {
+            arg++;
+            p_fmt++;
+        }
+        while ((*p_fmt >= '0') && (*p_fmt <= '9'))
+        {
+            p_fmt++;
+        }
+        if (*p_fmt == '.')
+        {
+            p_fmt++;
+            while ((*p_fmt >= '0') && (*p_fmt <= '9'))
+            {
+                p_fmt++;
+            }
+        }
+        while ((*p_fmt == 'l') || (*p_fmt == 'h'))
+        {
+            p_fmt++;
+        }
+
+        c = *p_fmt;
+        if (c == '\0')
+        {
+            break;
+        }
+        p_fmt++;
+
+        if (c == 's')
+        {
+            char const * p_str = (arg < nargs) ? (char const *)p_args[arg] : NULL;
+            size_t       len   = 0;
+
+            if (p_str != NULL)
+            {
+                while ((len < NRF_LOG_BACKEND_SERIAL_BIN_FRAME_MAX_LEN) && (p_str[len] != '\0'))
+                {
+                    len++;
+                }
+            }
+            bin_frame_start(p_ctx, NRF_LOG_BACKEND_SERIAL_BIN_SYNC_DATA, len);
+            bin_write(p_ctx, p_str, len);
+        }
+        if ((c == 'c') || (c == 'd') || (c == 'i') || (c == 'u') ||
+            (c == 'x') || (c == 'X') || (c == 's') || (c == 'p'))
+        {
+            arg++;
+        }
+    }
+}
 
+/**
+ * @brief Function for encoding a single log entry stored in a message as binary frames.
+ *
+ * The entry is sent in one frame, followed by data frames with the strings of %s arguments or
+ * with the part of a long hexdump that does not fit in the first frame.
+ *
+ * @param p_msg         Pointer to the message.
+ * @param memobj_offset Offset of the entry within the message.
+ * @param p_ctx         Pointer to the fprintf context used for buffering the output.
+ */
+static void entry_bin_process(nrf_log_entry_t *   p_msg,
+                              size_t              memobj_offset,
+                              nrf_fprintf_ctx_t * p_ctx)
+{
+    nrf_log_header_t header;
+    uint32_t         data_len;
+    uint32_t         frame_data_len;
+    size_t           args_offset = memobj_offset + HEADER_SIZE*sizeof(uint32_t);
+
+    nrf_memobj_read(p_msg, &header, HEADER_SIZE*sizeof(uint32_t), memobj_offset);
+    memobj_offset += HEADER_SIZE*sizeof(uint32_t);
+
+    if (header.base.generic.type == HEADER_TYPE_STD)
+    {
+        data_len       = header.base.std.nargs * sizeof(uint32_t);
+        frame_data_len = data_len;
+    }
+    else if (header.base.generic.type == HEADER_TYPE_HEXDUMP)
+    {
+        // Frame length is stored on one byte. The header keeps the full length of the hexdump.
+        data_len       = header.base.hexdump.len;
+        frame_data_len = data_len;
+        if (frame_data_len > NRF_LOG_BACKEND_SERIAL_BIN_HEXDUMP_SPLIT_LEN)
+        {
+            frame_data_len = NRF_LOG_BACKEND_SERIAL_BIN_HEXDUMP_SPLIT_LEN;
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    bin_frame_start(p_ctx,
+                    NRF_LOG_BACKEND_SERIAL_BIN_SYNC,
+                    HEADER_SIZE*sizeof(uint32_t) + frame_data_len);
+    bin_write(p_ctx, &header, HEADER_SIZE*sizeof(uint32_t));
+
+    // Payload is copied to the output buffer from the memory object chunks, without an
+    // intermediate buffer. The output buffer is still needed because the transmit function takes
+    // one contiguous buffer. The rest of a long hexdump follows in data frames.
+    while (data_len > 0)
+    {
+        if (frame_data_len == 0)
+        {
+            frame_data_len = MIN(data_len, NRF_LOG_BACKEND_SERIAL_BIN_FRAME_MAX_LEN);
+            bin_frame_start(p_ctx, NRF_LOG_BACKEND_SERIAL_BIN_SYNC_DATA, frame_data_len);
+        }
+
+        nrf_memobj_iovec_t iov[2];
+        size_t             iov_cnt = nrf_memobj_iovec_get(p_msg, memobj_offset, frame_data_len,
+                                                          iov, ARRAY_SIZE(iov));
+        if (iov_cnt == 0)
+        {
+            break;
+        }
+
+        for (size_t i = 0; i < iov_cnt; i++)
+        {
+            bin_write(p_ctx, iov[i].p_base, iov[i].len);
+            memobj_offset  += iov[i].len;
+            data_len       -= iov[i].len;
+            frame_data_len -= iov[i].len;
+        }
+    }
+
+    if (header.base.generic.type == HEADER_TYPE_STD)
+    {
+        uint32_t args[NRF_LOG_MAX_NUM_OF_ARGS];
+        uint32_t nargs = MIN(header.base.std.nargs, NRF_LOG_MAX_NUM_OF_ARGS);
+
+        nrf_memobj_read(p_msg, args, nargs * sizeof(uint32_t), args_offset);
+        bin_strings_write((char const *)(uint32_t)header.base.std.addr, args, nargs, p_ctx);
+    }
+}
+#else
+/**
+ * @brief Function for formatting a single log entry stored in a message.
+ *
+ * @param p_msg         Pointer to the message.
+ * @param memobj_offset Offset of the entry within the message.
+ * @param defer_flush   If true, formatted output is not flushed after the entry.
+ * @param p_ctx         Pointer to the fprintf context.
+ */
+static void entry_process(nrf_log_entry_t *   p_msg,
+                          size_t              memobj_offset,
+                          bool                defer_flush,
+                          nrf_fprintf_ctx_t * p_ctx)
+{
     nrf_log_str_formatter_entry_params_t params;
 
     nrf_log_header_t header;
-    size_t           memobj_offset = 0;
 
     nrf_memobj_read(p_msg, &header, HEADER_SIZE*sizeof(uint32_t), memobj_offset);
-    memobj_offset = HEADER_SIZE*sizeof(uint32_t);
+    memobj_offset += HEADER_SIZE*sizeof(uint32_t);
 
-    params.timestamp = header.timestamp;
-    params.module_id = header.module_id;
-    params.dropped   = header.dropped;
-    params.use_colors = NRF_LOG_USES_COLORS;
+    params.timestamp   = header.timestamp;
+    params.module_id   = header.module_id;
+    params.dropped     = header.dropped;
+    params.use_colors  = NRF_LOG_USES_COLORS;
+    params.defer_flush = defer_flush;
 
     /*lint -save -e438*/
     if (header.base.generic.type == HEADER_TYPE_STD)
@@ -88,7 +289,7 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
                                   args,
                                   nargs,
                                   &params,
-                                  &fprintf_ctx);
+                                  p_ctx);
 
     }
     else if (header.base.generic.type == HEADER_TYPE_HEXDUMP)
@@ -107,10 +308,84 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
             nrf_log_hexdump_entry_process(data_buf,
                                          chunk_len,
                                          &params,
-                                         &fprintf_ctx);
+                                         p_ctx);
         } while (data_len > 0);
     }
-    nrf_memobj_put(p_msg);
     /*lint -restore*/
 }
+#endif // NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED
+
+void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
+                               nrf_log_entry_t * p_msg,
+                               uint8_t * p_buffer,
+                               uint32_t  length,
+                               nrf_fprintf_fwrite tx_func)
+{
+    nrf_memobj_get(p_msg);
+
+    nrf_fprintf_ctx_t fprintf_ctx = {
+            .p_io_buffer = (char *)p_buffer,
+            .io_buffer_size = length,
+            .io_buffer_cnt = 0,
+            .auto_flush = false,
+            .p_user_ctx = NULL,
+            .fwrite = tx_func
+    };
+
+#if NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED
+    entry_bin_process(p_msg, 0, &fprintf_ctx);
+    nrf_fprintf_buffer_flush(&fprintf_ctx);
+#else
+    entry_process(p_msg, 0, false, &fprintf_ctx);
+#endif
+
+    nrf_memobj_put(p_msg);
+}
+
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+void nrf_log_backend_serial_put_batch(nrf_log_backend_t const * p_backend,
+                                      nrf_log_entry_t * p_batch,
+                                      uint32_t  count,
+                                      uint32_t  accepted,
+                                      uint8_t * p_buffer,
+                                      uint32_t  length,
+                                      nrf_fprintf_fwrite tx_func)
+{
+    nrf_memobj_get(p_batch);
+
+    nrf_fprintf_ctx_t fprintf_ctx = {
+            .p_io_buffer = (char *)p_buffer,
+            .io_buffer_size = length,
+            .io_buffer_cnt = 0,
+            .auto_flush = false,
+            .p_user_ctx = NULL,
+            .fwrite = tx_func
+    };
+
+    nrf_log_header_t header;
+    size_t           memobj_offset = 0;
+    uint32_t         i;
+
+    for (i = 0; i < count; i++)
+    {
+        nrf_memobj_read(p_batch, &header, HEADER_SIZE*sizeof(uint32_t), memobj_offset);
+
+        if (accepted & (1UL << i))
+        {
+            // Output is flushed only when the buffer gets full, so the whole batch is usually
+            // transmitted in a single write.
+#if NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED
+            entry_bin_process(p_batch, memobj_offset, &fprintf_ctx);
+#else
+            entry_process(p_batch, memobj_offset, true, &fprintf_ctx);
+#endif
+        }
+        memobj_offset += nrf_log_batch_entry_size_get(&header);
+    }
+
+    nrf_fprintf_buffer_flush(&fprintf_ctx);
+
+    nrf_memobj_put(p_batch);
+}
+#endif // NRF_LOG_BATCH_DEQUEUE_ENABLED
 #endif //NRF_LOG_ENABLED
@@ -57,6 +57,52 @@
 extern "C" {
 #endif
 
+#ifndef NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED
+#define NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED 0
+#endif
+
+/**
+ * @brief First byte of every binary frame.
+ *
+ * If @ref NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED is set, serial backends do not format logs. Each
+ * log entry is sent as a frame which is decoded on the host using format strings extracted from
+ * the ELF file (see external_tools/nrf_log_decoder). Frame layout:
+ *
+ *    --------------------------------
+ *    | SYNC (1 byte) | LEN (1 byte) |
+ *    |------------------------------|
+ *    |   Logger entry (LEN bytes)   |
+ *    --------------------------------
+ *
+ * The entry is a copy of the logger entry header (see @ref nrf_log_header_t) followed by
+ * arguments (standard entry) or raw data (hexdump entry). All words are little-endian.
+ * The timestamp word is present only if @ref NRF_LOG_USES_TIMESTAMP is set. The host can tell
+ * from LEN and the argument count or data length in the header.
+ *
+ * An entry frame can be followed by data frames (see @ref NRF_LOG_BACKEND_SERIAL_BIN_SYNC_DATA).
+ */
+#define NRF_LOG_BACKEND_SERIAL_BIN_SYNC          0xA5
+
+/**
+ * @brief First byte of a data frame.
+ *
+ * Data frames have the same layout as entry frames and carry data of the preceding entry:
+ * - For a standard entry, one frame for each %s argument, in the order of the arguments. The frame
+ *   contains the string without the terminating null character, truncated to
+ *   @ref NRF_LOG_BACKEND_SERIAL_BIN_FRAME_MAX_LEN bytes. Strings located in RAM can be decoded
+ *   this way.
+ * - For a hexdump entry longer than @ref NRF_LOG_BACKEND_SERIAL_BIN_HEXDUMP_SPLIT_LEN bytes, the
+ *   remaining data, split in frames of up to @ref NRF_LOG_BACKEND_SERIAL_BIN_FRAME_MAX_LEN bytes.
+ *   The length in the entry header is the total length of the hexdump.
+ */
+#define NRF_LOG_BACKEND_SERIAL_BIN_SYNC_DATA     0xA6
+
+/** @brief Maximum length of the data in a binary frame. */
+#define NRF_LOG_BACKEND_SERIAL_BIN_FRAME_MAX_LEN 255
+
+/** @brief Number of hexdump bytes sent in the entry frame if the hexdump is split. */
+#define NRF_LOG_BACKEND_SERIAL_BIN_HEXDUMP_SPLIT_LEN 240
+
 /**
  * @brief A function for processing logger entry with simple serial interface as output.
  *
@@ -68,6 +114,21 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
                                uint32_t  length,
                                nrf_fprintf_fwrite tx_func);
 
+/**
+ * @brief A function for processing a batch of logger entries with simple serial interface as
+ *        output.
+ *
+ * Entries accepted by the backend are formatted into the provided buffer which is passed to
+ * @p tx_func when it gets full and once after the last entry.
+ */
+void nrf_log_backend_serial_put_batch(nrf_log_backend_t const * p_backend,
+                                      nrf_log_entry_t * p_batch,
+                                      uint32_t  count,
+                                      uint32_t  accepted,
+                                      uint8_t * p_buffer,
+                                      uint32_t  length,
+                                      nrf_fprintf_fwrite tx_func);
+
 #endif //NRF_LOG_BACKEND_SERIAL_H
 
 #ifdef __cplusplus
@@ -96,6 +96,17 @@ static void nrf_log_backend_uart_put(nrf_log_backend_t const * p_backend,
                                NRF_LOG_BACKEND_UART_TEMP_BUFFER_SIZE, serial_tx);
 }
 
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+static void nrf_log_backend_uart_put_batch(nrf_log_backend_t const * p_backend,
+                                           nrf_log_entry_t * p_batch,
+                                           uint32_t          count,
+                                           uint32_t          accepted)
+{
+    nrf_log_backend_serial_put_batch(p_backend, p_batch, count, accepted, m_string_buff,
+                                     NRF_LOG_BACKEND_UART_TEMP_BUFFER_SIZE, serial_tx);
+}
+#endif
+
 static void nrf_log_backend_uart_flush(nrf_log_backend_t const * p_backend)
 {
 
@@ -112,5 +123,8 @@ const nrf_log_backend_api_t nrf_log_backend_uart_api = {
         .put       = nrf_log_backend_uart_put,
         .flush     = nrf_log_backend_uart_flush,
         .panic_set = nrf_log_backend_uart_panic_set,
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+        .put_batch = nrf_log_backend_uart_put_batch,
+#endif
 };
 #endif //NRF_MODULE_ENABLED(NRF_LOG) && NRF_MODULE_ENABLED(NRF_LOG_BACKEND_UART)
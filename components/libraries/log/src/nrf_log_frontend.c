@@ -67,6 +67,27 @@ STATIC_ASSERT(IS_POWER_OF_TWO(NRF_LOG_BUFSIZE));
 #warning "NRF_LOG_BUFSIZE too small, significant number of logs may be lost."
 #endif
 
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+#ifndef NRF_LOG_BATCH_MAX_ENTRIES
+#define NRF_LOG_BATCH_MAX_ENTRIES 8
+#endif
+
+#ifndef NRF_LOG_BATCH_MAX_SIZE
+#define NRF_LOG_BATCH_MAX_SIZE 64
+#endif
+
+STATIC_ASSERT((NRF_LOG_BATCH_MAX_ENTRIES > 0) && (NRF_LOG_BATCH_MAX_ENTRIES <= 32));
+#endif
+
+#if NRF_LOG_LOCK_FREE_ENABLED
+/* Oldest entries cannot be overwritten when producers are not serialized because entry which is
+ * being overwritten may still be written by a preempted producer. New entries are dropped instead.
+ */
+#define LOG_OVERFLOW_ENABLED 0
+#else
+#define LOG_OVERFLOW_ENABLED NRF_LOG_ALLOW_OVERFLOW
+#endif
+
 NRF_MEMOBJ_POOL_DEF(log_mempool, NRF_LOG_MSGPOOL_ELEMENT_SIZE, NRF_LOG_MSGPOOL_ELEMENT_COUNT);
 NRF_RINGBUF_DEF(m_log_push_ringbuf, NRF_LOG_STR_PUSH_BUFFER_SIZE);
 
@@ -90,6 +111,12 @@ static uint32_t m_buffer_mask =  NRF_LOG_BUF_WORDS - 1; // Size of buffer (must
  * that logger may break when indexes overflows. However, it is quite unlikely.
  * With rate of 1000 log entries with 2 parameters per second such situation
  * would happen after 12 days.
+ *
+ * @note If @ref NRF_LOG_LOCK_FREE_ENABLED is set, producers reserve space by moving
+ * the write index with compare-and-exchange. Reservation does not initialize the space.
+ * An entry is committed by storing its header as the last step, after a memory barrier.
+ * Until then the header word still holds zero, because dequeue zeroes processed space before
+ * it releases it, and a zero header means that the entry is still being written.
  */
 typedef struct
 {
@@ -102,6 +129,13 @@ typedef struct
     nrf_atomic_flag_t         log_skipping;
     nrf_atomic_flag_t         log_skipped;
     nrf_atomic_u32_t          log_dropped_cnt;
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+    nrf_atomic_u32_t          dropped_total;   // Number of lost entries (never reset)
+    uint32_t                  processed_cnt;   // Number of entries forwarded to backends (never reset)
+    uint32_t                  batch_cnt;       // Number of processed batches (never reset)
+    uint16_t                  batch_max;       // Largest number of entries in a single batch
+    uint32_t                  timestamp_freq;  // Frequency of the timestamp
+#endif
 } log_data_t;
 
 static log_data_t   m_log_data;
@@ -130,6 +164,9 @@ ret_code_t nrf_log_init(nrf_log_timestamp_func_t timestamp_func, uint32_t timest
     {
         nrf_log_str_formatter_timestamp_freq_set(timestamp_freq);
         m_log_data.timestamp_func = timestamp_func;
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+        m_log_data.timestamp_freq = timestamp_freq;
+#endif
     }
 
 #ifdef UNIT_TEST
@@ -315,6 +352,7 @@ nrf_log_severity_t nrf_log_module_filter_get(uint32_t backend_id,
     }
     return severity;
 }
+#if !NRF_LOG_LOCK_FREE_ENABLED
 /**
  * Function examines current header and omits packets which are in progress.
  */
@@ -398,6 +436,7 @@ static uint32_t log_skip(void)
 
     return (uint32_t)dropped;
 }
+#endif // !NRF_LOG_LOCK_FREE_ENABLED
 
 /**
  * @brief Function for getting number of dropped logs. Dropped counter is reset after reading.
@@ -430,12 +469,17 @@ static inline void std_header_set(uint32_t severity_mid,
         m_log_data.buffer[(wr_idx + 2) & mask] = m_log_data.timestamp_func();
     }
 
-    nrf_log_header_t * p_header    = (nrf_log_header_t *)&m_log_data.buffer[wr_idx & mask];
-    p_header->base.std.severity    = severity_mid & NRF_LOG_LEVEL_MASK;
-    p_header->base.std.nargs       = nargs;
-    p_header->base.std.addr        = ((uint32_t)(p_str) & STD_ADDR_MASK);
-    p_header->base.std.type        = HEADER_TYPE_STD;
-    p_header->base.std.in_progress = 0;
+    nrf_log_main_header_t header;
+    header.raw             = 0;
+    header.std.severity    = severity_mid & NRF_LOG_LEVEL_MASK;
+    header.std.nargs       = nargs;
+    header.std.addr        = ((uint32_t)(p_str) & STD_ADDR_MASK);
+    header.std.type        = HEADER_TYPE_STD;
+    header.std.in_progress = 0;
+
+    //Header is stored in a single write which commits the entry.
+    __DMB();
+    m_log_data.buffer[wr_idx & mask] = header.raw;
 }
 
 /**
@@ -449,6 +493,32 @@ static inline void std_header_set(uint32_t severity_mid,
  * @return True if successful allocation, false otherwise.
  *
  */
+#if NRF_LOG_LOCK_FREE_ENABLED
+static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool std)
+{
+    uint32_t req_len = content_len + HEADER_SIZE;
+    uint32_t wr_idx  = m_log_data.wr_idx;
+    UNUSED_PARAMETER(std);
+
+    do
+    {
+        // Read index only moves forward so available space can only be underestimated here.
+        uint32_t available_words = (m_buffer_mask + 1) - (wr_idx - m_log_data.rd_idx);
+        if (req_len > available_words)
+        {
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.log_dropped_cnt, 1));
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.dropped_total, 1));
+#endif
+            return false;
+        }
+    } while (!nrf_atomic_u32_cmp_exch(&m_log_data.wr_idx, &wr_idx, wr_idx + req_len));
+
+    // Header word is zero (cleared when the space was released) until the entry is committed.
+    *p_wr_idx = wr_idx;
+    return true;
+}
+#else
 static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool std)
 {
     uint32_t req_len = content_len + HEADER_SIZE;
@@ -459,6 +529,9 @@ static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool
     while (req_len > available_words)
     {
         UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.log_dropped_cnt, 1));
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.dropped_total, 1));
+#endif
         if (NRF_LOG_ALLOW_OVERFLOW)
         {
             uint32_t dropped_in_skip = log_skip();
@@ -501,6 +574,7 @@ static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool
     CRITICAL_REGION_EXIT();
     return ret;
 }
+#endif // NRF_LOG_LOCK_FREE_ENABLED
 
 char const * nrf_log_push(char * const p_str)
 {
@@ -682,15 +756,17 @@ void nrf_log_frontend_hexdump(uint32_t           severity_mid,
         uint32_t dropped   = dropped_sat16_get();
         m_log_data.buffer[(header_wr_idx + 1) & mask] = module_id | (dropped << 16);
         //Header prepare
-        nrf_log_header_t * p_header = (nrf_log_header_t *)&m_log_data.buffer[header_wr_idx & mask];
-        p_header->base.hexdump.severity    = severity_mid & NRF_LOG_LEVEL_MASK;
-        p_header->base.hexdump.offset      = 0;
-        p_header->base.hexdump.len         = length;
-        p_header->base.hexdump.type        = HEADER_TYPE_HEXDUMP;
-        p_header->base.hexdump.in_progress = 0;
-
-
+        nrf_log_main_header_t header;
+        header.raw                 = 0;
+        header.hexdump.severity    = severity_mid & NRF_LOG_LEVEL_MASK;
+        header.hexdump.offset      = 0;
+        header.hexdump.len         = length;
+        header.hexdump.type        = HEADER_TYPE_HEXDUMP;
+        header.hexdump.in_progress = 0;
 
+        //Header is stored in a single write which commits the entry.
+        __DMB();
+        m_log_data.buffer[header_wr_idx & mask] = header.raw;
     }
 
     if (m_log_data.autoflush)
@@ -713,36 +789,97 @@ bool buffer_is_empty(void)
     return (m_log_data.rd_idx == m_log_data.wr_idx);
 }
 
-bool nrf_log_frontend_dequeue(void)
+/**
+ * @brief Function for checking if a log entry passes filters of the backend.
+ *
+ * @param p_backend Pointer to the backend instance.
+ * @param module_id ID of the module which created the entry.
+ * @param severity  Severity of the entry.
+ *
+ * @return True if the entry should be forwarded to the backend, false otherwise.
+ */
+static bool backend_entry_accepted(nrf_log_backend_t const * p_backend,
+                                   uint32_t                  module_id,
+                                   uint32_t                  severity)
 {
+    bool entry_accepted = false;
+    if (nrf_log_backend_is_enabled(p_backend) == true)
+    {
+        if (NRF_LOG_FILTERS_ENABLED)
+        {
+            uint8_t backend_id = nrf_log_backend_id_get(p_backend);
+            nrf_log_module_filter_data_t * p_module_filter =
+                                     NRF_LOG_FILTER_SECTION_VARS_GET(module_id);
+            uint32_t backend_lvl = BF_GET(p_module_filter->filter_lvls,
+                                          NRF_LOG_LEVEL_BITS,
+                                          (backend_id*NRF_LOG_LEVEL_BITS));
+
+            //Degrade INFO_RAW level to INFO.
+            severity = (severity == NRF_LOG_SEVERITY_INFO_RAW) ?
+                                                     NRF_LOG_SEVERITY_INFO : severity;
+            if (backend_lvl >= severity)
+            {
+                entry_accepted = true;
+            }
+        }
+        else
+        {
+            (void)module_id;
+            (void)severity;
+            entry_accepted = true;
+        }
+    }
+    return entry_accepted;
+}
 
-    if (buffer_is_empty())
+/**
+ * @brief Function for flushing all backends when memory objects are not released on time.
+ */
+static void backends_flush(void)
+{
+    nrf_log_backend_t const * p_backend = m_log_data.p_backend_head;
+    //Flush all backends
+    while (p_backend)
     {
-        return false;
+        nrf_log_backend_flush(p_backend);
+        p_backend = p_backend->p_cb->p_next;
     }
-    m_log_data.log_skipped      = 0;
-    //It has to be ensured that reading rd_idx occurs after skipped flag is cleared.
-    __DSB();
-    uint32_t           rd_idx   = m_log_data.rd_idx;
+    NRF_LOG_WARNING("Backends flushed");
+}
+
+/**
+ * @brief Function for moving the read index to the first entry which can be processed.
+ *
+ * @param[in,out] p_rd_idx Read index.
+ *
+ * @return False if there is no entry to process.
+ */
+static bool first_entry_find(uint32_t * p_rd_idx)
+{
     uint32_t           mask     = m_buffer_mask;
-    nrf_log_header_t * p_header = (nrf_log_header_t *)&m_log_data.buffer[rd_idx & mask];
-    nrf_log_header_t   header;
-    nrf_memobj_t *     p_msg_buf = NULL;
-    size_t             memobj_offset = 0;
-    uint32_t           severity = 0;
+    nrf_log_header_t * p_header = (nrf_log_header_t *)&m_log_data.buffer[*p_rd_idx & mask];
+
+#if NRF_LOG_LOCK_FREE_ENABLED
+    // Entries are committed in any order. Processing stops at the oldest entry which is not
+    // committed yet. Its producer was preempted and the entry is processed once it is completed.
+    bool committed = (p_header->base.generic.type != 0) && (p_header->base.generic.in_progress == 0);
 
+    // Content of the entry is read only after the header which commits it.
+    __DMB();
+    return committed;
+#else
     // Skip any in progress packets.
     do {
-        if (invalid_packets_omit(p_header, &rd_idx) && (m_log_data.log_skipped == 0))
+        if (invalid_packets_omit(p_header, p_rd_idx) && (m_log_data.log_skipped == 0))
         {
             //Check if end of data is not reached.
-            if (rd_idx >= m_log_data.wr_idx)
+            if (*p_rd_idx >= m_log_data.wr_idx)
             {
                 m_log_data.rd_idx     = m_log_data.wr_idx;
                 return false;
             }
             //something was omitted. Point to new header and try again.
-            p_header = (nrf_log_header_t *)&m_log_data.buffer[rd_idx & mask];
+            p_header = (nrf_log_header_t *)&m_log_data.buffer[*p_rd_idx & mask];
         }
         else
         {
@@ -750,6 +887,56 @@ bool nrf_log_frontend_dequeue(void)
         }
     } while (true);
 
+    return true;
+#endif
+}
+
+/**
+ * @brief Function for releasing processed entries.
+ *
+ * @param rd_idx New read index.
+ */
+static void rd_idx_update(uint32_t rd_idx)
+{
+#if NRF_LOG_LOCK_FREE_ENABLED
+    uint32_t mask = m_buffer_mask;
+    uint32_t idx;
+
+    // Space is zeroed before it is released so that stale headers are not taken as committed.
+    for (idx = m_log_data.rd_idx; idx != rd_idx; idx++)
+    {
+        m_log_data.buffer[idx & mask] = 0;
+    }
+    __DMB();
+#endif
+    m_log_data.rd_idx = rd_idx;
+}
+
+/**
+ * @brief Function for processing a single entry from the circular buffer.
+ */
+static bool entry_dequeue(void)
+{
+
+    if (buffer_is_empty())
+    {
+        return false;
+    }
+    m_log_data.log_skipped      = 0;
+    //It has to be ensured that reading rd_idx occurs after skipped flag is cleared.
+    __DSB();
+    uint32_t           rd_idx   = m_log_data.rd_idx;
+    uint32_t           mask     = m_buffer_mask;
+    nrf_log_header_t   header;
+    nrf_memobj_t *     p_msg_buf = NULL;
+    size_t             memobj_offset = 0;
+    uint32_t           severity = 0;
+
+    if (!first_entry_find(&rd_idx))
+    {
+        return false;
+    }
+
     uint32_t i;
     for (i = 0; i < HEADER_SIZE; i++)
     {
@@ -827,7 +1014,7 @@ bool nrf_log_frontend_dequeue(void)
     if (p_msg_buf)
     {
         nrf_log_backend_t const * p_backend = m_log_data.p_backend_head;
-        if (NRF_LOG_ALLOW_OVERFLOW && m_log_data.log_skipped)
+        if (LOG_OVERFLOW_ENABLED && m_log_data.log_skipped)
         {
             // Check if any log was skipped during log processing. Do not forward log if skipping 
             // occured because data may be invalid.
@@ -837,33 +1024,7 @@ bool nrf_log_frontend_dequeue(void)
         {
             while (p_backend)
             {
-                bool entry_accepted = false;
-                if (nrf_log_backend_is_enabled(p_backend) == true)
-                {
-                    if (NRF_LOG_FILTERS_ENABLED)
-                    {
-                        uint8_t backend_id = nrf_log_backend_id_get(p_backend);
-                        nrf_log_module_filter_data_t * p_module_filter =
-                                                 NRF_LOG_FILTER_SECTION_VARS_GET(header.module_id);
-                        uint32_t backend_lvl = BF_GET(p_module_filter->filter_lvls,
-                                                      NRF_LOG_LEVEL_BITS,
-                                                      (backend_id*NRF_LOG_LEVEL_BITS));
-
-                        //Degrade INFO_RAW level to INFO.
-                        severity = (severity == NRF_LOG_SEVERITY_INFO_RAW) ?
-                                                                 NRF_LOG_SEVERITY_INFO : severity;
-                        if (backend_lvl >= severity)
-                        {
-                            entry_accepted = true;
-                        }
-                    }
-                    else
-                    {
-                        (void)severity;
-                        entry_accepted = true;
-                    }
-                }
-                if (entry_accepted)
+                if (backend_entry_accepted(p_backend, header.module_id, severity))
                 {
                     nrf_log_backend_put(p_backend, p_msg_buf);
                 }
@@ -871,8 +1032,11 @@ bool nrf_log_frontend_dequeue(void)
             }
 
             nrf_memobj_put(p_msg_buf);
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+            m_log_data.processed_cnt++;
+#endif
 
-            if (NRF_LOG_ALLOW_OVERFLOW)
+            if (LOG_OVERFLOW_ENABLED)
             {
                 // Read index can be moved forward only if dequeueing process was not interrupt by
                 // skipping procedure. If NRF_LOG_ALLOW_OVERFLOW is set then in case of buffer gets full
@@ -887,26 +1051,344 @@ bool nrf_log_frontend_dequeue(void)
             }
             else
             {
-                m_log_data.rd_idx = rd_idx;
+                rd_idx_update(rd_idx);
             }
         }
     }
     else
     {
         //Could not allocate memobj - backends are not freeing them on time.
+        backends_flush();
+    }
+
+    return buffer_is_empty() ? false : true;
+}
+
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+/**
+ * @brief Function for copying data from the circular buffer to the batch.
+ *
+ * @param p_batch Pointer to the batch.
+ * @param rd_idx  Index of the first word in the circular buffer.
+ * @param len     Number of bytes to copy.
+ * @param offset  Offset in the batch.
+ */
+static void batch_write(nrf_memobj_t * p_batch, uint32_t rd_idx, size_t len, size_t offset)
+{
+    uint32_t mask   = m_buffer_mask;
+    size_t   space0 = sizeof(uint32_t) * (mask + 1 - (rd_idx & mask));
+
+    if (len > space0)
+    {
+        nrf_memobj_write(p_batch, &m_log_data.buffer[rd_idx & mask], space0, offset);
+        nrf_memobj_write(p_batch, &m_log_data.buffer[0], len - space0, offset + space0);
+    }
+    else if (len > 0)
+    {
+        nrf_memobj_write(p_batch, &m_log_data.buffer[rd_idx & mask], len, offset);
+    }
+}
+
+/**
+ * @brief Function for checking if any backend supports batches.
+ */
+static bool batch_backend_present(void)
+{
+    nrf_log_backend_t const * p_backend = m_log_data.p_backend_head;
+
+    while (p_backend)
+    {
+        if (p_backend->p_api->put_batch)
+        {
+            return true;
+        }
+        p_backend = p_backend->p_cb->p_next;
+    }
+    return false;
+}
+
+/**
+ * @brief Function for processing multiple entries from the circular buffer at once.
+ *
+ * Entries are copied into a single memory object which is then passed to every backend which
+ * supports batches. Backends without batch support receive each entry in its own message, as
+ * without batching. An entry which is still in progress ends the batch.
+ */
+static bool batch_dequeue(void)
+{
+    if (!batch_backend_present())
+    {
+        return entry_dequeue();
+    }
+
+    if (buffer_is_empty())
+    {
+        return false;
+    }
+    m_log_data.log_skipped      = 0;
+    //It has to be ensured that reading rd_idx occurs after skipped flag is cleared.
+    __DSB();
+    uint32_t           rd_idx   = m_log_data.rd_idx;
+    uint32_t           mask     = m_buffer_mask;
+
+    if (!first_entry_find(&rd_idx))
+    {
+        return false;
+    }
+
+    // Find out how many complete entries fit into a single batch.
+    uint32_t wr_idx     = m_log_data.wr_idx;
+    uint32_t idx        = rd_idx;
+    uint32_t count      = 0;
+    size_t   batch_size = 0;
+
+    while ((idx < wr_idx) && (count < NRF_LOG_BATCH_MAX_ENTRIES))
+    {
+        nrf_log_main_header_t base;
+        uint32_t              ring_words;
+        size_t                data_len;
+
+        base.raw = m_log_data.buffer[idx & mask];
+        if ((base.generic.in_progress == 1) || (m_log_data.log_skipped != 0))
+        {
+            break;
+        }
+#if NRF_LOG_LOCK_FREE_ENABLED
+        // Content of the entry is read only after the header which commits it.
+        __DMB();
+#endif
+
+        if (base.generic.type == HEADER_TYPE_HEXDUMP)
+        {
+            ring_words = CEIL_DIV(base.hexdump.len, sizeof(uint32_t));
+            data_len   = sizeof(uint32_t) *
+                         CEIL_DIV(MIN(base.hexdump.len, NRF_LOG_MAX_HEXDUMP), sizeof(uint32_t));
+        }
+        else if (base.generic.type == HEADER_TYPE_STD)
+        {
+            ring_words = base.std.nargs;
+            data_len   = sizeof(uint32_t) * MIN(base.std.nargs, NRF_LOG_MAX_NUM_OF_ARGS);
+        }
+        else
+        {
+            //In case of log overflow buffer can contain corrupted data.
+            break;
+        }
+
+        size_t entry_size = HEADER_SIZE*sizeof(uint32_t) + data_len;
+        if ((count > 0) && ((batch_size + entry_size) > NRF_LOG_BATCH_MAX_SIZE))
+        {
+            break;
+        }
+
+        batch_size += entry_size;
+        idx        += HEADER_SIZE + ring_words;
+        count++;
+    }
+
+    if (count == 0)
+    {
+        return buffer_is_empty() ? false : true;
+    }
+
+    nrf_memobj_t * p_batch = nrf_memobj_alloc(&log_mempool, batch_size);
+    if (p_batch == NULL)
+    {
+        //Could not allocate memobj - backends are not freeing them on time.
+        backends_flush();
+        return buffer_is_empty() ? false : true;
+    }
+    nrf_memobj_get(p_batch);
+
+    uint32_t       accepted[NRF_LOG_MAX_BACKENDS] = {0};
+    nrf_memobj_t * p_entries[NRF_LOG_BATCH_MAX_ENTRIES] = {NULL};
+    size_t         batch_offset = 0;
+    uint32_t       i;
+
+    idx = rd_idx;
+    for (i = 0; i < count; i++)
+    {
+        nrf_log_header_t header;
+        uint32_t         ring_words;
+        uint32_t         severity;
+        uint32_t         j;
+
+        for (j = 0; j < HEADER_SIZE; j++)
+        {
+            ((uint32_t*)&header)[j] = m_log_data.buffer[idx++ & mask];
+        }
+
+        if (header.base.generic.type == HEADER_TYPE_HEXDUMP)
+        {
+            ring_words              = CEIL_DIV(header.base.hexdump.len, sizeof(uint32_t));
+            header.base.hexdump.len = MIN(header.base.hexdump.len, NRF_LOG_MAX_HEXDUMP);
+            severity                = header.base.hexdump.severity;
+        }
+        else
+        {
+            ring_words              = header.base.std.nargs;
+            header.base.std.nargs   = MIN(header.base.std.nargs, NRF_LOG_MAX_NUM_OF_ARGS);
+            severity                = header.base.std.severity;
+        }
+
+        // Entry may have been overwritten since the batch was sized. Such batch is discarded.
+        size_t entry_size = nrf_log_batch_entry_size_get(&header);
+        if ((m_log_data.log_skipped != 0) || ((batch_offset + entry_size) > batch_size))
+        {
+            count = i;
+            break;
+        }
+
+        bool entry_accepted = false;
         nrf_log_backend_t const * p_backend = m_log_data.p_backend_head;
-        //Flush all backends
         while (p_backend)
         {
-            nrf_log_backend_flush(p_backend);
+            if (backend_entry_accepted(p_backend, header.module_id, severity))
+            {
+                accepted[nrf_log_backend_id_get(p_backend)] |= (1UL << i);
+                entry_accepted |= (p_backend->p_api->put_batch == NULL);
+            }
             p_backend = p_backend->p_cb->p_next;
         }
-        NRF_LOG_WARNING("Backends flushed");
+
+        nrf_memobj_write(p_batch, &header, HEADER_SIZE*sizeof(uint32_t), batch_offset);
+        batch_write(p_batch,
+                    idx,
+                    entry_size - HEADER_SIZE*sizeof(uint32_t),
+                    batch_offset + HEADER_SIZE*sizeof(uint32_t));
+
+        // Backends without batch support get the entry copied from the circular buffer.
+        if (entry_accepted)
+        {
+            p_entries[i] = nrf_memobj_alloc(&log_mempool, entry_size);
+            if (p_entries[i])
+            {
+                nrf_memobj_get(p_entries[i]);
+                nrf_memobj_write(p_entries[i], &header, HEADER_SIZE*sizeof(uint32_t), 0);
+                batch_write(p_entries[i],
+                            idx,
+                            entry_size - HEADER_SIZE*sizeof(uint32_t),
+                            HEADER_SIZE*sizeof(uint32_t));
+            }
+            else
+            {
+                UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.dropped_total, 1));
+            }
+        }
+
+        batch_offset += entry_size;
+        idx          += ring_words;
+    }
+
+    if (LOG_OVERFLOW_ENABLED && m_log_data.log_skipped)
+    {
+        // Check if any log was skipped during log processing. Do not forward logs if skipping
+        // occured because data may be invalid.
+        for (i = 0; i < count; i++)
+        {
+            if (p_entries[i])
+            {
+                nrf_memobj_put(p_entries[i]);
+            }
+        }
+        nrf_memobj_put(p_batch);
+    }
+    else
+    {
+        nrf_log_backend_t const * p_backend;
+
+        for (i = 0; i < count; i++)
+        {
+            if (p_entries[i] == NULL)
+            {
+                continue;
+            }
+            for (p_backend = m_log_data.p_backend_head; p_backend; p_backend = p_backend->p_cb->p_next)
+            {
+                if ((p_backend->p_api->put_batch == NULL) &&
+                    (accepted[nrf_log_backend_id_get(p_backend)] & (1UL << i)))
+                {
+                    nrf_log_backend_put(p_backend, p_entries[i]);
+                }
+            }
+            nrf_memobj_put(p_entries[i]);
+        }
+
+        for (p_backend = m_log_data.p_backend_head; p_backend; p_backend = p_backend->p_cb->p_next)
+        {
+            uint32_t backend_accepted = accepted[nrf_log_backend_id_get(p_backend)];
+            if ((p_backend->p_api->put_batch != NULL) && backend_accepted)
+            {
+                nrf_log_backend_put_batch(p_backend, p_batch, count, backend_accepted);
+            }
+        }
+
+        nrf_memobj_put(p_batch);
+
+        m_log_data.processed_cnt += count;
+        m_log_data.batch_cnt++;
+        m_log_data.batch_max = (uint16_t)MAX(m_log_data.batch_max, count);
+
+        if (LOG_OVERFLOW_ENABLED)
+        {
+            // Read index can be moved forward only if dequeueing process was not interrupted by
+            // skipping procedure.
+            CRITICAL_REGION_ENTER();
+            if (m_log_data.log_skipped == 0)
+            {
+                m_log_data.rd_idx = idx;
+            }
+            CRITICAL_REGION_EXIT();
+        }
+        else
+        {
+            rd_idx_update(idx);
+        }
     }
 
     return buffer_is_empty() ? false : true;
 }
 
+void nrf_log_frontend_stats_get(nrf_log_frontend_stats_t * p_stats)
+{
+    ASSERT(p_stats);
+
+    // The previous statistics of the caller are the baseline of the rate.
+    uint32_t processed      = m_log_data.processed_cnt;
+    uint32_t prev_processed = p_stats->processed;
+    uint32_t prev_timestamp = p_stats->timestamp;
+
+    p_stats->processed = processed;
+    p_stats->dropped   = m_log_data.dropped_total;
+    p_stats->batches   = m_log_data.batch_cnt;
+    p_stats->max_batch = m_log_data.batch_max;
+    p_stats->rate      = 0;
+    p_stats->timestamp = 0;
+
+    if (NRF_LOG_USES_TIMESTAMP && (m_log_data.timestamp_func != NULL))
+    {
+        uint32_t timestamp = m_log_data.timestamp_func();
+        uint32_t ticks     = timestamp - prev_timestamp;
+
+        if (ticks > 0)
+        {
+            p_stats->rate = (uint32_t)(((uint64_t)(processed - prev_processed) *
+                                        m_log_data.timestamp_freq) / ticks);
+        }
+        p_stats->timestamp = timestamp;
+    }
+}
+#endif // NRF_LOG_BATCH_DEQUEUE_ENABLED
+
+bool nrf_log_frontend_dequeue(void)
+{
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+    return batch_dequeue();
+#else
+    return entry_dequeue();
+#endif
+}
+
 static int32_t backend_id_assign(void)
 {
     int32_t candidate_id;
@@ -1191,6 +1673,36 @@ static void log_backend_status(nrf_cli_t const * p_cli, size_t argc, char **argv
 }
 
 
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+static void log_cmd_stats(nrf_cli_t const * p_cli, size_t argc, char **argv)
+{
+    UNUSED_PARAMETER(argc);
+    UNUSED_PARAMETER(argv);
+
+    if (nrf_cli_help_requested(p_cli))
+    {
+        nrf_cli_help_print(p_cli, NULL, 0);
+        return;
+    }
+
+    // Kept between calls, so that the rate covers the time since the previous command.
+    static nrf_log_frontend_stats_t stats;
+    nrf_log_frontend_stats_get(&stats);
+
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL,
+                    "Processed: %u\r\n"
+                    "Dropped: %u\r\n"
+                    "Batches: %u (max %u entries)\r\n"
+                    "Rate: %u logs/s\r\n",
+                    stats.processed,
+                    stats.dropped,
+                    stats.batches,
+                    stats.max_batch,
+                    stats.rate);
+}
+#endif
+
+
 static bool module_id_get(const char * p_name, uint32_t * p_id)
 {
     uint32_t modules_cnt = nrf_log_module_cnt_get();
@@ -1561,6 +2073,9 @@ NRF_CLI_CREATE_STATIC_SUBCMD_SET(m_sub_log_stat)
     NRF_CLI_CMD(go, NULL, "Resume logging", log_self_go),
     NRF_CLI_CMD(halt, NULL, "Halt logging", log_self_halt),
     NRF_CLI_CMD(list_backends, NULL, "Lists logger backends.", log_cmd_backends_list),
+#if NRF_LOG_BATCH_DEQUEUE_ENABLED
+    NRF_CLI_CMD(stats, NULL, "Logger processing statistics", log_cmd_stats),
+#endif
     NRF_CLI_CMD(status, NULL, "Logger status", log_self_status),
     NRF_CLI_SUBCMD_SET_END
 };
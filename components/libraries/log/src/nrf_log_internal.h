@@ -85,6 +85,14 @@
 #define NRF_LOG_FILTERS_ENABLED   0
 #endif
 
+#ifndef NRF_LOG_BATCH_DEQUEUE_ENABLED
+#define NRF_LOG_BATCH_DEQUEUE_ENABLED 0
+#endif
+
+#ifndef NRF_LOG_LOCK_FREE_ENABLED
+#define NRF_LOG_LOCK_FREE_ENABLED 0
+#endif
+
 #ifndef NRF_LOG_MODULE_NAME
     #define NRF_LOG_MODULE_NAME app
 #endif
@@ -405,6 +413,25 @@ typedef struct
 #define HEADER_SIZE         (sizeof(nrf_log_header_t)/sizeof(uint32_t) - \
                 (NRF_LOG_USES_TIMESTAMP ? 0 : 1))
 
+/**
+ * @brief Function for getting the size of a log entry stored in a batch.
+ *
+ * In a batch, entries are stored one after another. Each entry consists of a header followed
+ * by arguments (standard entry) or data padded to the word boundary (hexdump entry).
+ *
+ * @param p_header Pointer to the header of the entry.
+ *
+ * @return Size of the entry (in bytes), including the header.
+ */
+__STATIC_INLINE uint32_t nrf_log_batch_entry_size_get(nrf_log_header_t const * p_header)
+{
+    uint32_t payload_words = (p_header->base.generic.type == HEADER_TYPE_HEXDUMP) ?
+                             CEIL_DIV(p_header->base.hexdump.len, sizeof(uint32_t)) :
+                             p_header->base.std.nargs;
+
+    return (HEADER_SIZE + payload_words) * sizeof(uint32_t);
+}
+
 /**
  * @brief A function for logging raw string.
  *
@@ -147,7 +147,11 @@ static void postfix_process(nrf_log_str_formatter_entry_params_t * p_params,
     {
         nrf_fprintf(p_ctx, "\r\n");
     }
-    nrf_fprintf_buffer_flush(p_ctx);
+
+    if (!p_params->defer_flush)
+    {
+        nrf_fprintf_buffer_flush(p_ctx);
+    }
 }
 
 void nrf_log_std_entry_process(char const * p_str,
@@ -430,8 +430,39 @@ NRF_LOG_MODULE_REGISTER();
 #define BLOCK_CAT_XXL                  6                                                            /**< Extra Extra Large category identifier. */
 
 #define BITMAP_SIZE                    32                                                           /**< Bitmap size for each word used to contain block information. */
+
+#if MEM_MANAGER_CONSTANT_TIME_ENABLED
+
+/**@brief Number of bitmap words used by a block category. Every category starts at a word boundary. */
+#define BLOCK_CAT_WORDS(COUNT)         CEIL_DIV(COUNT, BITMAP_SIZE)
+
+#define XXSMALL_WORD_START             0                                                                                   /**< First bitmap word of XXSmall blocks. */
+#define XSMALL_WORD_START              (XXSMALL_WORD_START + BLOCK_CAT_WORDS(MEMORY_MANAGER_XXSMALL_BLOCK_COUNT))          /**< First bitmap word of XSmall blocks. */
+#define SMALL_WORD_START               (XSMALL_WORD_START  + BLOCK_CAT_WORDS(MEMORY_MANAGER_XSMALL_BLOCK_COUNT))           /**< First bitmap word of Small blocks. */
+#define MEDIUM_WORD_START              (SMALL_WORD_START   + BLOCK_CAT_WORDS(MEMORY_MANAGER_SMALL_BLOCK_COUNT))            /**< First bitmap word of Medium blocks. */
+#define LARGE_WORD_START               (MEDIUM_WORD_START  + BLOCK_CAT_WORDS(MEMORY_MANAGER_MEDIUM_BLOCK_COUNT))           /**< First bitmap word of Large blocks. */
+#define XLARGE_WORD_START              (LARGE_WORD_START   + BLOCK_CAT_WORDS(MEMORY_MANAGER_LARGE_BLOCK_COUNT))            /**< First bitmap word of XLarge blocks. */
+#define XXLARGE_WORD_START             (XLARGE_WORD_START  + BLOCK_CAT_WORDS(MEMORY_MANAGER_XLARGE_BLOCK_COUNT))           /**< First bitmap word of XXLarge blocks. */
+#define BLOCK_BITMAP_ARRAY_SIZE        (XXLARGE_WORD_START + BLOCK_CAT_WORDS(MEMORY_MANAGER_XXLARGE_BLOCK_COUNT))          /**< Determines number of blocks needed for book keeping availability status of all blocks. */
+
+/**@brief Maximum number of blocks in a category. Each bitmap word of a category is represented
+ *        by one bit of the category summary word. */
+#define BLOCK_CAT_MAX_COUNT            (BITMAP_SIZE * BITMAP_SIZE)
+
+STATIC_ASSERT(MEMORY_MANAGER_XXSMALL_BLOCK_COUNT <= BLOCK_CAT_MAX_COUNT);
+STATIC_ASSERT(MEMORY_MANAGER_XSMALL_BLOCK_COUNT  <= BLOCK_CAT_MAX_COUNT);
+STATIC_ASSERT(MEMORY_MANAGER_SMALL_BLOCK_COUNT   <= BLOCK_CAT_MAX_COUNT);
+STATIC_ASSERT(MEMORY_MANAGER_MEDIUM_BLOCK_COUNT  <= BLOCK_CAT_MAX_COUNT);
+STATIC_ASSERT(MEMORY_MANAGER_LARGE_BLOCK_COUNT   <= BLOCK_CAT_MAX_COUNT);
+STATIC_ASSERT(MEMORY_MANAGER_XLARGE_BLOCK_COUNT  <= BLOCK_CAT_MAX_COUNT);
+STATIC_ASSERT(MEMORY_MANAGER_XXLARGE_BLOCK_COUNT <= BLOCK_CAT_MAX_COUNT);
+
+#else
+
 #define BLOCK_BITMAP_ARRAY_SIZE        CEIL_DIV(TOTAL_BLOCK_COUNT, BITMAP_SIZE)                     /**< Determines number of blocks needed for book keeping availability status of all blocks. */
 
+#endif // MEM_MANAGER_CONSTANT_TIME_ENABLED
+
 
 /**@brief Lookup table for maximum memory size per block category. */
 static const uint32_t m_block_size[BLOCK_CAT_COUNT] =
@@ -484,6 +515,26 @@ static const uint32_t m_block_mem_start[BLOCK_CAT_COUNT] =
 static uint8_t  m_memory[TOTAL_MEMORY_SIZE];                                                        /**< Memory managed by the module. */
 static uint32_t m_mem_pool[BLOCK_BITMAP_ARRAY_SIZE];                                                /**< Bitmap used for book-keeping availability of all blocks managed by the module.  */
 
+#if MEM_MANAGER_CONSTANT_TIME_ENABLED
+
+/**@brief Lookup table for first bitmap word for each block category. */
+static const uint32_t m_block_word_start[BLOCK_CAT_COUNT] =
+{
+    XXSMALL_WORD_START,
+    XSMALL_WORD_START,
+    SMALL_WORD_START,
+    MEDIUM_WORD_START,
+    LARGE_WORD_START,
+    XLARGE_WORD_START,
+    XXLARGE_WORD_START
+};
+
+/**@brief Summary of the bitmap for each block category. Bit N is set if word N of the category
+ *        has at least one free block. */
+static uint32_t m_mem_summary[BLOCK_CAT_COUNT];
+
+#endif // MEM_MANAGER_CONSTANT_TIME_ENABLED
+
 #if defined(MEM_MANAGER_ENABLE_DIAGNOSTICS) && (MEM_MANAGER_ENABLE_DIAGNOSTICS == 1)
 
 uint8_t* mem_begin = &m_memory[0];
@@ -550,6 +601,23 @@ static bool     m_module_initialized = false;
 #endif // MEM_MANAGER_DISABLE_API_PARAM_CHECK
 
 
+/**@brief Function to get the category of the block of size 'size' or block number 'block_index'.*/
+static __INLINE uint32_t get_block_cat(uint32_t size, uint32_t block_index)
+{
+    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
+    {
+        if (((size != 0) && (size <= m_block_size[block_cat]) &&
+            (m_block_end[block_cat] != m_block_start[block_cat])) ||
+            (block_index < m_block_end[block_cat]))
+        {
+            return block_cat;
+        }
+    }
+
+    return 0;
+}
+
+
 /**@brief Function to get X and Y coordinates.
  *
  * @details Function to get X and Y co-ordinates for the block identified by index.
@@ -561,32 +629,23 @@ static bool     m_module_initialized = false;
  */
 static __INLINE void get_block_coordinates(uint32_t block_index, uint32_t * p_x, uint32_t * p_y)
 {
+#if MEM_MANAGER_CONSTANT_TIME_ENABLED
+    // Blocks of each category start at a word boundary.
+    const uint32_t block_cat = get_block_cat(0, block_index);
+    const uint32_t offset    = block_index - m_block_start[block_cat];
+    const uint32_t x         = m_block_word_start[block_cat] + offset / BITMAP_SIZE;
+    const uint32_t y         = offset % BITMAP_SIZE;
+#else
     // Determine position of the block in the bitmap.
     // X determines relevant word for the block. Y determines the actual bit in the word.
     const uint32_t x = block_index / BITMAP_SIZE;
     const uint32_t y = (block_index - x * BITMAP_SIZE);
+#endif // MEM_MANAGER_CONSTANT_TIME_ENABLED
 
     (*p_x) = x;
     (*p_y) = y;
 }
 
-
-/**@brief Function to get the category of the block of size 'size' or block number 'block_index'.*/
-static __INLINE uint32_t get_block_cat(uint32_t size, uint32_t block_index)
-{
-    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
-    {
-        if (((size != 0) && (size <= m_block_size[block_cat]) &&
-            (m_block_end[block_cat] != m_block_start[block_cat])) ||
-            (block_index < m_block_end[block_cat]))
-        {
-            return block_cat;
-        }
-    }
-
-    return 0;
-}
-
 /**@brief Initializes the block by setting it to be free. */
 static void block_init (uint32_t block_index)
 {
@@ -608,6 +667,12 @@ static void block_init (uint32_t block_index)
 
     // Set bit related to the block to indicate that the block is free.
     SET_BIT(m_mem_pool[x], y);
+
+#if MEM_MANAGER_CONSTANT_TIME_ENABLED
+    // Word has at least one free block now.
+    const uint32_t cat = get_block_cat(0, block_index);
+    SET_BIT(m_mem_summary[cat], x - m_block_word_start[cat]);
+#endif // MEM_MANAGER_CONSTANT_TIME_ENABLED
 }
 
 
@@ -651,6 +716,15 @@ static void block_allocate(uint32_t block_index)
 
     CLR_BIT(m_mem_pool[x], y);
 
+#if MEM_MANAGER_CONSTANT_TIME_ENABLED
+    if (m_mem_pool[x] == 0)
+    {
+        // No free block left in the word.
+        const uint32_t cat = get_block_cat(0, block_index);
+        CLR_BIT(m_mem_summary[cat], x - m_block_word_start[cat]);
+    }
+#endif // MEM_MANAGER_CONSTANT_TIME_ENABLED
+
 #if defined(MEM_MANAGER_ENABLE_DIAGNOSTICS) && (MEM_MANAGER_ENABLE_DIAGNOSTICS == 1)
     // Update statistics: Add to current count in block.
     uint32_t block_cat = get_block_cat(0, block_index);
@@ -666,6 +740,128 @@ static void block_allocate(uint32_t block_index)
 }
 
 
+#if MEM_MANAGER_CONSTANT_TIME_ENABLED
+
+/**@brief Function to find a free block of category 'block_cat' or of the larger one.
+ *
+ * @details The summary word of the category points to a bitmap word with a free block, so the
+ *          search takes at most one lookup per category.
+ *
+ * @param[in]  block_cat      Category of the block.
+ * @param[out] p_memory_index Index of the block memory in the managed memory.
+ *
+ * @return Index of the free block or TOTAL_BLOCK_COUNT if there is no free block.
+ */
+static uint32_t free_block_find(uint32_t block_cat, uint32_t * p_memory_index)
+{
+    for (; block_cat < BLOCK_CAT_COUNT; block_cat++)
+    {
+        const uint32_t summary = m_mem_summary[block_cat];
+
+        if (summary != 0)
+        {
+            // Lowest set bit, to allocate blocks in the same order as the linear search.
+            const uint32_t word   = __CLZ(__RBIT(summary));
+            const uint32_t bit    = __CLZ(__RBIT(m_mem_pool[m_block_word_start[block_cat] + word]));
+            const uint32_t offset = word * BITMAP_SIZE + bit;
+
+            (*p_memory_index) = m_block_mem_start[block_cat] + offset * m_block_size[block_cat];
+
+            return m_block_start[block_cat] + offset;
+        }
+    }
+
+    return TOTAL_BLOCK_COUNT;
+}
+
+
+/**@brief Function to get the index of the block that starts at 'p_mem'.
+ *
+ * @return Index of the block or TOTAL_BLOCK_COUNT if 'p_mem' is not a start of a block.
+ */
+static uint32_t block_index_get(void const * p_mem)
+{
+    const uintptr_t memory_index = (uintptr_t)p_mem - (uintptr_t)m_memory;
+
+    if ((uintptr_t)p_mem < (uintptr_t)m_memory)
+    {
+        return TOTAL_BLOCK_COUNT;
+    }
+
+    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
+    {
+        const uint32_t block_count = m_block_end[block_cat] - m_block_start[block_cat];
+        const uint32_t mem_start   = m_block_mem_start[block_cat];
+
+        if (memory_index < (mem_start + block_count * m_block_size[block_cat]))
+        {
+            const uint32_t offset = memory_index - mem_start;
+
+            if ((offset % m_block_size[block_cat]) != 0)
+            {
+                break;
+            }
+
+            return m_block_start[block_cat] + offset / m_block_size[block_cat];
+        }
+    }
+
+    return TOTAL_BLOCK_COUNT;
+}
+
+#else
+
+/**@brief Function to find a free block of category 'block_cat' or of the larger one.
+ *
+ * @param[in]  block_cat      Category of the block.
+ * @param[out] p_memory_index Index of the block memory in the managed memory.
+ *
+ * @return Index of the free block or TOTAL_BLOCK_COUNT if there is no free block.
+ */
+static uint32_t free_block_find(uint32_t block_cat, uint32_t * p_memory_index)
+{
+    uint32_t block_index  = m_block_start[block_cat];
+    uint32_t memory_index = m_block_mem_start[block_cat];
+
+    for (; block_index < TOTAL_BLOCK_COUNT; block_index++)
+    {
+        if (is_block_free(block_index) == true)
+        {
+            break;
+        }
+        memory_index += get_block_size(block_index);
+    }
+
+    (*p_memory_index) = memory_index;
+
+    return block_index;
+}
+
+
+/**@brief Function to get the index of the block that starts at 'p_mem'.
+ *
+ * @return Index of the block or TOTAL_BLOCK_COUNT if 'p_mem' is not a start of a block.
+ */
+static uint32_t block_index_get(void const * p_mem)
+{
+    uint32_t index;
+    uint32_t memory_index = 0;
+
+    for (index = 0; index < TOTAL_BLOCK_COUNT; index++)
+    {
+        if (&m_memory[memory_index] == p_mem)
+        {
+            break;
+        }
+        memory_index += get_block_size(index);
+    }
+
+    return index;
+}
+
+#endif // MEM_MANAGER_CONSTANT_TIME_ENABLED
+
+
 uint32_t nrf_mem_init(void)
 {
     NRF_LOG_DEBUG(">> %s.", (uint32_t)__func__);
@@ -712,41 +908,36 @@ uint32_t nrf_mem_reserve(uint8_t ** pp_buffer, uint32_t * p_size)
     MM_MUTEX_LOCK();
 
     const uint32_t block_cat    = get_block_cat(requested_size, TOTAL_BLOCK_COUNT);
-    uint32_t       block_index  = m_block_start[block_cat];
-    uint32_t       memory_index = m_block_mem_start[block_cat];
+    uint32_t       memory_index = 0;
     uint32_t       err_code     = (NRF_ERROR_NO_MEM | NRF_ERROR_MEMORY_MANAGER_ERR_BASE);
 
     NRF_LOG_DEBUG("Start index for the pool = 0x%08lX, total block count 0x%08X",
-           block_index,
+           m_block_start[block_cat],
            TOTAL_BLOCK_COUNT);
 
-    for (; block_index < TOTAL_BLOCK_COUNT; block_index++)
+    const uint32_t block_index  = free_block_find(block_cat, &memory_index);
+
+    if (block_index < TOTAL_BLOCK_COUNT)
     {
         uint32_t block_size = get_block_size(block_index);
 
-        if (is_block_free(block_index) == true)
-        {
-            NRF_LOG_DEBUG("Reserving block 0x%08lX", block_index);
-
-            // Search succeeded, found free block.
-            err_code     = NRF_SUCCESS;
+        NRF_LOG_DEBUG("Reserving block 0x%08lX", block_index);
 
-            // Allocate block.
-            block_allocate(block_index);
+        // Search succeeded, found free block.
+        err_code     = NRF_SUCCESS;
 
-            (*pp_buffer) = &m_memory[memory_index];
-            (*p_size)    = block_size;
+        // Allocate block.
+        block_allocate(block_index);
 
-        #if defined(MEM_MANAGER_ENABLE_DIAGNOSTICS) && (MEM_MANAGER_ENABLE_DIAGNOSTICS == 1)
-            (*p_min_size) = MIN((*p_min_size), requested_size);
-            (*p_max_size) = MAX((*p_max_size), requested_size);
-        #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+        (*pp_buffer) = &m_memory[memory_index];
+        (*p_size)    = block_size;
 
-            break;
-        }
-        memory_index += block_size;
+    #if defined(MEM_MANAGER_ENABLE_DIAGNOSTICS) && (MEM_MANAGER_ENABLE_DIAGNOSTICS == 1)
+        (*p_min_size) = MIN((*p_min_size), requested_size);
+        (*p_max_size) = MAX((*p_max_size), requested_size);
+    #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
     }
-    if (err_code != NRF_SUCCESS)
+    else
     {
         NRF_LOG_ERROR("Memory reservation failed: err_code %d, memory %p, size %d!",
                 err_code,
@@ -814,19 +1005,13 @@ void nrf_free(void * p_mem)
 
     MM_MUTEX_LOCK();
 
-    uint32_t index;
-    uint32_t memory_index = 0;
+    const uint32_t index = block_index_get(p_mem);
 
-    for (index = 0; index < TOTAL_BLOCK_COUNT; index++)
+    if ((index < TOTAL_BLOCK_COUNT) && (is_block_free(index) == false))
     {
-        if (&m_memory[memory_index] == p_mem)
-        {
-            // Found a free block of memory, assign.
-            NRF_LOG_DEBUG("<< Freeing block %d.", index);
-            block_init(index);
-            break;
-        }
-        memory_index += get_block_size(index);
+        // Found a free block of memory, assign.
+        NRF_LOG_DEBUG("<< Freeing block %d.", index);
+        block_init(index);
     }
 
     MM_MUTEX_UNLOCK();
@@ -56,6 +56,11 @@
  * To use fewer than seven buffer pools, do not define the count for the unwanted block
  * or explicitly set it to zero. At least one block category must be configured
  * for this module to function as expected.
+ *
+ * By default, a free block is found by scanning all blocks, so the time needed to allocate or free
+ * memory grows with the pool size. If @c MEM_MANAGER_CONSTANT_TIME_ENABLED is set, the module keeps
+ * a summary bitmap for each block category and finds a free block or the block of a given
+ * address in constant time.
  */
 
 #ifndef MEM_MANAGER_H__
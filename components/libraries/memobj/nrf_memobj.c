@@ -172,6 +172,47 @@ void nrf_memobj_put(nrf_memobj_t * p_obj)
     }
 }
 
+size_t nrf_memobj_size_get(nrf_memobj_t const * p_obj)
+{
+    ASSERT(p_obj);
+
+    memobj_head_t const * p_head = (memobj_head_t const *)p_obj;
+
+    return (p_head->head_header.data.fields.chunk_size *
+            p_head->head_header.data.fields.chunk_cnt) -
+            sizeof(memobj_head_header_fields_t);
+}
+
+/**
+ * @brief Function for finding the chunk which holds the given offset.
+ *
+ * @param[in]  p_obj          Pointer to memory object.
+ * @param[in]  offset         Offset within the memory object.
+ * @param[out] p_chunk_offset Offset of the data within the chunk.
+ *
+ * @return Pointer to the chunk.
+ */
+static memobj_elem_t * memobj_chunk_find(nrf_memobj_t const * p_obj,
+                                         size_t               offset,
+                                         size_t *             p_chunk_offset)
+{
+    memobj_head_t const * p_head       = (memobj_head_t const *)p_obj;
+    memobj_elem_t *       p_curr_chunk = (memobj_elem_t *)p_obj;
+    size_t                chunk_size   = p_head->head_header.data.fields.chunk_size;
+    size_t                chunk_idx    = (offset + sizeof(memobj_head_header_fields_t)) / chunk_size;
+
+    *p_chunk_offset = (offset + sizeof(memobj_head_header_fields_t)) % chunk_size;
+
+    //Move to the first chunk to be used
+    while (chunk_idx > 0)
+    {
+        p_curr_chunk = p_curr_chunk->header.p_next;
+        chunk_idx--;
+    }
+
+    return p_curr_chunk;
+}
+
 static void memobj_op(nrf_memobj_t * p_obj,
                       void *         p_data,
                       size_t *       p_len,
@@ -182,33 +223,23 @@ static void memobj_op(nrf_memobj_t * p_obj,
     ASSERT(p_obj);
 
     memobj_head_t * p_head       = (memobj_head_t *)p_obj;
-    memobj_elem_t * p_curr_chunk = (memobj_elem_t *)p_obj;
+    memobj_elem_t * p_curr_chunk;
     size_t          obj_capacity;
     size_t          chunk_size;
-    size_t          chunk_idx;
     size_t          chunk_offset;
     size_t          len;
 
-    obj_capacity = (p_head->head_header.data.fields.chunk_size *
-                    p_head->head_header.data.fields.chunk_cnt) -
-                    sizeof(memobj_head_header_fields_t);
+    obj_capacity = nrf_memobj_size_get(p_obj);
 
     ASSERT(offset < obj_capacity);
 
     chunk_size   = p_head->head_header.data.fields.chunk_size;
-    chunk_idx    = (offset + sizeof(memobj_head_header_fields_t)) / chunk_size;
-    chunk_offset = (offset + sizeof(memobj_head_header_fields_t)) % chunk_size;
     len          = ((*p_len + offset) > obj_capacity) ? obj_capacity - offset : *p_len;
 
     //Return number of available bytes
     *p_len = len;
 
-    //Move to the first chunk to be used
-    while (chunk_idx > 0)
-    {
-        p_curr_chunk = p_curr_chunk->header.p_next;
-        chunk_idx--;
-    }
+    p_curr_chunk = memobj_chunk_find(p_obj, offset, &chunk_offset);
 
     size_t user_mem_offset  = 0;
     size_t curr_cpy_size    = chunk_size - chunk_offset;
@@ -256,3 +287,112 @@ void nrf_memobj_read(nrf_memobj_t * p_obj,
     ASSERT(op_len == len);
 
 }
+
+size_t nrf_memobj_iovec_get(nrf_memobj_t const * p_obj,
+                            size_t               offset,
+                            size_t               len,
+                            nrf_memobj_iovec_t * p_iov,
+                            size_t               iov_cnt)
+{
+    ASSERT(p_obj);
+    ASSERT(p_iov || (iov_cnt == 0));
+
+    memobj_head_t const * p_head = (memobj_head_t const *)p_obj;
+    size_t                obj_capacity = nrf_memobj_size_get(p_obj);
+    size_t                chunk_size   = p_head->head_header.data.fields.chunk_size;
+    size_t                chunk_offset;
+    size_t                cnt = 0;
+
+    if ((offset >= obj_capacity) || (len == 0))
+    {
+        return 0;
+    }
+
+    len = ((len + offset) > obj_capacity) ? obj_capacity - offset : len;
+
+    memobj_elem_t * p_curr_chunk = memobj_chunk_find(p_obj, offset, &chunk_offset);
+
+    while ((len > 0) && (cnt < iov_cnt))
+    {
+        size_t span_len = MIN(chunk_size - chunk_offset, len);
+
+        p_iov[cnt].p_base = &p_curr_chunk->data[chunk_offset];
+        p_iov[cnt].len    = span_len;
+        cnt++;
+
+        chunk_offset = 0;
+        p_curr_chunk = p_curr_chunk->header.p_next;
+        len         -= span_len;
+    }
+
+    return cnt;
+}
+
+void nrf_memobj_view_init(nrf_memobj_view_t * p_view,
+                          nrf_memobj_t *      p_obj,
+                          size_t              offset,
+                          size_t              len)
+{
+    ASSERT(p_view);
+    ASSERT(p_obj);
+    ASSERT((offset + len) <= nrf_memobj_size_get(p_obj));
+
+    nrf_memobj_get(p_obj);
+
+    p_view->p_obj  = p_obj;
+    p_view->offset = offset;
+    p_view->len    = len;
+}
+
+void nrf_memobj_view_slice(nrf_memobj_view_t *       p_view,
+                           nrf_memobj_view_t const * p_parent,
+                           size_t                    offset,
+                           size_t                    len)
+{
+    ASSERT(p_parent);
+    ASSERT((offset + len) <= p_parent->len);
+
+    nrf_memobj_view_init(p_view, p_parent->p_obj, p_parent->offset + offset, len);
+}
+
+void nrf_memobj_view_release(nrf_memobj_view_t * p_view)
+{
+    ASSERT(p_view);
+
+    if (p_view->p_obj != NULL)
+    {
+        nrf_memobj_put(p_view->p_obj);
+        p_view->p_obj = NULL;
+        p_view->len   = 0;
+    }
+}
+
+size_t nrf_memobj_view_iovec_get(nrf_memobj_view_t const * p_view,
+                                 size_t                    offset,
+                                 nrf_memobj_iovec_t *      p_iov,
+                                 size_t                    iov_cnt)
+{
+    ASSERT(p_view);
+
+    if (offset >= p_view->len)
+    {
+        return 0;
+    }
+
+    return nrf_memobj_iovec_get(p_view->p_obj,
+                                p_view->offset + offset,
+                                p_view->len - offset,
+                                p_iov,
+                                iov_cnt);
+}
+
+void nrf_memobj_view_read(nrf_memobj_view_t const * p_view,
+                          void *                    p_data,
+                          size_t                    len,
+                          size_t                    offset)
+{
+    ASSERT(p_view);
+    ASSERT((offset + len) <= p_view->len);
+
+    nrf_memobj_read(p_view->p_obj, p_data, len, p_view->offset + offset);
+}
@@ -78,7 +78,7 @@ extern "C" {
 @endverbatim
  *
  */
-#define NRF_MEMOBJ_STD_HEADER_SIZE sizeof(uint32_t)
+#define NRF_MEMOBJ_STD_HEADER_SIZE sizeof(void *)
 
 /**
  * @brief Macro for creating an nrf_memobj pool.
@@ -104,6 +104,32 @@ typedef nrf_balloc_t nrf_memobj_pool_t;
  */
 typedef void * nrf_memobj_t;
 
+/**
+ * @brief Contiguous span of memory object data.
+ *
+ * Spans point directly to the chunks of the memory object, so they can be passed to drivers
+ * (for example, as EasyDMA buffers) without copying. They are valid as long as the memory object
+ * is not freed.
+ */
+typedef struct
+{
+    void * p_base; //!< Pointer to the beginning of the span.
+    size_t len;    //!< Length of the span in bytes.
+} nrf_memobj_iovec_t;
+
+/**
+ * @brief View of a part of a memory object.
+ *
+ * A view holds a reference to the memory object (see @ref nrf_memobj_get), so the object is not
+ * freed until all views are released. Views can be sliced further without copying the data.
+ */
+typedef struct
+{
+    nrf_memobj_t * p_obj;  //!< Memory object which holds the data.
+    size_t         offset; //!< Offset of the view within the memory object.
+    size_t         len;    //!< Length of the view in bytes.
+} nrf_memobj_view_t;
+
 /**
  * @brief Function for initializing the memobj pool instance.
  *
@@ -121,7 +147,8 @@ ret_code_t nrf_memobj_pool_init(nrf_memobj_pool_t const * p_pool);
  * Fixed length elements in the pool are linked together to provide the amount of memory requested by
  * the user. If a memory object is successfully allocated, then the users can use the memory.
  * However, it is fragmented into multiple objects so it must be accessed through the API:
- * @ref nrf_memobj_write and @ref nrf_memobj_read.
+ * @ref nrf_memobj_write and @ref nrf_memobj_read, or directly through spans returned by
+ * @ref nrf_memobj_iovec_get.
  * 
  * @param[in] p_pool     Pointer to the memobj pool instance structure.
  * @param[in] size       Data size of requested object.
@@ -194,6 +221,115 @@ void nrf_memobj_read(nrf_memobj_t * p_obj,
                      size_t         len,
                      size_t         offset);
 
+/**
+ * @brief Function for getting the data capacity of the memory object.
+ *
+ * Capacity may be bigger than the size requested in @ref nrf_memobj_alloc because the object
+ * consists of whole chunks.
+ *
+ * @param[in] p_obj  Pointer to memory object.
+ *
+ * @return Number of bytes which can be stored in the memory object.
+ */
+size_t nrf_memobj_size_get(nrf_memobj_t const * p_obj);
+
+/**
+ * @brief Function for getting contiguous spans of memory object data.
+ *
+ * The function does not copy any data. Each span covers data stored in a single chunk. If @p len
+ * exceeds the capacity of the object, it is truncated. If @p iov_cnt is too small to describe
+ * the whole requested range, only the first @p iov_cnt spans are returned and the function can be
+ * called again with the offset moved by the total length of the returned spans.
+ *
+ * @param[in]  p_obj   Pointer to memory object.
+ * @param[in]  offset  Offset of the first byte.
+ * @param[in]  len     Number of bytes to be described.
+ * @param[out] p_iov   Array to be filled with spans.
+ * @param[in]  iov_cnt Number of elements in @p p_iov.
+ *
+ * @return Number of spans stored in @p p_iov.
+ */
+size_t nrf_memobj_iovec_get(nrf_memobj_t const * p_obj,
+                            size_t               offset,
+                            size_t               len,
+                            nrf_memobj_iovec_t * p_iov,
+                            size_t               iov_cnt);
+
+/**
+ * @brief Function for creating a view of a part of a memory object.
+ *
+ * The function increments the user counter of the memory object. The view must be released with
+ * @ref nrf_memobj_view_release.
+ *
+ * @note User counter of the memory object is 8 bits wide, so at most 255 references (including
+ *       views) can be held at the same time.
+ *
+ * @param[out] p_view Pointer to the view to be initialized.
+ * @param[in]  p_obj  Pointer to memory object.
+ * @param[in]  offset Offset of the view within the memory object.
+ * @param[in]  len    Length of the view.
+ */
+void nrf_memobj_view_init(nrf_memobj_view_t * p_view,
+                          nrf_memobj_t *      p_obj,
+                          size_t              offset,
+                          size_t              len);
+
+/**
+ * @brief Function for creating a view of a part of another view.
+ *
+ * The new view holds its own reference to the memory object, so it remains valid after the parent
+ * view is released.
+ *
+ * @param[out] p_view   Pointer to the view to be initialized.
+ * @param[in]  p_parent Pointer to the parent view.
+ * @param[in]  offset   Offset of the new view within the parent view.
+ * @param[in]  len      Length of the new view.
+ */
+void nrf_memobj_view_slice(nrf_memobj_view_t *       p_view,
+                           nrf_memobj_view_t const * p_parent,
+                           size_t                    offset,
+                           size_t                    len);
+
+/**
+ * @brief Function for releasing a view.
+ *
+ * The reference to the memory object is dropped (see @ref nrf_memobj_put). Releasing a view which
+ * was already released has no effect.
+ *
+ * @param[in] p_view Pointer to the view.
+ */
+void nrf_memobj_view_release(nrf_memobj_view_t * p_view);
+
+/**
+ * @brief Function for getting contiguous spans of view data.
+ *
+ * See @ref nrf_memobj_iovec_get.
+ *
+ * @param[in]  p_view  Pointer to the view.
+ * @param[in]  offset  Offset within the view.
+ * @param[out] p_iov   Array to be filled with spans.
+ * @param[in]  iov_cnt Number of elements in @p p_iov.
+ *
+ * @return Number of spans stored in @p p_iov.
+ */
+size_t nrf_memobj_view_iovec_get(nrf_memobj_view_t const * p_view,
+                                 size_t                    offset,
+                                 nrf_memobj_iovec_t *      p_iov,
+                                 size_t                    iov_cnt);
+
+/**
+ * @brief Function for reading data from a view.
+ *
+ * @param[in] p_view Pointer to the view.
+ * @param[in] p_data Pointer to the destination buffer.
+ * @param[in] len    Amount of data to be read from the view.
+ * @param[in] offset Offset within the view.
+ */
+void nrf_memobj_view_read(nrf_memobj_view_t const * p_view,
+                          void *                    p_data,
+                          size_t                    len,
+                          size_t                    offset);
+
 #ifdef __cplusplus
 }
 #endif
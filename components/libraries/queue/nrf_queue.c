@@ -93,7 +93,8 @@ static void nrf_queue_status(nrf_cli_t const * p_cli, size_t argc, char **argv)
                         p_name, element_size,
                         100ul * util/size, util,size,
                         100ul * max_util/size, max_util,size,
-                        (p_instance->mode == NRF_QUEUE_MODE_OVERFLOW) ? "Overflow" : "No overflow");
+                        (p_instance->mode == NRF_QUEUE_MODE_OVERFLOW) ? "Overflow" :
+                        (p_instance->mode == NRF_QUEUE_MODE_SPSC)     ? "SPSC"     : "No overflow");
 
     }
 }
@@ -147,6 +148,148 @@ __STATIC_INLINE size_t queue_utilization_get(nrf_queue_t const * p_queue)
         (circullar_buffer_size_get(p_queue) - front + back);
 }
 
+/**@brief Get queue utilization from given indexes.
+ *
+ * @param[in]   p_queue     Pointer to the queue instance.
+ * @param[in]   front       Front index.
+ * @param[in]   back        Back index.
+ *
+ * @return      Number of elements between the indexes.
+ */
+__STATIC_INLINE size_t spsc_utilization_get(nrf_queue_t const * p_queue, size_t front, size_t back)
+{
+    return (back >= front) ? (back - front) :
+        (circullar_buffer_size_get(p_queue) - front + back);
+}
+
+/**@brief Write elements to a queue in @ref NRF_QUEUE_MODE_SPSC. Must be called by the producer only.
+ *
+ * Elements are copied before the back index is published, so the consumer never observes an
+ * element that is not written yet.
+ *
+ * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
+ * @param[in]   p_data              Pointer to the buffer with elements to write.
+ * @param[in]   element_count       Number of elements to write.
+ * @param[in]   all                 If true, nothing is written unless all elements fit.
+ *
+ * @return      The number of written elements.
+ */
+static size_t spsc_in(nrf_queue_t const * p_queue,
+                      void const        * p_data,
+                      size_t              element_count,
+                      bool                all)
+{
+    size_t back  = p_queue->p_cb->back;
+    size_t front = p_queue->p_cb->front;
+    __DMB();
+
+    size_t available = p_queue->size - spsc_utilization_get(p_queue, front, back);
+    if (element_count > available)
+    {
+        if (all)
+        {
+            return 0;
+        }
+        element_count = available;
+    }
+    if (element_count == 0)
+    {
+        return 0;
+    }
+
+    size_t buffer_size = circullar_buffer_size_get(p_queue);
+    size_t first       = MIN(element_count, buffer_size - back);
+
+    memcpy((void *)((size_t)p_queue->p_buffer + back * p_queue->element_size),
+           p_data,
+           first * p_queue->element_size);
+    memcpy(p_queue->p_buffer,
+           (void const *)((size_t)p_data + first * p_queue->element_size),
+           (element_count - first) * p_queue->element_size);
+
+    back += element_count;
+    if (back >= buffer_size)
+    {
+        back -= buffer_size;
+    }
+
+    __DMB();
+    p_queue->p_cb->back = back;
+
+    /* The front index read after publishing is a point at which all elements up to back were
+     * in the queue together, so the utilization is never overestimated.
+     */
+    size_t utilization = spsc_utilization_get(p_queue, p_queue->p_cb->front, back);
+    if (p_queue->p_cb->max_utilization < utilization)
+    {
+        p_queue->p_cb->max_utilization = utilization;
+    }
+
+    return element_count;
+}
+
+/**@brief Read elements from a queue in @ref NRF_QUEUE_MODE_SPSC. Must be called by the consumer only.
+ *
+ * Elements are copied before the front index is published, so the producer never overwrites an
+ * element that is still being read.
+ *
+ * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
+ * @param[out]  p_data              Pointer to the buffer where elements will be copied.
+ * @param[in]   element_count       Number of elements to read.
+ * @param[in]   all                 If true, nothing is read unless enough elements are queued.
+ * @param[in]   just_peek           If true, the elements are not removed from the queue.
+ *
+ * @return      The number of read elements.
+ */
+static size_t spsc_out(nrf_queue_t const * p_queue,
+                       void              * p_data,
+                       size_t              element_count,
+                       bool                all,
+                       bool                just_peek)
+{
+    size_t front = p_queue->p_cb->front;
+    size_t back  = p_queue->p_cb->back;
+    __DMB();
+
+    size_t utilization = spsc_utilization_get(p_queue, front, back);
+    if (element_count > utilization)
+    {
+        if (all)
+        {
+            return 0;
+        }
+        element_count = utilization;
+    }
+    if (element_count == 0)
+    {
+        return 0;
+    }
+
+    size_t buffer_size = circullar_buffer_size_get(p_queue);
+    size_t first       = MIN(element_count, buffer_size - front);
+
+    memcpy(p_data,
+           (void const *)((size_t)p_queue->p_buffer + front * p_queue->element_size),
+           first * p_queue->element_size);
+    memcpy((void *)((size_t)p_data + first * p_queue->element_size),
+           p_queue->p_buffer,
+           (element_count - first) * p_queue->element_size);
+
+    if (!just_peek)
+    {
+        front += element_count;
+        if (front >= buffer_size)
+        {
+            front -= buffer_size;
+        }
+
+        __DMB();
+        p_queue->p_cb->front = front;
+    }
+
+    return element_count;
+}
+
 bool nrf_queue_is_full(nrf_queue_t const * p_queue)
 {
     ASSERT(p_queue != NULL);
@@ -163,6 +306,13 @@ ret_code_t nrf_queue_push(nrf_queue_t const * p_queue, void const * p_element)
     ASSERT(p_queue != NULL);
     ASSERT(p_element != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        status = (spsc_in(p_queue, p_element, 1, true) == 1) ? NRF_SUCCESS : NRF_ERROR_NO_MEM;
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "pushed element 0x%08X, status:%d", p_element, status);
+        return status;
+    }
+
     CRITICAL_REGION_ENTER();
     bool is_full = nrf_queue_is_full(p_queue);
 
@@ -231,6 +381,15 @@ ret_code_t nrf_queue_generic_pop(nrf_queue_t const * p_queue,
     ASSERT(p_queue      != NULL);
     ASSERT(p_element    != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        status = (spsc_out(p_queue, p_element, 1, true, just_peek) == 1) ?
+                 NRF_SUCCESS : NRF_ERROR_NOT_FOUND;
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "%s element 0x%08X, status:%d",
+                                             just_peek ? "peeked" : "popped", p_element, status);
+        return status;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (!nrf_queue_is_empty(p_queue))
@@ -367,6 +526,15 @@ ret_code_t nrf_queue_write(nrf_queue_t const * p_queue,
         return NRF_SUCCESS;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        status = (spsc_in(p_queue, p_data, element_count, true) == element_count) ?
+                 NRF_SUCCESS : NRF_ERROR_NO_MEM;
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "Write %d elements (start address: 0x%08X), status:%d",
+                                           element_count, p_data, status);
+        return status;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if ((nrf_queue_available_get(p_queue) >= element_count)
@@ -401,6 +569,14 @@ size_t nrf_queue_in(nrf_queue_t const * p_queue,
         return 0;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        element_count = spsc_in(p_queue, p_data, element_count, false);
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "Put in %d elements (start address: 0x%08X), requested :%d",
+                                           element_count, p_data, req_element_count);
+        return element_count;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (p_queue->mode == NRF_QUEUE_MODE_OVERFLOW)
@@ -477,6 +653,15 @@ ret_code_t nrf_queue_read(nrf_queue_t const * p_queue,
         return NRF_SUCCESS;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        status = (spsc_out(p_queue, p_data, element_count, true, false) == element_count) ?
+                 NRF_SUCCESS : NRF_ERROR_NOT_FOUND;
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "Read %d elements (start address: 0x%08X), status :%d",
+                                           element_count, p_data, status);
+        return status;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (element_count <= queue_utilization_get(p_queue))
@@ -509,6 +694,14 @@ size_t nrf_queue_out(nrf_queue_t const * p_queue,
         return 0;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        element_count = spsc_out(p_queue, p_data, element_count, false, false);
+        NRF_LOG_INST_DEBUG(p_queue->p_log, "Out %d elements (start address: 0x%08X), requested :%d",
+                                           element_count, p_data, req_element_count);
+        return element_count;
+    }
+
     CRITICAL_REGION_ENTER();
 
     size_t utilization = queue_utilization_get(p_queue);
@@ -541,6 +734,11 @@ size_t nrf_queue_utilization_get(nrf_queue_t const * p_queue)
     size_t utilization;
     ASSERT(p_queue != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        return spsc_utilization_get(p_queue, p_queue->p_cb->front, p_queue->p_cb->back);
+    }
+
     CRITICAL_REGION_ENTER();
 
     utilization = queue_utilization_get(p_queue);
@@ -65,6 +65,25 @@ extern "C" {
  */
 #define NRF_QUEUE_LOG_NAME queue
 
+/**
+ * @defgroup nrf_queue_spsc Single producer, single consumer mode
+ * @{
+ *
+ * A queue defined with @ref NRF_QUEUE_MODE_SPSC does not disable interrupts. The producer is the
+ * only context that moves the back index and the consumer is the only context that moves the
+ * front index, so each index is published with a single word store after the element data.
+ *
+ * The following rules apply:
+ * - Only one context (for example, an interrupt handler) may call @ref nrf_queue_push,
+ *   @ref nrf_queue_write, and @ref nrf_queue_in.
+ * - Only one context (for example, the main loop) may call @ref nrf_queue_pop,
+ *   @ref nrf_queue_peek, @ref nrf_queue_read, and @ref nrf_queue_out.
+ * - @ref nrf_queue_reset may only be called when neither side is using the queue.
+ * - The maximum utilization is updated by the producer. Utilization read by any other context
+ *   is a snapshot.
+ * @}
+ */
+
 /**@brief Queue control block. */
 typedef struct
 {
@@ -78,6 +97,8 @@ typedef enum
 {
     NRF_QUEUE_MODE_OVERFLOW,        //!< If the queue is full, new element will overwrite the oldest.
     NRF_QUEUE_MODE_NO_OVERFLOW,     //!< If the queue is full, new element will not be accepted.
+    NRF_QUEUE_MODE_SPSC,            //!< Single producer and single consumer. If the queue is full, new element will not be accepted.
+                                    //!< Indexes are updated without a critical region. See @ref nrf_queue_spsc.
 } nrf_queue_mode_t;
 
 /**@brief Instance of the queue. */
@@ -47,24 +47,55 @@
 #include "nrf_assert.h"
 #include "app_util_platform.h"
 
-/**@brief Structure for holding a scheduled event header. */
+#if (APP_SCHEDULER_PRIORITY_LEVELS < 1) || (APP_SCHEDULER_PRIORITY_LEVELS > 8)
+#error "APP_SCHEDULER_PRIORITY_LEVELS must be between 1 and 8."
+#endif
+
+#if (APP_SCHEDULER_DEFAULT_PRIORITY >= APP_SCHEDULER_PRIORITY_LEVELS)
+#error "APP_SCHEDULER_DEFAULT_PRIORITY must be lower than APP_SCHEDULER_PRIORITY_LEVELS."
+#endif
+
+/**@brief Structure for holding a scheduled event header.
+ *
+ * @details The header is followed by the event data. An entry size of 0 marks the unused end of
+ *          the ring, after which the queue continues from the start of the buffer. If less than a
+ *          header is left at the end of the ring, it is unused without a mark. A handler set
+ *          to NULL marks an event that is reserved but not committed yet.
+ */
 typedef struct
 {
     app_sched_event_handler_t handler;          /**< Pointer to event handler to receive the event. */
     uint16_t                  event_data_size;  /**< Size of event data. */
+    uint16_t                  entry_size;       /**< Size of the entry, header included. */
 } event_header_t;
 
 STATIC_ASSERT(sizeof(event_header_t) <= APP_SCHED_EVENT_HEADER_SIZE);
 
-static event_header_t * m_queue_event_headers;  /**< Array for holding the queue event headers. */
-static uint8_t        * m_queue_event_data;     /**< Array for holding the queue event data. */
-static volatile uint8_t m_queue_start_index;    /**< Index of queue entry at the start of the queue. */
-static volatile uint8_t m_queue_end_index;      /**< Index of queue entry at the end of the queue. */
+/**@brief Structure for holding the queue of one priority level. */
+typedef struct
+{
+    uint8_t           * p_buffer;       /**< Ring of queue entries. */
+    volatile uint32_t   start;          /**< Offset of the entry at the start of the queue. */
+    volatile uint32_t   end;            /**< Offset of the end of the queue. */
+#if APP_SCHEDULER_WITH_PROFILER
+    uint16_t            put_count;      /**< Number of reserved events. */
+    uint16_t            exec_count;     /**< Number of executed events. */
+#endif
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+    uint16_t            wait_count;     /**< Number of events executed from other levels while this one was pending. */
+#endif
+} sched_queue_t;
+
+static sched_queue_t    m_queues[APP_SCHEDULER_PRIORITY_LEVELS]; /**< Queues, from the highest to the lowest priority. */
+static uint32_t         m_level_size;           /**< Size of the ring of each priority level. */
 static uint16_t         m_queue_event_size;     /**< Maximum event size in queue. */
-static uint16_t         m_queue_size;           /**< Number of queue entries. */
 
 #if APP_SCHEDULER_WITH_PROFILER
 static uint16_t m_max_queue_utilization;    /**< Maximum observed queue utilization. */
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+static app_sched_level_stats_t   m_level_stats[APP_SCHEDULER_PRIORITY_LEVELS]; /**< Statistics of each priority level. */
+static app_sched_timestamp_func_t m_timestamp_func;                        /**< Source of handler runtime timestamps. */
+#endif
 #endif
 
 #if APP_SCHEDULER_WITH_PAUSE
@@ -72,42 +103,148 @@ static uint32_t m_scheduler_paused_counter = 0; /**< Counter storing the differe
                                                      and resuming the scheduler. */
 #endif
 
-/**@brief Function for incrementing a queue index, and handle wrap-around.
+/**@brief Function for getting the size of the queue entry of an event.
  *
- * @param[in]   index   Old index.
+ * @param[in]   event_data_size   Size of event data.
  *
- * @return      New (incremented) index.
+ * @return      Entry size. All entries have the size of the largest event unless
+ *              @ref APP_SCHEDULER_VARIABLE_SIZE is enabled.
  */
-static __INLINE uint8_t next_index(uint8_t index)
+static __INLINE uint32_t entry_size_get(uint16_t event_data_size)
 {
-    return (index < m_queue_size) ? (index + 1) : 0;
+#if APP_SCHEDULER_VARIABLE_SIZE
+    return APP_SCHED_EVENT_SIZE(event_data_size);
+#else
+    UNUSED_PARAMETER(event_data_size);
+    return APP_SCHED_EVENT_SIZE(m_queue_event_size);
+#endif
 }
 
 
-static __INLINE uint8_t app_sched_queue_full()
+/**@brief Function for allocating a queue entry. Must be called from a critical region.
+ *
+ * @details When the entry does not fit before the end of the ring, the rest of the ring is
+ *          marked as unused and the entry is placed at the start of the buffer. One byte of the
+ *          ring is always left free to tell a full queue from an empty one.
+ *
+ * @param[in]   p_queue      Queue of the priority level.
+ * @param[in]   entry_size   Size of the entry, header included.
+ *
+ * @return      Pointer to the entry header, or NULL if the queue is full.
+ */
+static event_header_t * queue_alloc(sched_queue_t * p_queue, uint32_t entry_size)
 {
-  uint8_t tmp = m_queue_start_index;
-  return next_index(m_queue_end_index) == tmp;
+    uint32_t start = p_queue->start;
+    uint32_t end   = p_queue->end;
+    uint32_t offset;
+
+    if (end >= start)
+    {
+        if ((end + entry_size < m_level_size) ||
+            ((end + entry_size == m_level_size) && (start != 0)))
+        {
+            offset = end;
+        }
+        else if (entry_size < start)
+        {
+            if (m_level_size - end >= APP_SCHED_EVENT_HEADER_SIZE)
+            {
+                ((event_header_t *)&p_queue->p_buffer[end])->entry_size = 0;
+            }
+            offset = 0;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else if (end + entry_size < start)
+    {
+        offset = end;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    event_header_t * p_header = (event_header_t *)&p_queue->p_buffer[offset];
+    p_header->handler    = NULL;
+    p_header->entry_size = entry_size;
+
+    end = offset + entry_size;
+    p_queue->end = (end == m_level_size) ? 0 : end;
+
+    return p_header;
 }
 
-/**@brief Macro for checking if a queue is full. */
-#define APP_SCHED_QUEUE_FULL() app_sched_queue_full()
 
+/**@brief Function for getting the entry at the start of a queue.
+ *
+ * @details Must be called from the main context only. Skips the unused end of the ring.
+ *
+ * @param[in]   p_queue   Queue of the priority level.
+ *
+ * @return      Pointer to the entry header, or NULL if the queue is empty.
+ */
+static event_header_t * queue_head_get(sched_queue_t * p_queue)
+{
+    uint32_t start = p_queue->start;
 
-static __INLINE uint8_t app_sched_queue_empty()
+    while (start != p_queue->end)
+    {
+        event_header_t * p_header = (event_header_t *)&p_queue->p_buffer[start];
+        if ((m_level_size - start >= APP_SCHED_EVENT_HEADER_SIZE) && (p_header->entry_size != 0))
+        {
+            return p_header;
+        }
+        start = 0;
+        p_queue->start = start;
+    }
+    return NULL;
+}
+
+
+/**@brief Function for removing the entry at the start of a queue.
+ *
+ * @param[in]   p_queue    Queue of the priority level.
+ * @param[in]   p_header   Entry returned by @ref queue_head_get.
+ */
+static __INLINE void queue_head_free(sched_queue_t * p_queue, event_header_t const * p_header)
 {
-  uint8_t tmp = m_queue_start_index;
-  return m_queue_end_index == tmp;
+    uint32_t start = p_queue->start + p_header->entry_size;
+    p_queue->start = (start == m_level_size) ? 0 : start;
+#if APP_SCHEDULER_WITH_PROFILER
+    p_queue->exec_count++;
+#endif
 }
 
-/**@brief Macro for checking if a queue is empty. */
-#define APP_SCHED_QUEUE_EMPTY() app_sched_queue_empty()
+
+/**@brief Function for getting the number of largest events that still fit in a queue.
+ *
+ * @param[in]   p_queue   Queue of the priority level.
+ *
+ * @return      Number of free entries.
+ */
+static uint16_t queue_space_get(sched_queue_t const * p_queue)
+{
+    uint32_t start = p_queue->start;
+    uint32_t end   = p_queue->end;
+    uint32_t entry = APP_SCHED_EVENT_SIZE(m_queue_event_size);
+
+    if (end < start)
+    {
+        return (start - end - 1) / entry;
+    }
+    if (start == 0)
+    {
+        return (m_level_size - end - 1) / entry;
+    }
+    return ((m_level_size - end) / entry) + ((start - 1) / entry);
+}
 
 
 uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event_buffer)
 {
-    uint16_t data_start_index = (queue_size + 1) * sizeof(event_header_t);
-
     // Check that buffer is correctly aligned
     if (!is_word_aligned(p_event_buffer))
     {
@@ -115,15 +252,28 @@ uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event
     }
 
     // Initialize event scheduler
-    m_queue_event_headers = p_event_buffer;
-    m_queue_event_data    = &((uint8_t *)p_event_buffer)[data_start_index];
-    m_queue_end_index     = 0;
-    m_queue_start_index   = 0;
+    m_level_size = APP_SCHED_BUF_SIZE(event_size, queue_size) / APP_SCHEDULER_PRIORITY_LEVELS;
+
+    for (uint32_t level = 0; level < APP_SCHEDULER_PRIORITY_LEVELS; level++)
+    {
+        m_queues[level].p_buffer    = &((uint8_t *)p_event_buffer)[level * m_level_size];
+        m_queues[level].end         = 0;
+        m_queues[level].start       = 0;
+#if APP_SCHEDULER_WITH_PROFILER
+        m_queues[level].put_count   = 0;
+        m_queues[level].exec_count  = 0;
+#endif
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+        m_queues[level].wait_count  = 0;
+#endif
+    }
     m_queue_event_size    = event_size;
-    m_queue_size          = queue_size;
 
 #if APP_SCHEDULER_WITH_PROFILER
     m_max_queue_utilization = 0;
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+    memset(m_level_stats, 0, sizeof(m_level_stats));
+#endif
 #endif
 
     return NRF_SUCCESS;
@@ -132,94 +282,204 @@ uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event
 
 uint16_t app_sched_queue_space_get()
 {
-    uint16_t start = m_queue_start_index;
-    uint16_t end   = m_queue_end_index;
-    uint16_t free_space = m_queue_size - ((end >= start) ?
-                           (end - start) : (m_queue_size + 1 - start + end));
-    return free_space;
+    return queue_space_get(&m_queues[APP_SCHEDULER_DEFAULT_PRIORITY]);
 }
 
 
 #if APP_SCHEDULER_WITH_PROFILER
-static void queue_utilization_check(void)
+static void queue_utilization_check(uint8_t priority)
 {
-    uint16_t start = m_queue_start_index;
-    uint16_t end   = m_queue_end_index;
-    uint16_t queue_utilization = (end >= start) ? (end - start) :
-        (m_queue_size + 1 - start + end);
+    uint16_t queue_utilization = 0;
+
+    for (uint32_t level = 0; level < APP_SCHEDULER_PRIORITY_LEVELS; level++)
+    {
+        queue_utilization += (uint16_t)(m_queues[level].put_count - m_queues[level].exec_count);
+    }
 
     if (queue_utilization > m_max_queue_utilization)
     {
         m_max_queue_utilization = queue_utilization;
     }
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+    uint16_t level_utilization = (uint16_t)(m_queues[priority].put_count -
+                                            m_queues[priority].exec_count);
+    if (level_utilization > m_level_stats[priority].max_utilization)
+    {
+        m_level_stats[priority].max_utilization = level_utilization;
+    }
+#else
+    UNUSED_PARAMETER(priority);
+#endif
 }
 
 uint16_t app_sched_queue_utilization_get(void)
 {
     return m_max_queue_utilization;
 }
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+void app_sched_timestamp_func_set(app_sched_timestamp_func_t timestamp_func)
+{
+    m_timestamp_func = timestamp_func;
+}
+
+uint32_t app_sched_level_stats_get(uint8_t priority, app_sched_level_stats_t * p_stats)
+{
+    if ((priority >= APP_SCHEDULER_PRIORITY_LEVELS) || (p_stats == NULL))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_level_stats[priority];
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+#endif
 #endif // APP_SCHEDULER_WITH_PROFILER
 
 
-uint32_t app_sched_event_put(void const              * p_event_data,
-                             uint16_t                  event_data_size,
-                             app_sched_event_handler_t handler)
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+uint32_t app_sched_event_reserve_prio(uint16_t event_data_size,
+                                      void **  pp_event_data,
+                                      uint8_t  priority)
+#else
+uint32_t app_sched_event_reserve(uint16_t event_data_size, void ** pp_event_data)
+#endif
 {
-    uint32_t err_code;
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+    if (priority >= APP_SCHEDULER_PRIORITY_LEVELS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+#else
+    uint8_t const priority = APP_SCHEDULER_DEFAULT_PRIORITY;
+#endif
 
-    if (event_data_size <= m_queue_event_size)
+    if (event_data_size > m_queue_event_size)
     {
-        uint16_t event_index = 0xFFFF;
+        return NRF_ERROR_INVALID_LENGTH;
+    }
 
-        CRITICAL_REGION_ENTER();
+    sched_queue_t  * p_queue    = &m_queues[priority];
+    uint32_t         entry_size = entry_size_get(event_data_size);
+    event_header_t * p_header;
 
-        if (!APP_SCHED_QUEUE_FULL())
-        {
-            event_index       = m_queue_end_index;
-            m_queue_end_index = next_index(m_queue_end_index);
+    CRITICAL_REGION_ENTER();
 
-        #if APP_SCHEDULER_WITH_PROFILER
-            // This function call must be protected with critical region because
-            // it modifies 'm_max_queue_utilization'.
-            queue_utilization_check();
-        #endif
-        }
+    p_header = queue_alloc(p_queue, entry_size);
 
-        CRITICAL_REGION_EXIT();
+#if APP_SCHEDULER_WITH_PROFILER
+    if (p_header != NULL)
+    {
+        // This function call must be protected with critical region because
+        // it modifies 'm_max_queue_utilization'.
+        p_queue->put_count++;
+        queue_utilization_check(priority);
+    }
+#endif
 
-        if (event_index != 0xFFFF)
-        {
-            // NOTE: This can be done outside the critical region since the event consumer will
-            //       always be called from the main loop, and will thus never interrupt this code.
-            m_queue_event_headers[event_index].handler = handler;
-            if ((p_event_data != NULL) && (event_data_size > 0))
-            {
-                memcpy(&m_queue_event_data[event_index * m_queue_event_size],
-                       p_event_data,
-                       event_data_size);
-                m_queue_event_headers[event_index].event_data_size = event_data_size;
-            }
-            else
-            {
-                m_queue_event_headers[event_index].event_data_size = 0;
-            }
+    CRITICAL_REGION_EXIT();
 
-            err_code = NRF_SUCCESS;
-        }
-        else
-        {
-            err_code = NRF_ERROR_NO_MEM;
-        }
+    if (p_header == NULL)
+    {
+        return NRF_ERROR_NO_MEM;
     }
-    else
+
+    // NOTE: This can be done outside the critical region since the event is not executed
+    //       until its handler is set in app_sched_event_commit().
+    p_header->event_data_size = event_data_size;
+    *pp_event_data = (uint8_t *)p_header + APP_SCHED_EVENT_HEADER_SIZE;
+
+    return NRF_SUCCESS;
+}
+
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+uint32_t app_sched_event_reserve(uint16_t event_data_size, void ** pp_event_data)
+{
+    return app_sched_event_reserve_prio(event_data_size,
+                                        pp_event_data,
+                                        APP_SCHEDULER_DEFAULT_PRIORITY);
+}
+#endif
+
+
+uint32_t app_sched_event_commit(void * p_event_data, app_sched_event_handler_t handler)
+{
+    if ((p_event_data == NULL) || (handler == NULL))
     {
-        err_code = NRF_ERROR_INVALID_LENGTH;
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    event_header_t * p_header =
+        (event_header_t *)((uint8_t *)p_event_data - APP_SCHED_EVENT_HEADER_SIZE);
+
+    // Event data must be in memory before the event becomes visible to app_sched_execute().
+    __DMB();
+    ((event_header_t volatile *)p_header)->handler = handler;
+
+    return NRF_SUCCESS;
+}
+
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+uint32_t app_sched_event_put_prio(void const              * p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+#else
+uint32_t app_sched_event_put(void const              * p_event_data,
+                             uint16_t                  event_data_size,
+                             app_sched_event_handler_t handler)
+#endif
+{
+    uint32_t err_code;
+    void   * p_queue_data;
+
+    if (event_data_size > m_queue_event_size)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    if (p_event_data == NULL)
+    {
+        event_data_size = 0;
+    }
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+    err_code = app_sched_event_reserve_prio(event_data_size, &p_queue_data, priority);
+#else
+    err_code = app_sched_event_reserve(event_data_size, &p_queue_data);
+#endif
+
+    if (err_code == NRF_SUCCESS)
+    {
+        if (event_data_size > 0)
+        {
+            memcpy(p_queue_data, p_event_data, event_data_size);
+        }
+        err_code = app_sched_event_commit(p_queue_data, handler);
     }
 
     return err_code;
 }
 
 
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+uint32_t app_sched_event_put(void const              * p_event_data,
+                             uint16_t                  event_data_size,
+                             app_sched_event_handler_t handler)
+{
+    return app_sched_event_put_prio(p_event_data,
+                                    event_data_size,
+                                    handler,
+                                    APP_SCHEDULER_DEFAULT_PRIORITY);
+}
+#endif
+
+
 #if APP_SCHEDULER_WITH_PAUSE
 void app_sched_pause(void)
 {
@@ -260,29 +520,147 @@ static __INLINE bool is_app_sched_paused(void)
 }
 
 
+/**@brief Function for getting the event at the start of a queue if it is ready to execute.
+ *
+ * @param[in]   p_queue   Queue of the priority level.
+ *
+ * @return      Pointer to the entry header, or NULL if the queue is empty or its first event is
+ *              not committed yet.
+ */
+static __INLINE event_header_t * queue_ready_get(sched_queue_t * p_queue)
+{
+    event_header_t * p_header = queue_head_get(p_queue);
+
+    if ((p_header == NULL) || (((event_header_t volatile *)p_header)->handler == NULL))
+    {
+        return NULL;
+    }
+    return p_header;
+}
+
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+/**@brief Function for selecting the priority level of the next event to execute.
+ *
+ * @details The highest ready level is selected, unless a lower level has waited for
+ *          @ref APP_SCHEDULER_STARVATION_LIMIT events. In that case, the highest of the starved
+ *          levels is selected.
+ *
+ * @param[out]  pp_header   Entry header of the event to execute.
+ *
+ * @return    Priority level, or APP_SCHEDULER_PRIORITY_LEVELS if no event is ready.
+ */
+static uint8_t next_level_get(event_header_t ** pp_header)
+{
+    uint8_t selected = APP_SCHEDULER_PRIORITY_LEVELS;
+
+    for (uint8_t level = 0; level < APP_SCHEDULER_PRIORITY_LEVELS; level++)
+    {
+        event_header_t * p_header = queue_ready_get(&m_queues[level]);
+        if (p_header == NULL)
+        {
+            continue;
+        }
+
+        if (selected == APP_SCHEDULER_PRIORITY_LEVELS)
+        {
+            selected   = level;
+            *pp_header = p_header;
+        #if (APP_SCHEDULER_STARVATION_LIMIT == 0)
+            break;
+        #endif
+        }
+        else if (m_queues[level].wait_count >= APP_SCHEDULER_STARVATION_LIMIT)
+        {
+            selected   = level;
+            *pp_header = p_header;
+            break;
+        }
+    }
+
+    return selected;
+}
+
+/**@brief Function for updating the starvation counters after executing an event.
+ *
+ * @param[in]   executed   Priority level of the executed event.
+ */
+static void wait_counts_update(uint8_t executed)
+{
+    m_queues[executed].wait_count = 0;
+
+    for (uint8_t level = executed + 1; level < APP_SCHEDULER_PRIORITY_LEVELS; level++)
+    {
+        if ((m_queues[level].start != m_queues[level].end) &&
+            (m_queues[level].wait_count < UINT16_MAX))
+        {
+            m_queues[level].wait_count++;
+        }
+    }
+}
+#endif
+
+
 void app_sched_execute(void)
 {
-    while (!is_app_sched_paused() && !APP_SCHED_QUEUE_EMPTY())
+    while (!is_app_sched_paused())
     {
         // Since this function is only called from the main loop, there is no
         // need for a critical region here, however a special care must be taken
-        // regarding update of the queue start index (see the end of the loop).
-        uint16_t event_index = m_queue_start_index;
+        // regarding update of the queue start (see the end of the loop).
+        event_header_t * p_header;
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+        uint8_t level = next_level_get(&p_header);
+        if (level == APP_SCHEDULER_PRIORITY_LEVELS)
+        {
+            break;
+        }
+#else
+        uint8_t const level = 0;
+        p_header = queue_ready_get(&m_queues[level]);
+        if (p_header == NULL)
+        {
+            break;
+        }
+#endif
+        sched_queue_t * p_queue = &m_queues[level];
 
         void * p_event_data;
         uint16_t event_data_size;
         app_sched_event_handler_t event_handler;
 
-        p_event_data = &m_queue_event_data[event_index * m_queue_event_size];
-        event_data_size = m_queue_event_headers[event_index].event_data_size;
-        event_handler   = m_queue_event_headers[event_index].handler;
+        p_event_data    = (uint8_t *)p_header + APP_SCHED_EVENT_HEADER_SIZE;
+        event_data_size = p_header->event_data_size;
+        event_handler   = p_header->handler;
+
+#if APP_SCHEDULER_WITH_PROFILER && (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+        uint32_t start = (m_timestamp_func != NULL) ? m_timestamp_func() : 0;
+#endif
 
         event_handler(p_event_data, event_data_size);
 
-        // Event processed, now it is safe to move the queue start index,
+#if APP_SCHEDULER_WITH_PROFILER && (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+        if (m_timestamp_func != NULL)
+        {
+            uint32_t runtime = m_timestamp_func() - start;
+
+            m_level_stats[level].runtime_total += runtime;
+            if (runtime > m_level_stats[level].runtime_max)
+            {
+                m_level_stats[level].runtime_max = runtime;
+            }
+        }
+        m_level_stats[level].events++;
+#endif
+
+        // Event processed, now it is safe to move the queue start,
         // so the queue entry occupied by this event can be used to store
         // a next one.
-        m_queue_start_index = next_index(m_queue_start_index);
+        queue_head_free(p_queue, p_header);
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1)
+        wait_counts_update(level);
+#endif
     }
 }
 #endif //NRF_MODULE_ENABLED(APP_SCHEDULER)
@@ -72,6 +72,27 @@
  * @endif
  *
  * @image html scheduler_working.svg The high level design of the scheduler
+ *
+ * @section app_scheduler_prio Priority levels:
+ *
+ * If @ref APP_SCHEDULER_PRIORITY_LEVELS is greater than 1, each priority level has its own queue
+ * of QUEUE_SIZE entries and events are put into a level with app_sched_event_put_prio().
+ * app_sched_execute() always takes the next event from the highest non-empty level (0 is the
+ * highest), except that a level which has waited for @ref APP_SCHEDULER_STARVATION_LIMIT events
+ * from higher levels is served next. app_sched_event_put() puts events into
+ * @ref APP_SCHEDULER_DEFAULT_PRIORITY.
+ *
+ * @section app_scheduler_zero_copy Zero-copy events:
+ *
+ * app_sched_event_reserve() returns a pointer to event data inside the queue, which the caller
+ * fills in place and hands over with app_sched_event_commit(). Events are executed in the order
+ * they were reserved; an event that is reserved but not committed holds back the events queued
+ * after it in the same priority level, so every reservation must be committed.
+ *
+ * If @ref APP_SCHEDULER_VARIABLE_SIZE is enabled, each event takes only
+ * @ref APP_SCHED_EVENT_SIZE of its own size in the queue instead of the size of the largest
+ * event. A buffer dimensioned for QUEUE_SIZE of the largest events then holds correspondingly
+ * more small events, so QUEUE_SIZE can be reduced.
  */
 
 #ifndef APP_SCHEDULER_H__
@@ -86,18 +107,50 @@
 extern "C" {
 #endif
 
+#ifndef APP_SCHEDULER_PRIORITY_LEVELS
+#define APP_SCHEDULER_PRIORITY_LEVELS 1
+#endif
+
+#ifndef APP_SCHEDULER_DEFAULT_PRIORITY
+#define APP_SCHEDULER_DEFAULT_PRIORITY 0
+#endif
+
+#ifndef APP_SCHEDULER_STARVATION_LIMIT
+#define APP_SCHEDULER_STARVATION_LIMIT 8
+#endif
+
+#ifndef APP_SCHEDULER_VARIABLE_SIZE
+#define APP_SCHEDULER_VARIABLE_SIZE 0
+#endif
+
 #define APP_SCHED_EVENT_HEADER_SIZE 8       /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). */
 
+/**@brief Compute number of bytes taken in the scheduler queue by an event.
+ *
+ * @details Event data is rounded up to a multiple of 4 bytes, so that every entry stays word
+ *          aligned. For event sizes that are a multiple of 4, an entry takes EVENT_SIZE +
+ *          @ref APP_SCHED_EVENT_HEADER_SIZE bytes, as before. Without
+ *          @ref APP_SCHEDULER_VARIABLE_SIZE, every event takes the size of the largest one.
+ *
+ * @param[in] EVENT_SIZE   Size of event data.
+ *
+ * @return    Size of the queue entry (in bytes).
+ */
+#define APP_SCHED_EVENT_SIZE(EVENT_SIZE)                                                           \
+            (CEIL_DIV((EVENT_SIZE), sizeof(uint32_t)) * sizeof(uint32_t)                           \
+             + APP_SCHED_EVENT_HEADER_SIZE)
+
 /**@brief Compute number of bytes required to hold the scheduler buffer.
  *
  * @param[in] EVENT_SIZE   Maximum size of events to be passed through the scheduler.
  * @param[in] QUEUE_SIZE   Number of entries in scheduler queue (i.e. the maximum number of events
- *                         that can be scheduled for execution).
+ *                         that can be scheduled for execution). With several priority levels,
+ *                         this is the number of entries of each level.
  *
  * @return    Required scheduler buffer size (in bytes).
  */
 #define APP_SCHED_BUF_SIZE(EVENT_SIZE, QUEUE_SIZE)                                                 \
-            (((EVENT_SIZE) + APP_SCHED_EVENT_HEADER_SIZE) * ((QUEUE_SIZE) + 1))
+            (APP_SCHED_EVENT_SIZE(EVENT_SIZE) * ((QUEUE_SIZE) + 1) * APP_SCHEDULER_PRIORITY_LEVELS)
 
 /**@brief Scheduler event handler type. */
 typedef void (*app_sched_event_handler_t)(void * p_event_data, uint16_t event_size);
@@ -167,6 +220,7 @@ uint32_t app_sched_event_put(void const *              p_event_data,
 /**@brief Function for getting the maximum observed queue utilization.
  *
  * Function for tuning the module and determining QUEUE_SIZE value and thus module RAM usage.
+ * With several priority levels, events queued in all levels are counted.
  *
  * @note @ref APP_SCHEDULER_WITH_PROFILER must be enabled to use this functionality.
  *
@@ -174,10 +228,108 @@ uint32_t app_sched_event_put(void const *              p_event_data,
  */
 uint16_t app_sched_queue_utilization_get(void);
 
+/**@brief Function for reserving space for an event in the queue.
+ *
+ * @details The event is not executed until it is committed with @ref app_sched_event_commit.
+ *          The data pointer is word aligned.
+ *
+ * @param[in]   event_size      Size of event data to be scheduled.
+ * @param[out]  pp_event_data   Pointer to the event data in the queue.
+ *
+ * @retval      NRF_SUCCESS               Space was reserved.
+ * @retval      NRF_ERROR_INVALID_LENGTH  Event data is larger than the maximum event size.
+ * @retval      NRF_ERROR_NO_MEM          Queue is full.
+ */
+uint32_t app_sched_event_reserve(uint16_t event_size, void ** pp_event_data);
+
+/**@brief Function for committing a reserved event.
+ *
+ * @param[in]   p_event_data   Pointer returned by @ref app_sched_event_reserve.
+ * @param[in]   handler        Event handler to receive the event.
+ *
+ * @retval      NRF_SUCCESS               Event was committed.
+ * @retval      NRF_ERROR_INVALID_PARAM   NULL pointer.
+ */
+uint32_t app_sched_event_commit(void * p_event_data, app_sched_event_handler_t handler);
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS > 1) || defined(__SDK_DOXYGEN__)
+/**@brief Function for reserving space for an event with a given priority.
+ *
+ * @param[in]   event_size      Size of event data to be scheduled.
+ * @param[out]  pp_event_data   Pointer to the event data in the queue.
+ * @param[in]   priority        Priority level.
+ *
+ * @retval      NRF_SUCCESS               Space was reserved.
+ * @retval      NRF_ERROR_INVALID_PARAM   Invalid priority level.
+ * @retval      NRF_ERROR_INVALID_LENGTH  Event data is larger than the maximum event size.
+ * @retval      NRF_ERROR_NO_MEM          Queue of the priority level is full.
+ */
+uint32_t app_sched_event_reserve_prio(uint16_t event_size, void ** pp_event_data, uint8_t priority);
+
+/**@brief Function for scheduling an event with a given priority.
+ *
+ * @details Puts an event into the event queue of the given priority level.
+ *
+ * @param[in]   p_event_data   Pointer to event data to be scheduled.
+ * @param[in]   event_size     Size of event data to be scheduled.
+ * @param[in]   handler        Event handler to receive the event.
+ * @param[in]   priority       Priority level, from 0 (highest) to
+ *                             @ref APP_SCHEDULER_PRIORITY_LEVELS - 1 (lowest).
+ *
+ * @retval      NRF_SUCCESS               Event was scheduled.
+ * @retval      NRF_ERROR_INVALID_PARAM   Invalid priority level.
+ * @retval      NRF_ERROR_INVALID_LENGTH  Event data is larger than the maximum event size.
+ * @retval      NRF_ERROR_NO_MEM          Queue of the priority level is full.
+ */
+uint32_t app_sched_event_put_prio(void const *              p_event_data,
+                                  uint16_t                  event_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority);
+
+/**@brief Function type for getting a timestamp used to measure handler runtime. */
+typedef uint32_t (*app_sched_timestamp_func_t)(void);
+
+/**@brief Statistics of one priority level. */
+typedef struct
+{
+    uint16_t max_utilization;   /**< Maximum number of events observed in the queue of the level. */
+    uint32_t events;            /**< Number of executed events. */
+    uint32_t runtime_max;       /**< Longest handler runtime, in timestamp units. */
+    uint64_t runtime_total;     /**< Sum of handler runtimes, in timestamp units. */
+} app_sched_level_stats_t;
+
+/**@brief Function for setting the timestamp source used to measure handler runtime.
+ *
+ * @details Any free-running counter can be used, for example the DWT cycle counter or
+ *          @ref app_timer_cnt_get. Runtime is not measured until a source is set.
+ *
+ * @note @ref APP_SCHEDULER_WITH_PROFILER must be enabled to use this functionality.
+ *
+ * @param[in]   timestamp_func   Function returning the current timestamp, or NULL to stop
+ *                               measuring.
+ */
+void app_sched_timestamp_func_set(app_sched_timestamp_func_t timestamp_func);
+
+/**@brief Function for getting the statistics of a priority level.
+ *
+ * @note @ref APP_SCHEDULER_WITH_PROFILER must be enabled to use this functionality.
+ *
+ * @param[in]   priority   Priority level.
+ * @param[out]  p_stats    Statistics of the level.
+ *
+ * @retval      NRF_SUCCESS               Statistics were copied.
+ * @retval      NRF_ERROR_INVALID_PARAM   Invalid priority level or NULL pointer.
+ */
+uint32_t app_sched_level_stats_get(uint8_t priority, app_sched_level_stats_t * p_stats);
+#endif
+
 /**@brief Function for getting the current amount of free space in the queue.
  *
  * @details The real amount of free space may be less if entries are being added from an interrupt.
  *          To get the sxact value, this function should be called from the critical section.
+ *          With several priority levels, the queue of @ref APP_SCHEDULER_DEFAULT_PRIORITY is
+ *          checked. With @ref APP_SCHEDULER_VARIABLE_SIZE, the number of events of the maximum
+ *          size that still fit is returned.
  *
  * @return Amount of free space in the queue.
  */
@@ -66,19 +66,50 @@ static const uint32_t k[64] = {
 };
 
 
+/**@brief One SHA-256 compression round. The caller rotates the working variables by naming them
+ *        in a different order for each of eight consecutive rounds, so no copies are needed.
+ */
+#define SHA256_ROUND(a,b,c,d,e,f,g,h,i,w)               \
+    do {                                                \
+        uint32_t t1 = h + EP1(e) + CH(e,f,g) + k[i] + (w); \
+        d += t1;                                        \
+        h  = t1 + EP0(a) + MAJ(a,b,c);                  \
+    } while (0)
+
+/**@brief Message schedule word i (i >= 16), computed in place in a 16-word circular buffer. */
+#define SHA256_SCHEDULE(m,i)                                                        \
+    (m[(i) & 15] += SIG1(m[((i) - 2) & 15]) + m[((i) - 7) & 15] + SIG0(m[((i) - 15) & 15]))
+
+/**@brief Eight rounds, starting at round i, with the message word supplied by macro W. */
+#define SHA256_ROUNDS_8(W, i)                              \
+    do {                                                   \
+        SHA256_ROUND(a,b,c,d,e,f,g,h,(i) + 0,W(m,(i) + 0)); \
+        SHA256_ROUND(h,a,b,c,d,e,f,g,(i) + 1,W(m,(i) + 1)); \
+        SHA256_ROUND(g,h,a,b,c,d,e,f,(i) + 2,W(m,(i) + 2)); \
+        SHA256_ROUND(f,g,h,a,b,c,d,e,(i) + 3,W(m,(i) + 3)); \
+        SHA256_ROUND(e,f,g,h,a,b,c,d,(i) + 4,W(m,(i) + 4)); \
+        SHA256_ROUND(d,e,f,g,h,a,b,c,(i) + 5,W(m,(i) + 5)); \
+        SHA256_ROUND(c,d,e,f,g,h,a,b,(i) + 6,W(m,(i) + 6)); \
+        SHA256_ROUND(b,c,d,e,f,g,h,a,(i) + 7,W(m,(i) + 7)); \
+    } while (0)
+
+#define SHA256_LOADED(m,i) (m[(i)])
+
+
 /**@brief Function for calculating the hash of a 64-byte section of data.
+ *
+ * @details The rounds are unrolled eight at a time and the message schedule is computed on the
+ *          fly in a 16-word buffer instead of being expanded to 64 words up front.
  *
  * @param[in,out] ctx   Hash instance.
  * @param[in]     data  Aray with data to be hashed. Assumed to be 64 bytes long.
  */
 void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
 {
-    uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+    uint32_t a, b, c, d, e, f, g, h, i, j, m[16];
 
     for (i = 0, j = 0; i < 16; ++i, j += 4)
-        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-    for ( ; i < 64; ++i)
-        m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+        m[i] = ((uint32_t)data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
 
     a = ctx->state[0];
     b = ctx->state[1];
@@ -89,17 +120,10 @@ void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
     g = ctx->state[6];
     h = ctx->state[7];
 
-    for (i = 0; i < 64; ++i) {
-        t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-        t2 = EP0(a) + MAJ(a,b,c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
+    SHA256_ROUNDS_8(SHA256_LOADED, 0);
+    SHA256_ROUNDS_8(SHA256_LOADED, 8);
+    for (i = 16; i < 64; i += 8) {
+        SHA256_ROUNDS_8(SHA256_SCHEDULE, i);
     }
 
     ctx->state[0] += a;
@@ -140,16 +164,58 @@ ret_code_t sha256_update(sha256_context_t *ctx, const uint8_t * data, size_t len
         return NRF_ERROR_NULL;
     }
 
-    uint32_t i;
+    // Complete a partially filled block first.
+    if (ctx->datalen > 0) {
+        size_t fill = MIN(len, 64 - ctx->datalen);
+
+        memcpy(&ctx->data[ctx->datalen], data, fill);
+        ctx->datalen += fill;
+        data         += fill;
+        len          -= fill;
 
-    for (i = 0; i < len; ++i) {
-        ctx->data[ctx->datalen] = data[i];
-        ctx->datalen++;
-        if (ctx->datalen == 64) {
-            sha256_transform(ctx, ctx->data);
-            ctx->bitlen += 512;
-            ctx->datalen = 0;
+        if (ctx->datalen < 64) {
+            return NRF_SUCCESS;
         }
+
+        sha256_transform(ctx, ctx->data);
+        ctx->bitlen += 512;
+        ctx->datalen = 0;
+    }
+
+    // Hash full blocks directly from the caller's buffer.
+    while (len >= 64) {
+        sha256_transform(ctx, data);
+        ctx->bitlen += 512;
+        data        += 64;
+        len         -= 64;
+    }
+
+    // Keep the tail for the next call.
+    if (len > 0) {
+        memcpy(ctx->data, data, len);
+        ctx->datalen = len;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t sha256_update_multi(sha256_context_t * const * ctx,
+                               const uint8_t * const *    data,
+                               const size_t *             len,
+                               uint32_t                   count)
+{
+    ret_code_t err_code;
+    uint32_t   i;
+
+    VERIFY_PARAM_NOT_NULL(ctx);
+    VERIFY_PARAM_NOT_NULL(data);
+    VERIFY_PARAM_NOT_NULL(len);
+
+    for (i = 0; i < count; ++i) {
+        VERIFY_PARAM_NOT_NULL(ctx[i]);
+        err_code = sha256_update(ctx[i], data[i], len[i]);
+        VERIFY_SUCCESS(err_code);
     }
 
     return NRF_SUCCESS;
@@ -101,6 +101,25 @@ ret_code_t sha256_init(sha256_context_t *ctx);
  */
 ret_code_t sha256_update(sha256_context_t *ctx, const uint8_t * data, const size_t len);
 
+/**@brief Function for hashing data into several independent hash instances in one call.
+ *
+ * @details Equivalent to calling @ref sha256_update once for each instance. The streams are
+ *          hashed one after another, each with the full-block fast path of @ref sha256_update.
+ *
+ * @param[in,out] ctx    Array of @p count hash instances.
+ * @param[in]     data   Array of @p count pointers to the data for each instance.
+ * @param[in]     len    Array of @p count data lengths.
+ * @param[in]     count  Number of instances.
+ *
+ * @retval NRF_SUCCESS     If the data was successfully hashed.
+ * @retval NRF_ERROR_NULL  If a parameter was NULL, or a data pointer was NULL while its length
+ *                         was not zero.
+ */
+ret_code_t sha256_update_multi(sha256_context_t * const * ctx,
+                               const uint8_t * const *    data,
+                               const size_t *             len,
+                               uint32_t                   count);
+
 /**@brief Function for extracting the hash value from a hash instance.
  *
  * @details This function should be called after all data to be hashed has been passed to the hash
@@ -131,14 +131,35 @@ extern "C" {
 typedef void (*app_timer_timeout_handler_t)(void * p_context);
 
 #ifdef APP_TIMER_V2
+/**@brief Queue of active timers that keeps them sorted in a linked list (O(n) start and stop). */
+#define APP_TIMER_QUEUE_SORTLIST    0
+/**@brief Queue of active timers that keeps them in a binary heap (O(log n) start and stop). */
+#define APP_TIMER_QUEUE_HEAP        1
+
+#ifndef APP_TIMER_CONFIG_QUEUE_BACKEND
+#define APP_TIMER_CONFIG_QUEUE_BACKEND APP_TIMER_QUEUE_SORTLIST
+#endif
+
+#ifndef APP_TIMER_CONFIG_SLACK_ENABLED
+#define APP_TIMER_CONFIG_SLACK_ENABLED 0
+#endif
+
 /**
  * @brief app_timer control block
  */
 typedef struct
 {
+#if (APP_TIMER_CONFIG_QUEUE_BACKEND == APP_TIMER_QUEUE_HEAP)
+    uint32_t                    seq;           /**< Order in which the timer was queued. Breaks ties between equal end values. */
+    uint16_t                    heap_idx;      /**< Position in the heap plus one, or 0 if the timer is not queued. */
+#else
     nrf_sortlist_item_t         list_item;     /**< Token used by sortlist. */
+#endif
     uint64_t                    end_val;       /**< RTC counter value when timer expires. */
     uint32_t                    repeat_period; /**< Repeat period (0 if single shot mode). */
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+    uint32_t                    slack;         /**< Number of ticks the expiration may be delayed to share a wakeup with other timers. */
+#endif
     app_timer_timeout_handler_t handler;       /**< User handler. */
     void *                      p_context;     /**< User context. */
     NRF_LOG_INSTANCE_PTR_DECLARE(p_log)        /**< Pointer to instance of the logger object (Conditionally compiled). */
@@ -241,6 +262,44 @@ ret_code_t app_timer_create(app_timer_id_t const *      p_timer_id,
  */
 ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context);
 
+#if defined(APP_TIMER_V2) && APP_TIMER_CONFIG_SLACK_ENABLED
+/**@brief Function for starting a timer that tolerates a delayed expiration.
+ *
+ * The timer expires no earlier than @p timeout_ticks and no later than @p timeout_ticks +
+ * @p slack_ticks from now. Within that window, the expiration is moved so that it shares a single
+ * RTC wakeup with other timers whose windows overlap. A repeated timer keeps its nominal period;
+ * the slack applies to each expiration separately and does not accumulate.
+ *
+ * @param[in]       timer_id      Timer identifier.
+ * @param[in]       timeout_ticks Number of ticks (of RTC1, including prescaling) to time-out event
+ *                                (minimum 5 ticks).
+ * @param[in]       slack_ticks   Number of ticks the time-out event may be delayed. 0 behaves as
+ *                                @ref app_timer_start.
+ * @param[in]       p_context     General purpose pointer. Will be passed to the time-out handler when
+ *                                the timer expires.
+ *
+ * @retval     NRF_SUCCESS               If the timer was successfully started.
+ * @retval     NRF_ERROR_NO_MEM          If the timer operations queue was full.
+ *
+ * @note APP_TIMER_CONFIG_SLACK_ENABLED must be enabled to use this functionality.
+ */
+ret_code_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                      uint32_t       timeout_ticks,
+                                      uint32_t       slack_ticks,
+                                      void *         p_context);
+
+/**@brief Function for getting the number of RTC wakeups saved by merging timer expirations.
+ *
+ * A wakeup is counted as saved for every timer that expired in the same RTC interrupt as a timer
+ * with an earlier end value.
+ *
+ * @note APP_TIMER_CONFIG_SLACK_ENABLED must be enabled to use this functionality.
+ *
+ * @return Number of saved wakeups since initialization.
+ */
+uint32_t app_timer_saved_wakeups_get(void);
+#endif
+
 /**@brief Function for stopping the specified timer.
  *
  * @param[in]  timer_id                  Timer identifier.
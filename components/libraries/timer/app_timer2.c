@@ -99,13 +99,30 @@ static app_timer_t * volatile mp_active_timer; /**< Timer currently handled by R
 static bool                   m_global_active; /**< Flag used to globally disable all timers. */
 static uint64_t m_base_counter;
 static uint64_t m_stamp64;
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+static uint64_t m_active_deadline; /**< Tick for which the RTC compare of the active timer is set. */
+static uint64_t m_wakeup_end_val;  /**< End value of the last timer expired in the current interrupt. */
+static bool     m_wakeup_expired;  /**< Flag indicating that a timer expired in the current interrupt. */
+static uint32_t m_saved_wakeups;   /**< Number of expirations that shared a wakeup with an earlier one. */
+#endif
 
 /* Request FIFO instance. */
 NRF_ATFIFO_DEF(m_req_fifo, timer_req_t, APP_TIMER_CONFIG_OP_QUEUE_SIZE);
 
+#if (APP_TIMER_CONFIG_QUEUE_BACKEND == APP_TIMER_QUEUE_HEAP)
+#if (APP_TIMER_CONFIG_HEAP_SIZE < 1) || (APP_TIMER_CONFIG_HEAP_SIZE > 0xFFFE)
+#error "APP_TIMER_CONFIG_HEAP_SIZE must be between 1 and 65534."
+#endif
+
+/* Binary min-heap of queued timers, ordered by end value. */
+static app_timer_t * m_timer_heap[APP_TIMER_CONFIG_HEAP_SIZE];
+static uint16_t      m_timer_heap_cnt;
+static uint32_t      m_timer_heap_seq;
+#else
 /* Sortlist instance. */
 static bool compare_func(nrf_sortlist_item_t * p_item0, nrf_sortlist_item_t *p_item1);
 NRF_SORTLIST_DEF(m_app_timer_sortlist, compare_func); /**< Sortlist used for storing queued timers. */
+#endif
 
 /**
  * @brief Return current 64 bit timestamp
@@ -124,6 +141,170 @@ static uint64_t get_now(void)
 
     return now;
 }
+
+#if (APP_TIMER_CONFIG_QUEUE_BACKEND == APP_TIMER_QUEUE_HEAP)
+/**
+ * @brief Function used for comparing timers in the heap.
+ *
+ * Timers with equal end values are ordered by the time they were queued, as in the sorted list.
+ */
+static inline bool heap_less(app_timer_t const * p0, app_timer_t const * p1)
+{
+    if (p0->end_val != p1->end_val)
+    {
+        return (p0->end_val < p1->end_val);
+    }
+    return ((int32_t)(p0->seq - p1->seq) < 0);
+}
+
+static inline void heap_place(app_timer_t * p_timer, uint16_t idx)
+{
+    m_timer_heap[idx] = p_timer;
+    p_timer->heap_idx = idx + 1;
+}
+
+static void heap_sift_up(uint16_t idx)
+{
+    app_timer_t * p_timer = m_timer_heap[idx];
+
+    while (idx > 0)
+    {
+        uint16_t parent = (idx - 1) / 2;
+        if (!heap_less(p_timer, m_timer_heap[parent]))
+        {
+            break;
+        }
+        heap_place(m_timer_heap[parent], idx);
+        idx = parent;
+    }
+    heap_place(p_timer, idx);
+}
+
+static void heap_sift_down(uint16_t idx)
+{
+    app_timer_t * p_timer = m_timer_heap[idx];
+
+    while (true)
+    {
+        uint32_t child = 2 * (uint32_t)idx + 1;
+        if (child >= m_timer_heap_cnt)
+        {
+            break;
+        }
+        if ((child + 1 < m_timer_heap_cnt) &&
+            heap_less(m_timer_heap[child + 1], m_timer_heap[child]))
+        {
+            child++;
+        }
+        if (!heap_less(m_timer_heap[child], p_timer))
+        {
+            break;
+        }
+        heap_place(m_timer_heap[child], idx);
+        idx = (uint16_t)child;
+    }
+    heap_place(p_timer, idx);
+}
+
+/**
+ * @brief Function for adding a timer to the queue of timers waiting for expiration.
+ */
+static void timer_queue_add(app_timer_t * p_timer)
+{
+    if (p_timer->heap_idx != 0)
+    {
+        /* Already queued. */
+        return;
+    }
+
+    if (m_timer_heap_cnt == APP_TIMER_CONFIG_HEAP_SIZE)
+    {
+        NRF_LOG_ERROR("Timer heap full, increase APP_TIMER_CONFIG_HEAP_SIZE.");
+        ASSERT(0);
+        p_timer->active = false;
+        return;
+    }
+
+    p_timer->seq = m_timer_heap_seq++;
+    m_timer_heap[m_timer_heap_cnt] = p_timer;
+    heap_sift_up(m_timer_heap_cnt++);
+}
+
+/**
+ * @brief Function for removing a timer from the queue.
+ *
+ * @return True if the timer was queued.
+ */
+static bool timer_queue_remove(app_timer_t * p_timer)
+{
+    uint16_t idx;
+
+    if (p_timer->heap_idx == 0)
+    {
+        return false;
+    }
+
+    idx = p_timer->heap_idx - 1;
+    p_timer->heap_idx = 0;
+    m_timer_heap_cnt--;
+
+    if (idx != m_timer_heap_cnt)
+    {
+        /* Fill the hole with the last timer, which might have to move either way. */
+        m_timer_heap[idx] = m_timer_heap[m_timer_heap_cnt];
+        if ((idx > 0) && heap_less(m_timer_heap[idx], m_timer_heap[(idx - 1) / 2]))
+        {
+            heap_sift_up(idx);
+        }
+        else
+        {
+            heap_sift_down(idx);
+        }
+    }
+    return true;
+}
+
+static inline app_timer_t * timer_queue_peek(void)
+{
+    return (m_timer_heap_cnt > 0) ? m_timer_heap[0] : NULL;
+}
+
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+/**
+ * @brief Function for lowering the deadline to the latest expiration allowed by the queued timers
+ *        that are due before it.
+ *
+ * Children are never due before their parent, so the walk stops at the first timer that is due
+ * after the deadline. Recursion depth is bounded by the height of the heap.
+ */
+static void heap_deadline_update(uint32_t idx, uint64_t * p_deadline)
+{
+    if ((idx >= m_timer_heap_cnt) || (m_timer_heap[idx]->end_val > *p_deadline))
+    {
+        return;
+    }
+    *p_deadline = MIN(*p_deadline, m_timer_heap[idx]->end_val + m_timer_heap[idx]->slack);
+    heap_deadline_update(2 * idx + 1, p_deadline);
+    heap_deadline_update(2 * idx + 2, p_deadline);
+}
+
+static inline uint64_t timer_queue_deadline(uint64_t deadline)
+{
+    heap_deadline_update(0, &deadline);
+    return deadline;
+}
+#endif
+
+static inline app_timer_t * timer_queue_pop(void)
+{
+    app_timer_t * p_timer = timer_queue_peek();
+    if (p_timer)
+    {
+        UNUSED_RETURN_VALUE(timer_queue_remove(p_timer));
+    }
+    return p_timer;
+}
+#else
 /**
  * @brief Function used for comparing items in sorted list.
  */
@@ -137,6 +318,78 @@ static inline bool compare_func(nrf_sortlist_item_t * p_item0, nrf_sortlist_item
     return (p0_end <= p1_end) ? true : false;
 }
 
+/**
+ * @brief Function for adding a timer to the queue of timers waiting for expiration.
+ */
+static inline void timer_queue_add(app_timer_t * p_timer)
+{
+    nrf_sortlist_add(&m_app_timer_sortlist, &p_timer->list_item);
+}
+
+/**
+ * @brief Function for removing a timer from the queue.
+ *
+ * @return True if the timer was queued.
+ */
+static inline bool timer_queue_remove(app_timer_t * p_timer)
+{
+    return nrf_sortlist_remove(&m_app_timer_sortlist, &p_timer->list_item);
+}
+
+static inline app_timer_t * timer_queue_pop(void)
+{
+    nrf_sortlist_item_t * p_next_item = nrf_sortlist_pop(&m_app_timer_sortlist);
+    return p_next_item ? CONTAINER_OF(p_next_item, app_timer_t, list_item) : NULL;
+}
+
+static inline app_timer_t * timer_queue_peek(void)
+{
+    nrf_sortlist_item_t const * p_next_item = nrf_sortlist_peek(&m_app_timer_sortlist);
+    return p_next_item ? CONTAINER_OF(p_next_item, app_timer_t, list_item) : NULL;
+}
+
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+/**
+ * @brief Function for lowering the deadline to the latest expiration allowed by the queued timers
+ *        that are due before it.
+ */
+static uint64_t timer_queue_deadline(uint64_t deadline)
+{
+    nrf_sortlist_item_t const * p_item = nrf_sortlist_peek(&m_app_timer_sortlist);
+
+    while (p_item)
+    {
+        app_timer_t const * p_timer = CONTAINER_OF(p_item, app_timer_t, list_item);
+        if (p_timer->end_val > deadline)
+        {
+            break;
+        }
+        deadline = MIN(deadline, p_timer->end_val + p_timer->slack);
+        p_item   = nrf_sortlist_next(p_item);
+    }
+    return deadline;
+}
+#endif
+#endif
+
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+/**
+ * @brief Function for counting expirations that did not need a wakeup of their own.
+ *
+ * Timers expire in order of end value, so every new end value seen in the same interrupt would
+ * otherwise have required a separate RTC compare event.
+ */
+static void wakeup_account(app_timer_t const * p_timer)
+{
+    if (m_wakeup_expired && (p_timer->end_val != m_wakeup_end_val))
+    {
+        m_saved_wakeups++;
+    }
+    m_wakeup_expired = true;
+    m_wakeup_end_val = p_timer->end_val;
+}
+#endif
+
 #if APP_TIMER_CONFIG_USE_SCHEDULER
 static void scheduled_timeout_handler(void * p_event_data, uint16_t event_size)
 {
@@ -166,6 +419,9 @@ static bool timer_expire(app_timer_t * p_timer)
     {
         if (get_now() >= p_timer->end_val) {
             /* timer expired */
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+            wakeup_account(p_timer);
+#endif
             if (p_timer->repeat_period == 0)
             {
                 p_timer->active = false;
@@ -187,13 +443,13 @@ static bool timer_expire(app_timer_t * p_timer)
             if ((p_timer->repeat_period) && (p_timer->active))
             {
                 p_timer->end_val += p_timer->repeat_period;
-                nrf_sortlist_add(&m_app_timer_sortlist, &p_timer->list_item);
+                timer_queue_add(p_timer);
                 ret = true;
             }
         }
         else
         {
-            nrf_sortlist_add(&m_app_timer_sortlist, &p_timer->list_item);
+            timer_queue_add(p_timer);
             ret = true;
         }
     }
@@ -206,6 +462,9 @@ static bool timer_expire(app_timer_t * p_timer)
  * It is possible that RTC driver will indicate that timeout already occured. In that case timer
  * expires and function indicates that RTC was not configured.
  *
+ * If slack is enabled, the compare is set to the latest tick allowed by the timer and by all
+ * queued timers due before that tick, so that they expire in a single interrupt.
+ *
  * @param          p_timer Timer instance.
  * @param [in,out] p_rerun Flag indicating that sortlist reevaluation is required.
  *
@@ -217,16 +476,27 @@ static bool rtc_schedule(app_timer_t * p_timer, bool * p_rerun)
 {
     ret_code_t ret = NRF_ERROR_TIMEOUT;
     *p_rerun = false;
-    int64_t remaining = (int64_t)(p_timer->end_val - get_now());
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+    uint64_t now      = get_now();
+    uint64_t deadline = (p_timer->end_val > now) ?
+                        timer_queue_deadline(p_timer->end_val + p_timer->slack) : p_timer->end_val;
+    int64_t remaining = (int64_t)(deadline - now);
+#else
+    uint64_t deadline = p_timer->end_val;
+    int64_t remaining = (int64_t)(deadline - get_now());
+#endif
 
     if (remaining > 0) {
         uint32_t cc_val = ((uint32_t)remaining > APP_TIMER_RTC_MAX_VALUE) ?
-                (app_timer_cnt_get() + APP_TIMER_RTC_MAX_VALUE) : p_timer->end_val;
+                (app_timer_cnt_get() + APP_TIMER_RTC_MAX_VALUE) : deadline;
 
         ret = drv_rtc_windowed_compare_set(&m_rtc_inst, 0, cc_val, APP_TIMER_SAFE_WINDOW);
         NRF_LOG_DEBUG("Setting CC to 0x%08x (err: %d)", cc_val & DRV_RTC_MAX_CNT, ret);
         if (ret == NRF_SUCCESS)
         {
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+            m_active_deadline = deadline;
+#endif
             return true;
         }
     }
@@ -248,18 +518,6 @@ static bool rtc_schedule(app_timer_t * p_timer, bool * p_rerun)
     return false;
 }
 
-static inline app_timer_t * sortlist_pop(void)
-{
-    nrf_sortlist_item_t * p_next_item = nrf_sortlist_pop(&m_app_timer_sortlist);
-    return p_next_item ? CONTAINER_OF(p_next_item, app_timer_t, list_item) : NULL;
-}
-
-static inline app_timer_t * sortlist_peek(void)
-{
-    nrf_sortlist_item_t const * p_next_item = nrf_sortlist_peek(&m_app_timer_sortlist);
-    return p_next_item ? CONTAINER_OF(p_next_item, app_timer_t, list_item) : NULL;
-}
-
 /**
  * @brief Function for deactivating all timers which are in the sorted list (active timers).
  */
@@ -268,7 +526,7 @@ static void sorted_list_stop_all(void)
     app_timer_t * p_next;
     do
     {
-        p_next = sortlist_pop();
+        p_next = timer_queue_pop();
         if (p_next)
         {
             p_next->active = false;
@@ -328,7 +586,7 @@ static void rtc_update(drv_rtc_t const * const  p_instance)
 {
     while(1)
     {
-        app_timer_t * p_next = sortlist_peek();
+        app_timer_t * p_next = timer_queue_peek();
         bool rtc_reconf = false;
         if (p_next) //Candidate for active timer
         {
@@ -337,7 +595,11 @@ static void rtc_update(drv_rtc_t const * const  p_instance)
                 //There is no active timer so candidate will become active timer.
                 rtc_reconf = true;
             }
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+            else if (timer_queue_deadline(m_active_deadline) < m_active_deadline)
+#else
             else if (p_next->end_val < mp_active_timer->end_val)
+#endif
             {
                 //Candidate has shorter timeout than current active timer. Candidate will replace active timer.
                 //Active timer is put back into sorted list.
@@ -345,14 +607,14 @@ static void rtc_update(drv_rtc_t const * const  p_instance)
                 if (mp_active_timer->active)
                 {
                     NRF_LOG_INST_DEBUG(mp_active_timer->p_log, "Timer preempted.");
-                    nrf_sortlist_add(&m_app_timer_sortlist, &mp_active_timer->list_item);
+                    timer_queue_add(mp_active_timer);
                 }
             }
 
             if (rtc_reconf)
             {
                 bool rerun;
-                p_next = sortlist_pop();
+                p_next = timer_queue_pop();
                 NRF_LOG_INST_DEBUG(p_next->p_log, "Activating timer (CC:%d/%08x).", p_next->end_val, p_next->end_val);
                 if (rtc_schedule(p_next, &rerun))
                 {
@@ -410,7 +672,7 @@ static void timer_req_process(drv_rtc_t const * const  p_instance)
                 if (!p_req->p_timer->active)
                 {
                     p_req->p_timer->active = true;
-                    nrf_sortlist_add(&m_app_timer_sortlist, &(p_req->p_timer->list_item));
+                    timer_queue_add(p_req->p_timer);
                     NRF_LOG_INST_DEBUG(p_req->p_timer->p_log,"Start request (expiring at %d/0x%08x).",
                                                   p_req->p_timer->end_val, p_req->p_timer->end_val);
                 }
@@ -422,10 +684,10 @@ static void timer_req_process(drv_rtc_t const * const  p_instance)
                 }
                 else
                 {
-                    bool found = nrf_sortlist_remove(&m_app_timer_sortlist, &(p_req->p_timer->list_item));
+                    bool found = timer_queue_remove(p_req->p_timer);
                     if (!found)
                     {
-                         NRF_LOG_INFO("Timer not found on sortlist (stopping expired timer).");
+                         NRF_LOG_INFO("Timer not found in queue (stopping expired timer).");
                     }
                 }
                 NRF_LOG_INST_DEBUG(p_req->p_timer->p_log,"Stop request.");
@@ -456,6 +718,9 @@ static void timer_req_process(drv_rtc_t const * const  p_instance)
 
 static void rtc_irq(drv_rtc_t const * const  p_instance)
 {
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+    m_wakeup_expired = false;
+#endif
     if (drv_rtc_overflow_pending(p_instance))
     {
         on_overflow_evt();
@@ -571,6 +836,9 @@ ret_code_t app_timer_create(app_timer_id_t const *      p_timer_id,
 
 ret_code_t app_timer_start(app_timer_t * p_timer, uint32_t timeout_ticks, void * p_context)
 {
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+    return app_timer_start_with_slack(p_timer, timeout_ticks, 0, p_context);
+#else
     ASSERT(p_timer);
     app_timer_t * p_t = (app_timer_t *) p_timer;
 
@@ -587,9 +855,42 @@ ret_code_t app_timer_start(app_timer_t * p_timer, uint32_t timeout_ticks, void *
         p_t->repeat_period = timeout_ticks;
     }
 
+    return timer_req_schedule(TIMER_REQ_START, p_t);
+#endif
+}
+
+#if APP_TIMER_CONFIG_SLACK_ENABLED
+ret_code_t app_timer_start_with_slack(app_timer_t * p_timer,
+                                      uint32_t      timeout_ticks,
+                                      uint32_t      slack_ticks,
+                                      void *        p_context)
+{
+    ASSERT(p_timer);
+    app_timer_t * p_t = (app_timer_t *) p_timer;
+
+    if (p_t->active)
+    {
+        return NRF_SUCCESS;
+    }
+
+    p_t->p_context = p_context;
+    p_t->end_val   = get_now() + timeout_ticks;
+    p_t->slack     = slack_ticks;
+
+    if (p_t->repeat_period)
+    {
+        p_t->repeat_period = timeout_ticks;
+    }
+
     return timer_req_schedule(TIMER_REQ_START, p_t);
 }
 
+uint32_t app_timer_saved_wakeups_get(void)
+{
+    return m_saved_wakeups;
+}
+#endif
+
 
 ret_code_t app_timer_stop(app_timer_t * p_timer)
 {
@@ -1609,6 +1609,13 @@
 
 // </e>
 
+// <q> BLE_NUS_STREAM_ENABLED  - Enables the TX stream API. Requires nrf_ringbuf, nrf_ble_gatt and app_timer.
+ 
+
+#ifndef BLE_NUS_STREAM_ENABLED
+#define BLE_NUS_STREAM_ENABLED 0
+#endif
+
 // </e>
 
 // <q> BLE_RSCS_C_ENABLED  - ble_rscs_c - Running Speed and Cadence Client
@@ -7054,6 +7061,38 @@
 #define APP_SCHEDULER_WITH_PROFILER 0
 #endif
 
+// <o> APP_SCHEDULER_PRIORITY_LEVELS - Number of event priority levels. <1-8> 
+// <i> Each level has its own queue of QUEUE_SIZE entries. With 1 level, the scheduler
+// <i> has a single FIFO queue.
+
+#ifndef APP_SCHEDULER_PRIORITY_LEVELS
+#define APP_SCHEDULER_PRIORITY_LEVELS 1
+#endif
+
+// <o> APP_SCHEDULER_DEFAULT_PRIORITY - Priority level used by app_sched_event_put. <0-7> 
+// <i> 0 is the highest priority. Must be lower than APP_SCHEDULER_PRIORITY_LEVELS.
+
+#ifndef APP_SCHEDULER_DEFAULT_PRIORITY
+#define APP_SCHEDULER_DEFAULT_PRIORITY 0
+#endif
+
+// <o> APP_SCHEDULER_STARVATION_LIMIT - Number of events a pending level waits for higher levels. <0-65535> 
+// <i> When a pending level has waited for this many events from other levels, its next
+// <i> event is executed first. 0 means strict priority.
+
+#ifndef APP_SCHEDULER_STARVATION_LIMIT
+#define APP_SCHEDULER_STARVATION_LIMIT 8
+#endif
+
+// <q> APP_SCHEDULER_VARIABLE_SIZE  - Pack events by their size
+ 
+
+// <i> Each event takes only the space of its own data in the queue, instead of the size of the largest event.
+
+#ifndef APP_SCHEDULER_VARIABLE_SIZE
+#define APP_SCHEDULER_VARIABLE_SIZE 0
+#endif
+
 // </e>
 
 // <e> APP_SDCARD_ENABLED - app_sdcard - SD/MMC card support using SPI
@@ -7174,6 +7213,35 @@
 #define APP_TIMER_SAFE_WINDOW_MS 300000
 #endif
 
+// <o> APP_TIMER_CONFIG_QUEUE_BACKEND  - Data structure holding the active timers.
+ 
+// <i> The sorted list costs O(n) to start or stop a timer, where n is the number of active timers.
+// <i> The binary heap costs O(log n), and uses a statically allocated array of APP_TIMER_CONFIG_HEAP_SIZE pointers.
+// <0=> Sorted list 
+// <1=> Binary heap 
+
+#ifndef APP_TIMER_CONFIG_QUEUE_BACKEND
+#define APP_TIMER_CONFIG_QUEUE_BACKEND 0
+#endif
+
+// <o> APP_TIMER_CONFIG_HEAP_SIZE - Maximum number of timers that can be active at the same time. <1-65534> 
+// <i> Only used by the binary heap.
+
+#ifndef APP_TIMER_CONFIG_HEAP_SIZE
+#define APP_TIMER_CONFIG_HEAP_SIZE 32
+#endif
+
+// <q> APP_TIMER_CONFIG_SLACK_ENABLED  - Enable app_timer_start_with_slack and wakeup coalescing.
+ 
+
+// <i> Timers started with a slack window may expire late, within that window, so that
+// <i> expirations with overlapping windows share one RTC wakeup. The number of saved
+// <i> wakeups is returned by app_timer_saved_wakeups_get.
+
+#ifndef APP_TIMER_CONFIG_SLACK_ENABLED
+#define APP_TIMER_CONFIG_SLACK_ENABLED 0
+#endif
+
 // <h> App Timer Legacy configuration - Legacy configuration.
 
 //==========================================================
@@ -7530,19 +7598,48 @@
 #define APP_USBD_MSC_ENABLED 0
 #endif
 
-// <q> CRC16_ENABLED  - crc16 - CRC16 calculation routines
- 
-
+// <e> CRC16_ENABLED - crc16 - CRC16 calculation routines
+//==========================================================
 #ifndef CRC16_ENABLED
 #define CRC16_ENABLED 0
 #endif
-
-// <q> CRC32_ENABLED  - crc32 - CRC32 calculation routines
+// <o> CRC16_CONFIG_MODE  - CRC16 computation engine.
  
 
+// <i> Bitwise needs no lookup table. Nibble table uses a 32-byte table in flash.
+// <i> Byte table uses a 512-byte table in flash and processes one byte per lookup.
+// <i> Slice-by-4 uses a 2 kB table in flash and processes word-aligned data one word
+// <i> per iteration.
+// <0=> Bitwise 
+// <1=> Nibble table 
+// <2=> Byte table 
+// <3=> Slice-by-4 
+
+#ifndef CRC16_CONFIG_MODE
+#define CRC16_CONFIG_MODE 0
+#endif
+
+// </e>
+
+// <e> CRC32_ENABLED - crc32 - CRC32 calculation routines
+//==========================================================
 #ifndef CRC32_ENABLED
 #define CRC32_ENABLED 0
 #endif
+// <o> CRC32_CONFIG_MODE  - CRC32 computation engine.
+ 
+
+// <i> Bitwise needs no lookup table. Table uses a 1 kB table in flash.
+// <i> Slice-by-8 uses an 8 kB table in flash and processes eight bytes per iteration.
+// <0=> Bitwise 
+// <1=> Table 
+// <2=> Slice-by-8 
+
+#ifndef CRC32_CONFIG_MODE
+#define CRC32_CONFIG_MODE 0
+#endif
+
+// </e>
 
 // <q> ECC_ENABLED  - ecc - Elliptic Curve Cryptography Library
  
@@ -7666,6 +7763,109 @@
 // </h> 
 //==========================================================
 
+// <h> GC - Garbage collection
+
+//==========================================================
+// <e> FDS_GC_AUTO_ENABLED - Run incremental garbage collection automatically.
+
+// <i> When the space taken up by deleted records reaches a threshold, FDS queues incremental garbage collection steps (see fds_gc_step()) on its own.
+// <i> Each step yields to other queued operations, which bounds how long writes wait behind garbage collection.
+//==========================================================
+#ifndef FDS_GC_AUTO_ENABLED
+#define FDS_GC_AUTO_ENABLED 0
+#endif
+// <o> FDS_GC_AUTO_THRESHOLD_WORDS - Deleted record words that trigger garbage collection. 
+// <i> After a garbage collection run has finished, the next run starts only when more words are deleted or a record is closed.
+
+#ifndef FDS_GC_AUTO_THRESHOLD_WORDS
+#define FDS_GC_AUTO_THRESHOLD_WORDS 512
+#endif
+
+// <o> FDS_GC_AUTO_STEP_FLASH_OPS - Flash operations budget of each automatic step. 
+// <i> Zero collects exactly one page per step. Otherwise, a step collects further pages until it has issued this many flash operations.
+// <i> A step only stops between pages, so it always copies the records of at least one page and erases it.
+
+#ifndef FDS_GC_AUTO_STEP_FLASH_OPS
+#define FDS_GC_AUTO_STEP_FLASH_OPS 0
+#endif
+
+// </e>
+
+// </h> 
+//==========================================================
+
+// <h> Index - RAM index of records
+
+//==========================================================
+// <e> FDS_INDEX_ENABLED - Keep a RAM index of valid records.
+
+// <i> Record lookups (find, open, descriptor resolution) use the index instead of scanning flash.
+// <i> The index is built during initialization and kept up to date on write, update, delete and garbage collection.
+//==========================================================
+#ifndef FDS_INDEX_ENABLED
+#define FDS_INDEX_ENABLED 0
+#endif
+// <o> FDS_INDEX_SIZE - Maximum number of records in the index. 
+// <i> Each entry uses 14 bytes of RAM. If more records are stored in flash, lookups fall back to scanning flash.
+
+#ifndef FDS_INDEX_SIZE
+#define FDS_INDEX_SIZE 64
+#endif
+
+// </e>
+
+// </h> 
+//==========================================================
+
+// <h> Batch - Batched record writes
+
+//==========================================================
+// <e> FDS_WRITE_BATCH_ENABLED - Enable fds_record_write_batch().
+
+// <i> Writes several records next to each other on one page, as a single queued operation.
+// <i> If a step fails, records of the batch that were already committed are deleted again.
+// <i> This is not atomic: a power loss or a failed delete can leave the first records of a batch stored.
+//==========================================================
+#ifndef FDS_WRITE_BATCH_ENABLED
+#define FDS_WRITE_BATCH_ENABLED 0
+#endif
+// <o> FDS_WRITE_BATCH_BUFFER_WORDS - Size of the staging buffer, in 4-byte words. 
+// <i> Headers and data are copied to this buffer and written to flash in chunks of this size.
+// <i> Must be at least 3 (the size of a record header).
+
+#ifndef FDS_WRITE_BATCH_BUFFER_WORDS
+#define FDS_WRITE_BATCH_BUFFER_WORDS 32
+#endif
+
+// </e>
+
+// </h> 
+//==========================================================
+
+// <h> Telemetry - Wear and latency statistics
+
+//==========================================================
+// <q> FDS_TELEMETRY_ENABLED  - Count page erases and measure the latency of operations.
+ 
+
+// <i> Use fds_telemetry_init() to set the time source, and fds_page_erase_count_get() and fds_op_latency_get() to read the statistics.
+
+#ifndef FDS_TELEMETRY_ENABLED
+#define FDS_TELEMETRY_ENABLED 0
+#endif
+
+// <q> FDS_CLI_CMDS  - Enable CLI commands specific to the module
+ 
+
+// <i> Adds the fds status command, and the fds wear and fds latency commands if telemetry is enabled.
+
+#ifndef FDS_CLI_CMDS
+#define FDS_CLI_CMDS 0
+#endif
+
+// </h> 
+//==========================================================
+
 // </e>
 
 // <q> HARDFAULT_HANDLER_ENABLED  - hardfault_default - HardFault default handler for debugging and release
@@ -7943,6 +8143,18 @@
 #define MEM_MANAGER_DISABLE_API_PARAM_CHECK 0
 #endif
 
+// <q> MEM_MANAGER_CONSTANT_TIME_ENABLED  - Use constant time block search.
+ 
+
+// <i> If enabled, free blocks are found using per-category bitmaps and
+// <i> a summary word instead of a linear scan of all blocks, so allocation
+// <i> and freeing take the same time regardless of the pool size.
+// <i> Each block category can have up to 1024 blocks.
+
+#ifndef MEM_MANAGER_CONSTANT_TIME_ENABLED
+#define MEM_MANAGER_CONSTANT_TIME_ENABLED 0
+#endif
+
 // </e>
 
 // <e> NRF_BALLOC_ENABLED - nrf_balloc - Block allocator module
@@ -7950,6 +8162,26 @@
 #ifndef NRF_BALLOC_ENABLED
 #define NRF_BALLOC_ENABLED 1
 #endif
+// <q> NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED  - Enables lock-free mode with 16-bit block indexes.
+ 
+
+// <i> Blocks are kept on a free list updated with compare-and-exchange, so interrupts
+// <i> are not disabled on allocation and pools of up to 65535 blocks are supported.
+
+#ifndef NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED
+#define NRF_BALLOC_CONFIG_LOCK_FREE_ENABLED 0
+#endif
+
+// <o> NRF_BALLOC_CONFIG_MAGAZINE_SIZE - Number of blocks cached per interrupt priority level.  <0-255> 
+// <i> Used only in lock-free mode. Freed blocks are cached for the interrupt priority
+// <i> level on which they are freed and allocated again from that level without
+// <i> touching the shared free list. Thread mode always uses the shared free list
+// <i> because RTOS tasks can preempt each other. 0 disables caching.
+
+#ifndef NRF_BALLOC_CONFIG_MAGAZINE_SIZE
+#define NRF_BALLOC_CONFIG_MAGAZINE_SIZE 0
+#endif
+
 // <e> NRF_BALLOC_CONFIG_DEBUG_ENABLED - Enables debug mode in the module.
 //==========================================================
 #ifndef NRF_BALLOC_CONFIG_DEBUG_ENABLED
@@ -8127,6 +8359,22 @@
 #define NRF_FSTORAGE_SD_MAX_WRITE_SIZE 4096
 #endif
 
+// <e> NRF_FSTORAGE_SD_STATS_ENABLED - Count retries and measure how long the SoftDevice takes to execute flash operations.
+
+// <i> Use nrf_fstorage_sd_stats_init() to set the time source and nrf_fstorage_sd_stats_get() to read the statistics.
+//==========================================================
+#ifndef NRF_FSTORAGE_SD_STATS_ENABLED
+#define NRF_FSTORAGE_SD_STATS_ENABLED 0
+#endif
+// <q> NRF_FSTORAGE_SD_CLI_CMDS  - Enable CLI commands specific to the module
+ 
+
+#ifndef NRF_FSTORAGE_SD_CLI_CMDS
+#define NRF_FSTORAGE_SD_CLI_CMDS 0
+#endif
+
+// </e>
+
 // </h> 
 //==========================================================
 
@@ -8571,6 +8819,55 @@
 #define NRF_LOG_ALLOW_OVERFLOW 1
 #endif
 
+// <q> NRF_LOG_LOCK_FREE_ENABLED  - Reserve space in the log buffer without a critical section.
+ 
+
+// <i> If enabled, concurrent log calls (for example, from interrupts of different
+// <i> priorities) reserve buffer space using atomic compare-and-exchange instead of
+// <i> disabling interrupts. When the buffer is full, new logs are dropped
+// <i> and NRF_LOG_ALLOW_OVERFLOW is ignored.
+
+#ifndef NRF_LOG_LOCK_FREE_ENABLED
+#define NRF_LOG_LOCK_FREE_ENABLED 0
+#endif
+
+// <q> NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED  - Send logs from serial backends (UART, RTT) in binary form.
+ 
+
+// <i> If enabled, logs are not formatted on the device. Raw log entries
+// <i> are sent in binary frames and decoded on the host using
+// <i> external_tools/nrf_log_decoder and the application ELF file.
+
+#ifndef NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED
+#define NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED 0
+#endif
+
+// <e> NRF_LOG_BATCH_DEQUEUE_ENABLED - Enable batched processing of deferred logs.
+
+// <i> If enabled, each call to NRF_LOG_PROCESS drains multiple log entries
+// <i> into a single memory object. Backends that support it format and
+// <i> transmit the whole batch in one transaction.
+//==========================================================
+#ifndef NRF_LOG_BATCH_DEQUEUE_ENABLED
+#define NRF_LOG_BATCH_DEQUEUE_ENABLED 0
+#endif
+// <o> NRF_LOG_BATCH_MAX_ENTRIES - Maximum number of log entries in a single batch. <1-32> 
+
+#ifndef NRF_LOG_BATCH_MAX_ENTRIES
+#define NRF_LOG_BATCH_MAX_ENTRIES 8
+#endif
+
+// <o> NRF_LOG_BATCH_MAX_SIZE - Maximum size of a single batch (in bytes). 
+// <i> A batch is allocated from the pool of memory objects, so this value
+// <i> must not exceed the pool capacity. The first entry is always taken
+// <i> even if it alone exceeds this size.
+
+#ifndef NRF_LOG_BATCH_MAX_SIZE
+#define NRF_LOG_BATCH_MAX_SIZE 64
+#endif
+
+// </e>
+
 // <o> NRF_LOG_BUFSIZE  - Size of the buffer for storing logs (in bytes).
  
 
@@ -7664,6 +7664,16 @@
 #define NRF_LOG_BACKEND_FLASH_SER_BUFFER_SIZE 64
 #endif
 
+// <q> NRF_LOG_BACKEND_FLASH_OVERWRITE_ENABLED  - Erase the oldest page when the flash log area is full.
+ 
+
+// <i> If disabled, the backend stops writing when the area is full, so the earliest logs
+// <i> are kept. Writing resumes after the area is erased (for example, with flashlog clear).
+
+#ifndef NRF_LOG_BACKEND_FLASH_OVERWRITE_ENABLED
+#define NRF_LOG_BACKEND_FLASH_OVERWRITE_ENABLED 0
+#endif
+
 // <h> Flash log location - Configuration of flash area used for storing the logs.
 
 //==========================================================
@@ -1324,6 +1324,17 @@
 #define NRF_DFU_SAVE_PROGRESS_IN_FLASH 0
 #endif
 
+// <q> NRF_DFU_STREAMING_HASH  - Hash the firmware while it is received.
+ 
+
+// <i> Each executed data object is added to a running hash after it is written to flash.
+// <i> The firmware hash is then only finalized when the transfer completes, instead of
+// <i> being computed over the whole image. A hash context is kept in RAM between objects.
+
+#ifndef NRF_DFU_STREAMING_HASH
+#define NRF_DFU_STREAMING_HASH 0
+#endif
+
 // <q> NRF_DFU_SUPPORTS_EXTERNAL_APP  - [Experimental] Support for external app.
  
 
@@ -0,0 +1,454 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, Nordic Semiconductor ASA
+#
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form, except as embedded into a Nordic
+#    Semiconductor ASA integrated circuit in a product or a software update for
+#    such product, must reproduce the above copyright notice, this list of
+#    conditions and the following disclaimer in the documentation and/or other
+#    materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# 4. This software, with or without modification, must only be used with a
+#    Nordic Semiconductor ASA integrated circuit.
+#
+# 5. Any software provided in binary form under this license must not be reverse
+#    engineered, decompiled, modified and/or disassembled.
+#
+# THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+# GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+# OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Decoder for binary nrf_log output.
+
+Serial logger backends (UART, RTT) built with NRF_LOG_BACKEND_SERIAL_BINARY_ENABLED
+send raw logger entries instead of formatted text. This script reads such stream
+and restores the text using format strings and module names taken from the ELF
+file of the application.
+
+Examples:
+    nrf_log_decoder.py app.elf rtt_dump.bin
+    nrf_log_decoder.py app.elf --port /dev/ttyACM0 --baudrate 115200 --freq 32768
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC      = 0xA5
+SYNC_DATA = 0xA6
+
+HEXDUMP_SPLIT_LEN = 240
+
+HEADER_TYPE_STD     = 1
+HEADER_TYPE_HEXDUMP = 2
+
+SEVERITY_NAMES    = [None, 'error', 'warning', 'info', 'debug']
+SEVERITY_INFO_RAW = 5
+
+HEXDUMP_BYTES_IN_LINE = 8
+STD_ADDR_MASK         = (1 << 22) - 1
+
+
+class ElfFile(object):
+    """Minimal ELF reader giving access to loadable sections and symbols."""
+
+    SHT_SYMTAB = 2
+    SHT_NOBITS = 8
+    SHF_ALLOC  = 0x2
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF file' % path)
+
+        self.is_64 = self.data[4] == 2
+        self.endian = '<' if self.data[5] == 1 else '>'
+        self.ptr_size = 8 if self.is_64 else 4
+
+        if self.is_64:
+            shoff, = struct.unpack_from(self.endian + 'Q', self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(self.endian + 'HHH', self.data, 0x3A)
+            sh_fmt = 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(self.endian + 'I', self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(self.endian + 'HHH', self.data, 0x2E)
+            sh_fmt = 'IIIIIIIIII'
+
+        self.sections = []
+        for i in range(shnum):
+            (name, sh_type, flags, addr, offset, size,
+             link, _info, _align, entsize) = struct.unpack_from(self.endian + sh_fmt, self.data,
+                                                                shoff + i * shentsize)
+            self.sections.append({'name': name, 'type': sh_type, 'flags': flags, 'addr': addr,
+                                  'offset': offset, 'size': size, 'link': link,
+                                  'entsize': entsize})
+
+        strtab = self.sections[shstrndx]
+        for section in self.sections:
+            section['name'] = self._str_at(strtab['offset'] + section['name'])
+
+        self.symbols = self._symbols_read()
+
+    def _str_at(self, offset):
+        end = self.data.index(b'\0', offset)
+        return self.data[offset:end].decode('latin-1')
+
+    def _symbols_read(self):
+        symbols = {}
+        for section in self.sections:
+            if section['type'] != self.SHT_SYMTAB:
+                continue
+            strtab = self.sections[section['link']]
+            count = section['size'] // section['entsize']
+            for i in range(count):
+                offset = section['offset'] + i * section['entsize']
+                if self.is_64:
+                    name, _info, _other, _shndx, value, _size = \
+                        struct.unpack_from(self.endian + 'IBBHQQ', self.data, offset)
+                else:
+                    name, value, _size, _info, _other, _shndx = \
+                        struct.unpack_from(self.endian + 'IIIBBH', self.data, offset)
+                if name:
+                    symbols[self._str_at(strtab['offset'] + name)] = value
+        return symbols
+
+    def read(self, addr, length):
+        """Returns bytes stored at the given address or None if not in the image."""
+        for section in self.sections:
+            if not (section['flags'] & self.SHF_ALLOC) or section['type'] == self.SHT_NOBITS:
+                continue
+            if section['addr'] <= addr and addr + length <= section['addr'] + section['size']:
+                offset = section['offset'] + addr - section['addr']
+                return self.data[offset:offset + length]
+        return None
+
+    def string(self, addr, max_len=256):
+        """Returns NUL-terminated string stored at the given address or None."""
+        for section in self.sections:
+            if not (section['flags'] & self.SHF_ALLOC) or section['type'] == self.SHT_NOBITS:
+                continue
+            if section['addr'] <= addr < section['addr'] + section['size']:
+                start = section['offset'] + addr - section['addr']
+                stop = min(start + max_len, section['offset'] + section['size'])
+                end = self.data.find(b'\0', start, stop)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode('latin-1')
+        return None
+
+    def pointer(self, addr):
+        raw = self.read(addr, self.ptr_size)
+        if raw is None:
+            return None
+        return struct.unpack(self.endian + ('Q' if self.is_64 else 'I'), raw)[0]
+
+
+def module_names_get(elf):
+    """Returns names of logger modules ordered by module ID."""
+    try:
+        start = elf.symbols['__start_log_const_data']
+        stop = elf.symbols['__stop_log_const_data']
+    except KeyError:
+        raise ValueError('Logger module section not found in the ELF file.')
+
+    # Size of nrf_log_module_const_data_t depends on the compiler options (for example,
+    # -fshort-enums). Pick the smallest stride for which every entry points to a valid name.
+    for stride in range(elf.ptr_size, 4 * elf.ptr_size + 1, 4):
+        if (stop - start) % stride:
+            continue
+        names = []
+        for addr in range(start, stop, stride):
+            p_name = elf.pointer(addr)
+            name = elf.string(p_name) if p_name is not None else None
+            if not name or not all(32 < ord(c) < 127 for c in name):
+                break
+            names.append(name)
+        else:
+            return names
+
+    raise ValueError('Could not decode logger module section.')
+
+
+FORMAT_SPEC = re.compile(r'%([-+0]*)(\d+|\*)?(?:\.(\d*))?([hl]*)([diuxXcsp%])')
+
+
+def string_count(fmt):
+    """Returns the number of %s conversions in a format string."""
+    return sum(1 for match in FORMAT_SPEC.finditer(fmt) if match.group(5) == 's')
+
+
+def format_string(elf, fmt, args, strings=()):
+    """Formats a string with 32-bit arguments the same way as nrf_fprintf does.
+
+    Strings for %s are taken from strings (received in data frames) and, if missing, from the
+    ELF file. Note that nrf_fprintf prints hexadecimal numbers in upper case for both %x and %X.
+    """
+    args = list(args)
+    strings = list(strings)
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    def convert(match):
+        flags, width, precision, _length, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width = str(next_arg())
+
+        value = next_arg()
+        spec = '%' + flags + (width or '') + ('.' + precision if precision else '')
+
+        if conv in 'di':
+            if value & 0x80000000:
+                value -= 1 << 32
+            return (spec + 'd') % value
+        if conv == 'u':
+            return (spec + 'd') % value
+        if conv in 'xX':
+            return (spec + 'X') % value
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 'p':
+            return '0x%08X' % value
+        if conv == 's':
+            string = strings.pop(0) if strings else elf.string(value)
+            if string is None:
+                # String is not in the image (e.g. in RAM, see NRF_LOG_PUSH).
+                string = '<0x%08x>' % value
+            return (spec + 's') % string
+        return ''
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+class Decoder(object):
+    """Decodes binary frames into text lines."""
+
+    def __init__(self, elf, freq):
+        self.elf = elf
+        self.freq = freq
+        self.modules = module_names_get(elf)
+        self.buffer = bytearray()
+        self.errors = 0
+        self.pending = None
+
+    def timestamp_get(self, timestamp):
+        if timestamp is None:
+            return ''
+        if not self.freq:
+            return '[%08u] ' % timestamp
+        seconds = timestamp // self.freq
+        reminder = timestamp % self.freq
+        ms = (reminder * 1000) // self.freq
+        us = (1000 * (1000 * reminder - ms * self.freq)) // self.freq
+        return '[%02d:%02d:%02d.%03d,%03d] ' % (seconds // 3600, (seconds // 60) % 60,
+                                                 seconds % 60, ms, us)
+
+    def prefix_get(self, severity, module_id, timestamp, dropped):
+        prefix = ''
+        if dropped:
+            prefix += '\x1b[1;31mLogs dropped (%d)\x1b[0m\r\n' % dropped
+        if severity != SEVERITY_INFO_RAW:
+            name = self.modules[module_id] if module_id < len(self.modules) else \
+                   '<module %d>' % module_id
+            prefix += '%s<%s> %s: ' % (self.timestamp_get(timestamp),
+                                        SEVERITY_NAMES[severity], name)
+        return prefix
+
+    def entry_parse(self, entry):
+        """Returns a parsed entry or None if the entry is malformed.
+
+        The entry is complete when its 'missing' count drops to zero. Until then it expects data
+        frames with strings (standard entry) or with the rest of the data (hexdump entry).
+        """
+        base, module_word = struct.unpack_from('<II', entry, 0)
+        entry_type = base & 0x3
+        severity = (base >> 3) & 0x7
+        module_id = module_word & 0xFFFF
+        dropped = module_word >> 16
+
+        if severity == 0 or severity > SEVERITY_INFO_RAW:
+            return None
+
+        if entry_type == HEADER_TYPE_STD:
+            nargs = (base >> 6) & 0xF
+            header_words = len(entry) // 4 - nargs
+            if len(entry) % 4 or header_words not in (2, 3):
+                return None
+            timestamp = struct.unpack_from('<I', entry, 8)[0] if header_words == 3 else None
+            args = struct.unpack_from('<%dI' % nargs, entry, header_words * 4)
+            fmt = self.elf.string((base >> 10) & STD_ADDR_MASK, max_len=1024)
+            if fmt is None:
+                return None
+            return {'type': entry_type, 'severity': severity, 'module_id': module_id,
+                    'timestamp': timestamp, 'dropped': dropped, 'fmt': fmt, 'args': args,
+                    'strings': [], 'missing': string_count(fmt)}
+
+        if entry_type == HEADER_TYPE_HEXDUMP:
+            length = (base >> 22) & 0x3FF
+            header_bytes = len(entry) - min(length, HEXDUMP_SPLIT_LEN)
+            if header_bytes not in (8, 12):
+                return None
+            timestamp = struct.unpack_from('<I', entry, 8)[0] if header_bytes == 12 else None
+            data = bytearray(entry[header_bytes:])
+            return {'type': entry_type, 'severity': severity, 'module_id': module_id,
+                    'timestamp': timestamp, 'dropped': dropped, 'data': data,
+                    'missing': length - len(data)}
+
+        return None
+
+    def data_add(self, data):
+        """Adds the content of a data frame to the pending entry. Returns False if unexpected."""
+        pending = self.pending
+        if pending is None or pending['missing'] <= 0:
+            return False
+        if pending['type'] == HEADER_TYPE_STD:
+            pending['strings'].append(data.decode('latin-1'))
+            pending['missing'] -= 1
+        else:
+            if len(data) > pending['missing']:
+                return False
+            pending['data'] += data
+            pending['missing'] -= len(data)
+        return True
+
+    def entry_render(self, entry):
+        """Returns text of a parsed entry."""
+        severity = entry['severity']
+        module_id = entry['module_id']
+        timestamp = entry['timestamp']
+        dropped = entry['dropped']
+
+        if entry['type'] == HEADER_TYPE_STD:
+            text = self.prefix_get(severity, module_id, timestamp, dropped)
+            text += format_string(self.elf, entry['fmt'], entry['args'], entry['strings'])
+            if severity != SEVERITY_INFO_RAW:
+                text += '\r\n'
+            return text
+        else:
+            data = entry['data']
+            text = ''
+            offset = 0
+            while True:
+                chunk = data[offset:offset + HEXDUMP_BYTES_IN_LINE]
+                text += self.prefix_get(severity, module_id, timestamp, dropped)
+                text += ''.join(' %02X' % b for b in chunk)
+                text += '   ' * (HEXDUMP_BYTES_IN_LINE - len(chunk)) + '|'
+                text += ''.join(chr(b) if 32 <= b < 0x7F else '.' for b in chunk)
+                text += ' ' * (HEXDUMP_BYTES_IN_LINE - len(chunk)) + '\r\n'
+                offset += HEXDUMP_BYTES_IN_LINE
+                if offset >= len(data):
+                    break
+            return text
+
+    def pending_flush(self):
+        """Returns text of the pending entry, rendered with the data received so far."""
+        if self.pending is None:
+            return ''
+        if self.pending['missing'] > 0:
+            self.errors += 1
+        text = self.entry_render(self.pending)
+        self.pending = None
+        return text
+
+    def feed(self, data):
+        """Consumes received bytes and returns decoded text."""
+        self.buffer += data
+        out = []
+        while len(self.buffer) >= 2:
+            if self.buffer[0] not in (SYNC, SYNC_DATA):
+                # Out of sync. Drop bytes until the next sync byte.
+                self.errors += 1
+                idx = min(i for i in (self.buffer.find(bytes([SYNC]), 1),
+                                      self.buffer.find(bytes([SYNC_DATA]), 1),
+                                      len(self.buffer)) if i > 0)
+                del self.buffer[:idx]
+                continue
+            length = self.buffer[1]
+            if len(self.buffer) < 2 + length:
+                break
+            frame = bytes(self.buffer[2:2 + length])
+            if self.buffer[0] == SYNC_DATA:
+                if not self.data_add(frame):
+                    self.errors += 1
+                    del self.buffer[:1]
+                    continue
+            else:
+                entry = self.entry_parse(frame) if length >= 8 else None
+                if entry is None:
+                    self.errors += 1
+                    del self.buffer[:1]
+                    continue
+                # Entry that is still waiting for data frames is rendered as it is.
+                out.append(self.pending_flush())
+                self.pending = entry
+            del self.buffer[:2 + length]
+            if self.pending['missing'] == 0:
+                out.append(self.pending_flush())
+        return ''.join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode binary nrf_log output.')
+    parser.add_argument('elf', help='ELF file of the application.')
+    parser.add_argument('input', nargs='?', default='-',
+                        help='File with the binary log stream (default: stdin).')
+    parser.add_argument('--port', help='Read the stream from a serial port (requires pyserial).')
+    parser.add_argument('--baudrate', type=int, default=115200, help='Serial port baud rate.')
+    parser.add_argument('--freq', type=int, default=0,
+                        help='Timestamp frequency in Hz. If not set, raw timestamps are printed.')
+    args = parser.parse_args()
+
+    decoder = Decoder(ElfFile(args.elf), args.freq)
+
+    if args.port:
+        import serial
+        stream = serial.Serial(args.port, args.baudrate, timeout=0.1)
+        read = lambda: stream.read(256)
+        eof = lambda data: False
+    else:
+        stream = sys.stdin.buffer if args.input == '-' else open(args.input, 'rb')
+        read = lambda: stream.read(4096)
+        eof = lambda data: not data
+
+    try:
+        while True:
+            data = read()
+            if eof(data):
+                break
+            sys.stdout.write(decoder.feed(data).replace('\r\n', '\n'))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    sys.stdout.write(decoder.pending_flush().replace('\r\n', '\n'))
+
+    if decoder.errors:
+        sys.stderr.write('%d malformed frame(s) skipped.\n' % decoder.errors)
+
+
+if __name__ == '__main__':
+    main()
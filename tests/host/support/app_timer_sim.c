@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <stdlib.h>
+#include "app_timer_sim.h"
+#include "drv_rtc.h"
+#include "nrf_atfifo.h"
+#include "app_error.h"
+
+#define SIM_CC_CHANNELS 2
+
+static uint32_t          m_counter;
+static uint32_t          m_cc[SIM_CC_CHANNELS];
+static bool              m_cc_enabled[SIM_CC_CHANNELS];
+static bool              m_cc_pending[SIM_CC_CHANNELS];
+static bool              m_overflow_pending;
+static drv_rtc_handler_t m_handler;
+static bool              m_in_irq;
+static bool              m_irq_retrigger;
+static uint32_t          m_compare_wakeups;
+
+static void sim_irq(void)
+{
+    if (m_in_irq)
+    {
+        m_irq_retrigger = true;
+        return;
+    }
+
+    m_in_irq = true;
+    do
+    {
+        m_irq_retrigger = false;
+        m_handler(NULL);
+    } while (m_irq_retrigger);
+    m_in_irq = false;
+}
+
+void app_timer_sim_tick(void)
+{
+    bool fire = false;
+
+    m_counter = (m_counter + 1) & DRV_RTC_MAX_CNT;
+    if (m_counter == 0)
+    {
+        m_overflow_pending = true;
+        fire               = true;
+    }
+
+    for (uint32_t i = 0; i < SIM_CC_CHANNELS; i++)
+    {
+        if (m_cc_enabled[i] && (m_cc[i] == m_counter))
+        {
+            // Channel 0 is the timer compare, which the driver expects to be one-shot.
+            if (i == 0)
+            {
+                m_cc_enabled[0] = false;
+                m_compare_wakeups++;
+            }
+            m_cc_pending[i] = true;
+            fire            = true;
+        }
+    }
+
+    if (fire)
+    {
+        sim_irq();
+    }
+}
+
+uint32_t app_timer_sim_compare_wakeups_get(void)
+{
+    return m_compare_wakeups;
+}
+
+ret_code_t drv_rtc_init(drv_rtc_t const * const  p_instance,
+                        drv_rtc_config_t const * p_config,
+                        drv_rtc_handler_t        handler)
+{
+    m_handler = handler;
+    return NRF_SUCCESS;
+}
+
+void drv_rtc_start(drv_rtc_t const * const p_instance)
+{
+}
+
+void drv_rtc_stop(drv_rtc_t const * const p_instance)
+{
+}
+
+void drv_rtc_compare_set(drv_rtc_t const * const p_instance,
+                         uint32_t                cc,
+                         uint32_t                abs_value,
+                         bool                    irq_enable)
+{
+    m_cc[cc]         = abs_value & DRV_RTC_MAX_CNT;
+    m_cc_enabled[cc] = true;
+}
+
+ret_code_t drv_rtc_windowed_compare_set(drv_rtc_t const * const p_instance,
+                                        uint32_t                cc,
+                                        uint32_t                abs_value,
+                                        uint32_t                safe_window)
+{
+    uint32_t diff = (abs_value - m_counter) & DRV_RTC_MAX_CNT;
+
+    if ((diff == 0) || (diff > (DRV_RTC_MAX_CNT - safe_window)))
+    {
+        m_cc_enabled[cc] = false;
+        return NRF_ERROR_TIMEOUT;
+    }
+
+    m_cc[cc]         = abs_value & DRV_RTC_MAX_CNT;
+    m_cc_enabled[cc] = true;
+    return NRF_SUCCESS;
+}
+
+void drv_rtc_overflow_enable(drv_rtc_t const * const p_instance, bool irq_enable)
+{
+}
+
+bool drv_rtc_overflow_pending(drv_rtc_t const * const p_instance)
+{
+    bool pending = m_overflow_pending;
+    m_overflow_pending = false;
+    return pending;
+}
+
+void drv_rtc_compare_disable(drv_rtc_t const * const p_instance, uint32_t cc)
+{
+    m_cc_enabled[cc] = false;
+}
+
+bool drv_rtc_compare_pending(drv_rtc_t const * const p_instance, uint32_t cc)
+{
+    bool pending = m_cc_pending[cc];
+    m_cc_pending[cc] = false;
+    return pending;
+}
+
+uint32_t drv_rtc_compare_get(drv_rtc_t const * const p_instance, uint32_t cc)
+{
+    return m_cc[cc];
+}
+
+uint32_t drv_rtc_counter_get(drv_rtc_t const * const p_instance)
+{
+    return m_counter;
+}
+
+void drv_rtc_irq_trigger(drv_rtc_t const * const p_instance)
+{
+    sim_irq();
+}
+
+static uint16_t sim_fifo_capacity(nrf_atfifo_t const * const p_fifo)
+{
+    return p_fifo->buf_size / p_fifo->item_size;
+}
+
+ret_code_t nrf_atfifo_init(nrf_atfifo_t * const p_fifo, void * p_buf, uint16_t buf_size, uint16_t item_size)
+{
+    p_fifo->p_buf     = p_buf;
+    p_fifo->buf_size  = buf_size;
+    p_fifo->item_size = item_size;
+    p_fifo->tail.tag  = 0;
+    p_fifo->head.tag  = 0;
+    return NRF_SUCCESS;
+}
+
+void * nrf_atfifo_item_alloc(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_put_t * p_context)
+{
+    uint16_t capacity = sim_fifo_capacity(p_fifo);
+
+    if ((uint16_t)(p_fifo->tail.pos.wr - p_fifo->head.pos.wr) >= capacity)
+    {
+        return NULL;
+    }
+
+    void * p_item = (uint8_t *)p_fifo->p_buf + (p_fifo->tail.pos.wr % capacity) * p_fifo->item_size;
+    p_fifo->tail.pos.wr++;
+    return p_item;
+}
+
+bool nrf_atfifo_item_put(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_put_t * p_context)
+{
+    return true;
+}
+
+void * nrf_atfifo_item_get(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_get_t * p_context)
+{
+    uint16_t capacity = sim_fifo_capacity(p_fifo);
+
+    if (p_fifo->head.pos.rd == p_fifo->tail.pos.wr)
+    {
+        return NULL;
+    }
+
+    void * p_item = (uint8_t *)p_fifo->p_buf + (p_fifo->head.pos.rd % capacity) * p_fifo->item_size;
+    p_fifo->head.pos.rd++;
+    return p_item;
+}
+
+bool nrf_atfifo_item_free(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_get_t * p_context)
+{
+    p_fifo->head.pos.wr++;
+    return true;
+}
@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief Host replacement of the CMSIS GCC intrinsics.
+ *
+ * The device header includes "core_cm4.h", which is found here first. The CMSIS intrinsics of
+ * cmsis_gcc.h are ARM assembly, so they are defined here for the host, and the real core_cm4.h is
+ * included after them. Barriers are full memory fences. There are no interrupts on the host, so
+ * the code always runs in thread mode with interrupts enabled.
+ */
+#ifndef HOST_CORE_CM4_H__
+#define HOST_CORE_CM4_H__
+
+#include <stdint.h>
+
+// Skip cmsis_gcc.h when it is included by cmsis_compiler.h.
+#define __CMSIS_GCC_H
+
+#ifndef __ASM
+  #define __ASM                   __asm
+#endif
+#ifndef __INLINE
+  #define __INLINE                inline
+#endif
+#ifndef __STATIC_INLINE
+  #define __STATIC_INLINE         static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+  #define __STATIC_FORCEINLINE    __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+  #define __NO_RETURN             __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+  #define __USED                  __attribute__((used))
+#endif
+#ifndef __WEAK
+  #define __WEAK                  __attribute__((weak))
+#endif
+#ifndef __PACKED
+  #define __PACKED                __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_STRUCT
+  #define __PACKED_STRUCT         struct __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_UNION
+  #define __PACKED_UNION          union __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+  #define __ALIGNED(x)            __attribute__((aligned(x)))
+#endif
+#ifndef __RESTRICT
+  #define __RESTRICT              __restrict
+#endif
+#ifndef __COMPILER_BARRIER
+  #define __COMPILER_BARRIER()    __ASM volatile("" ::: "memory")
+#endif
+
+__PACKED_STRUCT T_UINT16_READ  { uint16_t v; };
+__PACKED_STRUCT T_UINT16_WRITE { uint16_t v; };
+__PACKED_STRUCT T_UINT32_READ  { uint32_t v; };
+__PACKED_STRUCT T_UINT32_WRITE { uint32_t v; };
+
+#define __UNALIGNED_UINT16_READ(addr)       (((const struct T_UINT16_READ *)(const void *)(addr))->v)
+#define __UNALIGNED_UINT16_WRITE(addr, val) (void)((((struct T_UINT16_WRITE *)(void *)(addr))->v) = (val))
+#define __UNALIGNED_UINT32_READ(addr)       (((const struct T_UINT32_READ *)(const void *)(addr))->v)
+#define __UNALIGNED_UINT32_WRITE(addr, val) (void)((((struct T_UINT32_WRITE *)(void *)(addr))->v) = (val))
+
+#define __NOP()
+#define __WFI()
+#define __WFE()
+#define __SEV()
+#define __BKPT(value)
+
+__STATIC_FORCEINLINE void __DMB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __DSB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __ISB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value)
+{
+    return __builtin_bswap32(value);
+}
+
+__STATIC_FORCEINLINE uint32_t __REV16(uint32_t value)
+{
+    return ((value & 0x00FF00FFUL) << 8) | ((value >> 8) & 0x00FF00FFUL);
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0;
+
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        result = (result << 1) | ((value >> i) & 1UL);
+    }
+    return result;
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0) ? 32 : (uint8_t)__builtin_clz(value);
+}
+
+__STATIC_FORCEINLINE uint32_t __USAT(int32_t value, uint32_t sat)
+{
+    uint32_t max = (1UL << sat) - 1UL;
+
+    if (value < 0)
+    {
+        return 0;
+    }
+    return ((uint32_t)value > max) ? max : (uint32_t)value;
+}
+
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t value, uint32_t sat)
+{
+    int32_t max = (int32_t)((1UL << (sat - 1UL)) - 1UL);
+    int32_t min = -1 - max;
+
+    if (value > max)
+    {
+        return max;
+    }
+    return (value < min) ? min : value;
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+}
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void)
+{
+    return 0;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)
+{
+    return 0;
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask)
+{
+}
+
+__STATIC_FORCEINLINE uint32_t __get_BASEPRI(void)
+{
+    return 0;
+}
+
+__STATIC_FORCEINLINE void __set_BASEPRI(uint32_t basePri)
+{
+}
+
+__STATIC_FORCEINLINE uint32_t __get_CONTROL(void)
+{
+    return 0;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_FPSCR(void)
+{
+    return 0;
+}
+
+__STATIC_FORCEINLINE void __set_FPSCR(uint32_t fpscr)
+{
+}
+
+#include_next <core_cm4.h>
+
+#endif // HOST_CORE_CM4_H__
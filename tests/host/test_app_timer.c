@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief Test and benchmark of the app_timer2 queue backends.
+ *
+ * The test is built once for every value of APP_TIMER_CONFIG_QUEUE_BACKEND, on a simulated RTC.
+ * Timers are started and stopped at random, also from timeout handlers, and every expiry is
+ * compared with a reference model that knows the tick at which each timer is due. The benchmark
+ * measures a start and a stop while a given number of timers are active.
+ */
+#include <stdlib.h>
+#include "app_timer.h"
+#include "app_timer_sim.h"
+#include "host_test.h"
+
+#define TEST_TIMERS     64
+#define TEST_TICKS      400000
+#define BENCH_ROUNDS    20
+#define BENCH_TIMERS    1000
+
+typedef struct
+{
+    bool     active;
+    uint64_t due;
+    uint32_t period;
+} model_timer_t;
+
+static app_timer_t      m_timer_data[TEST_TIMERS];
+static app_timer_id_t   m_timer_ids[TEST_TIMERS];
+static model_timer_t    m_model[TEST_TIMERS];
+static uint64_t         m_now;
+static uint64_t         m_last_due;
+static uint32_t         m_expired;
+
+static void model_stop(uint32_t idx)
+{
+    m_model[idx].active = false;
+}
+
+static void timeout_handler(void * p_context)
+{
+    uint32_t idx = (uint32_t)(uintptr_t)p_context;
+
+    HOST_TEST_CHECK(m_model[idx].active);
+    HOST_TEST_CHECK(m_model[idx].due == m_now);
+    // Timers due at the same tick expire in the order they were queued, but never before
+    // a timer that is due earlier.
+    HOST_TEST_CHECK(m_model[idx].due >= m_last_due);
+    m_last_due = m_model[idx].due;
+    m_expired++;
+
+    if (m_model[idx].period != 0)
+    {
+        m_model[idx].due += m_model[idx].period;
+    }
+    else
+    {
+        model_stop(idx);
+    }
+
+    if (((idx % 7) == 0) && ((rand() % 3) == 0))
+    {
+        uint32_t other = (idx + 1) % TEST_TIMERS;
+        HOST_TEST_CHECK(app_timer_stop(m_timer_ids[other]) == NRF_SUCCESS);
+        model_stop(other);
+    }
+}
+
+static void timer_start(uint32_t idx, uint32_t timeout)
+{
+    HOST_TEST_CHECK(app_timer_start(m_timer_ids[idx], timeout, (void *)(uintptr_t)idx)
+                    == NRF_SUCCESS);
+
+    // Starting an active timer has no effect.
+    if (!m_model[idx].active)
+    {
+        m_model[idx].active = true;
+        m_model[idx].due    = m_now + timeout;
+        if ((idx % 4) == 0)
+        {
+            m_model[idx].period = timeout;
+        }
+    }
+}
+
+static void bench_handler(void * p_context)
+{
+}
+
+static void benchmark(void)
+{
+    static app_timer_t bench_timers[BENCH_TIMERS];
+
+    for (uint32_t n = 10; n <= BENCH_TIMERS; n *= 10)
+    {
+        uint64_t start = host_test_time_ns();
+
+        for (uint32_t round = 0; round < BENCH_ROUNDS; round++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                app_timer_id_t id = &bench_timers[i];
+                (void)app_timer_create(&id, APP_TIMER_MODE_SINGLE_SHOT, bench_handler);
+                (void)app_timer_start(id, 1000 + (rand() % 100000), NULL);
+            }
+            for (uint32_t i = 0; i < n; i++)
+            {
+                (void)app_timer_stop(&bench_timers[i]);
+            }
+        }
+
+        printf("%4u active timers: %.3f us per start and stop\n", n,
+               (double)(host_test_time_ns() - start) / 1000.0 / (BENCH_ROUNDS * n));
+    }
+}
+
+int main(void)
+{
+    HOST_TEST_CHECK(app_timer_init() == NRF_SUCCESS);
+    srand(3);
+
+    for (uint32_t i = 0; i < TEST_TIMERS; i++)
+    {
+        m_timer_ids[i] = &m_timer_data[i];
+        HOST_TEST_CHECK(app_timer_create(&m_timer_ids[i],
+                                         ((i % 4) == 0) ? APP_TIMER_MODE_REPEATED :
+                                                          APP_TIMER_MODE_SINGLE_SHOT,
+                                         timeout_handler) == NRF_SUCCESS);
+    }
+
+    for (uint32_t step = 0; step < TEST_TICKS; step++)
+    {
+        uint32_t r = rand() % 100;
+
+        if (r < 3)
+        {
+            // Mostly short timeouts, and some that span many others.
+            timer_start(rand() % TEST_TIMERS, 5 + (rand() % ((r == 0) ? 30000 : 500)));
+        }
+        else if (r < 4)
+        {
+            uint32_t idx = rand() % TEST_TIMERS;
+            HOST_TEST_CHECK(app_timer_stop(m_timer_ids[idx]) == NRF_SUCCESS);
+            model_stop(idx);
+        }
+
+        m_now++;
+        app_timer_sim_tick();
+    }
+
+    // Every timer that was due must have expired.
+    for (uint32_t i = 0; i < TEST_TIMERS; i++)
+    {
+        HOST_TEST_CHECK(!m_model[i].active || (m_model[i].due > m_now));
+    }
+    printf("%u expirations\n", m_expired);
+    HOST_TEST_CHECK(m_expired > 1000);
+
+    HOST_TEST_CHECK(app_timer_stop_all() == NRF_SUCCESS);
+    benchmark();
+
+    return host_test_result("app_timer");
+}
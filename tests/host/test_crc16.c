@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief Equivalence test and benchmark of the CRC16 engines.
+ *
+ * The test is built once for every value of CRC16_CONFIG_MODE. Each engine is compared with the
+ * original shift-based CRC-16-CCITT for all buffer alignments. crc16_compute_words() and the
+ * streaming context API are compared with crc16_compute().
+ */
+#include <stdlib.h>
+#include "crc16.h"
+#include "host_test.h"
+
+#define BENCH_SIZE   4096
+#define BENCH_ROUNDS 2000
+
+static uint16_t crc16_reference(uint8_t const * p_data, uint32_t size, uint16_t crc)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc  = (uint8_t)(crc >> 8) | (crc << 8);
+        crc ^= p_data[i];
+        crc ^= (uint8_t)(crc & 0xFF) >> 4;
+        crc ^= (crc << 8) << 4;
+        crc ^= ((crc & 0xFF) << 4) << 1;
+    }
+    return crc;
+}
+
+int main(void)
+{
+    static uint32_t words[(BENCH_SIZE / sizeof(uint32_t)) + 2];
+    uint8_t * const buf = (uint8_t *)words;
+
+    srand(2);
+    for (uint32_t i = 0; i < sizeof(words); i++)
+    {
+        buf[i] = (uint8_t)rand();
+    }
+
+    HOST_TEST_CHECK(crc16_compute((uint8_t const *)"123456789", 9, NULL) == 0x29B1);
+
+    for (uint32_t offset = 0; offset < 8; offset++)
+    {
+        for (uint32_t size = 0; size < 300; size++)
+        {
+            uint8_t const * p_data   = &buf[offset];
+            uint16_t const  expected = crc16_reference(p_data, size, 0xFFFF);
+            uint32_t const  split    = size / 3;
+
+            HOST_TEST_CHECK(crc16_compute(p_data, size, NULL) == expected);
+
+            uint16_t crc = crc16_compute(p_data, split, NULL);
+            crc = crc16_compute(&p_data[split], size - split, &crc);
+            HOST_TEST_CHECK(crc == expected);
+
+            crc16_ctx_t ctx;
+            crc16_init(&ctx);
+            crc16_update(&ctx, p_data, split);
+            crc16_update(&ctx, &p_data[split], size - split);
+            HOST_TEST_CHECK(crc16_final(&ctx) == expected);
+        }
+    }
+
+    for (uint32_t len_words = 0; len_words < 100; len_words++)
+    {
+        uint16_t const seed = (uint16_t)rand();
+
+        HOST_TEST_CHECK(crc16_compute_words(&words[1], len_words, &seed) ==
+                        crc16_reference(&buf[4], len_words * sizeof(uint32_t), seed));
+    }
+
+    volatile uint32_t sink  = 0;
+    uint64_t          start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCH_ROUNDS; i++)
+    {
+        sink += crc16_compute(buf, BENCH_SIZE, NULL);
+    }
+    uint64_t const bytes_ns = host_test_time_ns() - start;
+
+    start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCH_ROUNDS; i++)
+    {
+        sink += crc16_compute_words(words, BENCH_SIZE / sizeof(uint32_t), NULL);
+    }
+    uint64_t const words_ns = host_test_time_ns() - start;
+
+    printf("crc16 mode %d: crc16_compute %.1f MB/s, crc16_compute_words %.1f MB/s\n",
+           CRC16_CONFIG_MODE,
+           (double)BENCH_SIZE * BENCH_ROUNDS * 1000.0 / (double)bytes_ns,
+           (double)BENCH_SIZE * BENCH_ROUNDS * 1000.0 / (double)words_ns);
+
+    return host_test_result("crc16");
+}
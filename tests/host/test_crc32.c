@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief Equivalence test and benchmark of the CRC32 engines.
+ *
+ * The test is built once for every value of CRC32_CONFIG_MODE. Each engine is compared with a
+ * bitwise reference for all buffer alignments, and the streaming context API is compared with
+ * chained calls to crc32_compute().
+ */
+#include <stdlib.h>
+#include "crc32.h"
+#include "host_test.h"
+
+#define BENCH_SIZE   4096
+#define BENCH_ROUNDS 2000
+
+static uint32_t crc32_reference(uint8_t const * p_data, uint32_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        crc ^= p_data[i];
+        for (uint32_t j = 0; j < 8; j++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+int main(void)
+{
+    static uint8_t buf[BENCH_SIZE + 8];
+
+    srand(1);
+    for (uint32_t i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = (uint8_t)rand();
+    }
+
+    HOST_TEST_CHECK(crc32_compute((uint8_t const *)"123456789", 9, NULL) == 0xCBF43926);
+
+    for (uint32_t offset = 0; offset < 8; offset++)
+    {
+        for (uint32_t size = 0; size < 300; size++)
+        {
+            uint8_t const * p_data   = &buf[offset];
+            uint32_t const  expected = crc32_reference(p_data, size);
+            uint32_t const  split    = size / 3;
+
+            HOST_TEST_CHECK(crc32_compute(p_data, size, NULL) == expected);
+
+            uint32_t crc = crc32_compute(p_data, split, NULL);
+            crc = crc32_compute(&p_data[split], size - split, &crc);
+            HOST_TEST_CHECK(crc == expected);
+
+            crc32_ctx_t ctx;
+            crc32_init(&ctx);
+            crc32_update(&ctx, p_data, split);
+            crc32_update(&ctx, &p_data[split], size - split);
+            HOST_TEST_CHECK(crc32_final(&ctx) == expected);
+        }
+    }
+
+    volatile uint32_t sink  = 0;
+    uint64_t const    start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCH_ROUNDS; i++)
+    {
+        sink += crc32_compute(buf, BENCH_SIZE, NULL);
+    }
+    uint64_t const elapsed = host_test_time_ns() - start;
+
+    printf("crc32 mode %d: %.1f MB/s\n",
+           CRC32_CONFIG_MODE,
+           (double)BENCH_SIZE * BENCH_ROUNDS * 1000.0 / (double)elapsed);
+
+    return host_test_result("crc32");
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief Test and benchmark of the block search in mem_manager.
+ *
+ * The pool is filled with blocks of every category and the blocks are checked for overlap. Then
+ * random allocations and frees keep about 90% of the pool in use and the average time of an
+ * operation is printed. The test is built with and without
+ * @ref MEM_MANAGER_CONSTANT_TIME_ENABLED.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "mem_manager.h"
+#include "host_test.h"
+
+#define BLOCK_COUNT     (MEMORY_MANAGER_SMALL_BLOCK_COUNT +  \
+                         MEMORY_MANAGER_MEDIUM_BLOCK_COUNT + \
+                         MEMORY_MANAGER_LARGE_BLOCK_COUNT)
+#define OPERATION_COUNT 2000000UL
+
+static void *   m_blocks[BLOCK_COUNT];
+static uint32_t m_sizes[BLOCK_COUNT];
+
+/**@brief Function for filling the whole pool and checking that blocks do not overlap. */
+static void pool_fill_check(void)
+{
+    static const uint32_t sizes[] =
+    {
+        MEMORY_MANAGER_SMALL_BLOCK_SIZE,
+        MEMORY_MANAGER_MEDIUM_BLOCK_SIZE,
+        MEMORY_MANAGER_LARGE_BLOCK_SIZE,
+    };
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        void * p_block;
+
+        while ((count < BLOCK_COUNT) && ((p_block = nrf_malloc(sizes[i])) != NULL))
+        {
+            memset(p_block, (uint8_t)count, sizes[i]);
+            m_blocks[count] = p_block;
+            m_sizes[count]  = sizes[i];
+            count++;
+        }
+    }
+    HOST_TEST_CHECK(count == BLOCK_COUNT);
+    HOST_TEST_CHECK(nrf_malloc(1) == NULL);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint8_t const * p_block = m_blocks[i];
+
+        for (uint32_t j = 0; j < m_sizes[i]; j++)
+        {
+            if (p_block[j] != (uint8_t)i)
+            {
+                HOST_TEST_CHECK(p_block[j] == (uint8_t)i);
+                break;
+            }
+        }
+    }
+
+    // Freeing a block twice has no effect.
+    for (uint32_t i = 0; i < count; i++)
+    {
+        nrf_free(m_blocks[i]);
+        nrf_free(m_blocks[i]);
+    }
+
+    count = 0;
+    while (nrf_malloc(1) != NULL)
+    {
+        count++;
+    }
+    HOST_TEST_CHECK(count == BLOCK_COUNT);
+    HOST_TEST_CHECK(nrf_mem_init() == NRF_SUCCESS);
+}
+
+/**@brief Function for measuring random allocations and frees with the pool about 90% full. */
+static void benchmark(void)
+{
+    uint32_t count = 0;
+    uint64_t start;
+
+    srand(1);
+    start = host_test_time_ns();
+    for (uint32_t i = 0; i < OPERATION_COUNT; i++)
+    {
+        if ((count > 0) && ((count > (BLOCK_COUNT * 9) / 10) || (rand() % 2)))
+        {
+            uint32_t idx = (uint32_t)rand() % count;
+
+            nrf_free(m_blocks[idx]);
+            m_blocks[idx] = m_blocks[--count];
+        }
+        else
+        {
+            void * p_block = nrf_malloc(1 + (uint32_t)rand() % MEMORY_MANAGER_LARGE_BLOCK_SIZE);
+
+            if (p_block != NULL)
+            {
+                m_blocks[count++] = p_block;
+            }
+        }
+    }
+
+    printf("%u blocks: %.1f ns per malloc or free\n", (unsigned int)BLOCK_COUNT,
+           (double)(host_test_time_ns() - start) / OPERATION_COUNT);
+}
+
+int main(void)
+{
+    HOST_TEST_CHECK(nrf_mem_init() == NRF_SUCCESS);
+
+    pool_fill_check();
+    benchmark();
+
+    return host_test_result(MEM_MANAGER_CONSTANT_TIME_ENABLED ? "mem_manager_constant_time" :
+                                                                "mem_manager_linear");
+}
@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief Replay benchmark of advertising report filtering in nrf_ble_scan.
+ *
+ * Recorded-style advertising reports are passed to the scanning module with name, short name,
+ * UUID and appearance filters set. The test checks which reports match the filters and measures
+ * the average time of processing one report. SoftDevice calls are replaced by stubs, so their
+ * cost is not included.
+ */
+#include <string.h>
+#include "nrf_ble_scan.h"
+#include "host_test.h"
+
+#define REPORT_LEN      31
+#define REPLAY_COUNT    3000000UL
+
+/** Reports with flags, service UUIDs, names, manufacturer data and service data. */
+static uint8_t m_reports[][REPORT_LEN] =
+{
+    {2, 1, 6, 3, 3, 0x0D, 0x18, 7, 9, 'T', 'h', 'i', 'n', 'g', 'y', 3, 0x19, 0x41, 0x00,
+     5, 0xFF, 0x59, 0x00, 1, 2},
+    {2, 1, 6, 26, 0xFF, 0x4C, 0x00, 0x02, 0x15, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+     15, 16, 0, 1, 0, 2, 0xC5},
+    {2, 1, 6, 17, 7, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB,
+     0xAA, 0xFE, 0xAE, 0xAF, 5, 8, 'N', 'o', 'r', 'd'},
+    {2, 1, 6, 3, 3, 0xAA, 0xFE, 17, 0x16, 0xAA, 0xFE, 0x10, 0x00, 0x03, 'n', 'o', 'r', 'd',
+     'i', 'c', 's', 'e', 'm', 'i', 0x00},
+    {2, 1, 0x1A, 10, 0xFF, 0x4C, 0x00, 0x10, 0x05, 0x1B, 0x1C, 0x3D, 0x1E, 0x2F, 7, 9, 'N', 'o',
+     'r', 'd', 'i', 'c'},
+    {2, 1, 6, 7, 3, 0x0F, 0x18, 0x0A, 0x18, 0x0D, 0x18, 11, 9, 'H', 'R', ' ', 's', 'e', 'n',
+     's', 'o', 'r'},
+};
+
+/** Expected result of filtering for each report. */
+static const bool m_report_match[] = {true, false, true, false, true, true};
+
+static uint32_t m_match_cnt;
+
+uint32_t sd_ble_uuid_encode(ble_uuid_t const * p_uuid, uint8_t * p_uuid_le_len, uint8_t * p_uuid_le)
+{
+    if (p_uuid->type == BLE_UUID_TYPE_BLE)
+    {
+        *p_uuid_le_len = 2;
+    }
+    else
+    {
+        // Single vendor-specific base: A0 A1 ... AF, with the 16-bit UUID in bytes 12 and 13.
+        *p_uuid_le_len = 16;
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            p_uuid_le[i] = 0xA0 + i;
+        }
+        p_uuid_le += 12;
+    }
+    p_uuid_le[0] = (uint8_t)p_uuid->uuid;
+    p_uuid_le[1] = (uint8_t)(p_uuid->uuid >> 8);
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_scan_start(ble_gap_scan_params_t const * p_scan_params,
+                               ble_data_t const *            p_adv_report_buffer)
+{
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_scan_stop(void)
+{
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_connect(ble_gap_addr_t const *        p_peer_addr,
+                            ble_gap_scan_params_t const * p_scan_params,
+                            ble_gap_conn_params_t const * p_conn_params,
+                            uint8_t                       conn_cfg_tag)
+{
+    return NRF_SUCCESS;
+}
+
+// Used only for encoding advertising data.
+uint32_t sd_ble_gap_addr_get(ble_gap_addr_t * p_addr)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+uint32_t sd_ble_gap_appearance_get(uint16_t * p_appearance)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+uint32_t sd_ble_gap_device_name_get(uint8_t * p_dev_name, uint16_t * p_len)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+static void scan_evt_handler(scan_evt_t const * p_scan_evt)
+{
+    if (p_scan_evt->scan_evt_id == NRF_BLE_SCAN_EVT_FILTER_MATCH)
+    {
+        m_match_cnt++;
+    }
+}
+
+static void filters_set(nrf_ble_scan_t * p_scan)
+{
+    static char const * const names[] = {"Nordic_HRM", "Thingy", "Nordic"};
+    static const ble_uuid_t   uuids[] =
+    {
+        {.uuid = 0x180D, .type = BLE_UUID_TYPE_BLE},
+        {.uuid = 0xFEAA, .type = BLE_UUID_TYPE_VENDOR_BEGIN},
+        {.uuid = 0x1234, .type = BLE_UUID_TYPE_VENDOR_BEGIN},
+        {.uuid = 0x181A, .type = BLE_UUID_TYPE_BLE},
+    };
+    static const uint16_t appearances[] = {0x03C1, 0x0341};
+    nrf_ble_scan_short_name_t short_name = {.p_short_name = "Nordic_HRM", .short_name_min_len = 3};
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(names); i++)
+    {
+        HOST_TEST_CHECK(nrf_ble_scan_filter_set(p_scan, SCAN_NAME_FILTER, names[i]) == NRF_SUCCESS);
+    }
+    for (uint32_t i = 0; i < ARRAY_SIZE(uuids); i++)
+    {
+        HOST_TEST_CHECK(nrf_ble_scan_filter_set(p_scan, SCAN_UUID_FILTER, &uuids[i]) == NRF_SUCCESS);
+    }
+    for (uint32_t i = 0; i < ARRAY_SIZE(appearances); i++)
+    {
+        HOST_TEST_CHECK(nrf_ble_scan_filter_set(p_scan, SCAN_APPEARANCE_FILTER, &appearances[i])
+                        == NRF_SUCCESS);
+    }
+    HOST_TEST_CHECK(nrf_ble_scan_filter_set(p_scan, SCAN_SHORT_NAME_FILTER, &short_name)
+                    == NRF_SUCCESS);
+    HOST_TEST_CHECK(nrf_ble_scan_filters_enable(p_scan,
+                                                NRF_BLE_SCAN_NAME_FILTER |
+                                                NRF_BLE_SCAN_UUID_FILTER |
+                                                NRF_BLE_SCAN_APPEARANCE_FILTER |
+                                                NRF_BLE_SCAN_SHORT_NAME_FILTER,
+                                                false) == NRF_SUCCESS);
+}
+
+static void report_replay(nrf_ble_scan_t * p_scan, ble_evt_t * p_ble_evt, uint32_t idx)
+{
+    p_ble_evt->evt.gap_evt.params.adv_report.data.p_data = m_reports[idx];
+    p_ble_evt->evt.gap_evt.params.adv_report.data.len    = REPORT_LEN;
+    nrf_ble_scan_on_ble_evt(p_ble_evt, p_scan);
+}
+
+int main(void)
+{
+    static nrf_ble_scan_t scan;
+    ble_evt_t             ble_evt;
+    uint32_t              expected = 0;
+    uint64_t              start;
+
+    HOST_TEST_CHECK(nrf_ble_scan_init(&scan, NULL, scan_evt_handler) == NRF_SUCCESS);
+    filters_set(&scan);
+
+    memset(&ble_evt, 0, sizeof(ble_evt));
+    ble_evt.header.evt_id = BLE_GAP_EVT_ADV_REPORT;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_reports); i++)
+    {
+        m_match_cnt = 0;
+        report_replay(&scan, &ble_evt, i);
+        if ((m_match_cnt != 0) != m_report_match[i])
+        {
+            printf("report %u: match %u\n", i, m_match_cnt);
+            HOST_TEST_CHECK((m_match_cnt != 0) == m_report_match[i]);
+        }
+        expected += m_report_match[i] ? 1 : 0;
+    }
+
+    m_match_cnt = 0;
+    start       = host_test_time_ns();
+    for (uint32_t i = 0; i < REPLAY_COUNT; i++)
+    {
+        report_replay(&scan, &ble_evt, i % ARRAY_SIZE(m_reports));
+    }
+    printf("%.1f ns per report\n", (double)(host_test_time_ns() - start) / REPLAY_COUNT);
+    HOST_TEST_CHECK(m_match_cnt == (REPLAY_COUNT / ARRAY_SIZE(m_reports)) * expected);
+
+    return host_test_result("nrf_ble_scan");
+}
@@ -0,0 +1,455 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief End-to-end timing of a DFU transfer on simulated flash.
+ *
+ * The DFU request handler receives an unsigned application update the way a transport delivers
+ * it: the init packet in a command object, then the firmware in data objects that are written in
+ * MTU-sized chunks, checked with CRC requests and executed. Flash is simulated at the addresses of
+ * an nRF52840 with S140, and every page erase and word write is charged with the maximum times of
+ * the nRF52840 Product Specification. The test checks that the update is accepted and stored, and
+ * prints the simulated flash time, the CPU time of the transfer and the CPU time of the last
+ * execute, which contains the firmware hash and CRC checks. It is built with and without
+ * @ref NRF_DFU_STREAMING_HASH.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "nrf_dfu_req_handler.h"
+#include "nrf_dfu_settings.h"
+#include "nrf_dfu_flash.h"
+#include "nrf_dfu_utils.h"
+#include "nrf_fstorage.h"
+#include "app_scheduler.h"
+#include "nrf_crypto.h"
+#include "pb_encode.h"
+#include "dfu-cc.pb.h"
+#include "crc32.h"
+#include "sha256.h"
+#include "host_test.h"
+
+#define FLASH_START        0x20000UL            /**< Start of the simulated flash. Covers both banks and the bootloader. */
+#define FLASH_END          0x100000UL           /**< End of the simulated flash. */
+#define FLASH_ERASE_US     85000UL              /**< Maximum page erase time (t_ERASEPAGE). */
+#define FLASH_WRITE_US     41UL                 /**< Maximum word write time (t_WRITE). */
+
+#define FW_SIZE            (256UL * 1024)       /**< Size of the application image. */
+#define FW_VERSION         2                    /**< Version of the application image. */
+#define DATA_OBJECT_SIZE   CODE_PAGE_SIZE       /**< Data object size used by nRF Connect and nrfutil. */
+#define WRITE_LEN          244                  /**< Write length: ATT_MTU of 247 minus the notification header. */
+
+#define SCHED_QUEUE_SIZE   8
+#define FLASH_QUEUE_SIZE   64
+
+/**@brief Scheduler event. */
+typedef struct
+{
+    app_sched_event_handler_t handler;
+    uint16_t                  size;
+    nrf_dfu_request_t         data;
+} sched_event_t;
+
+/**@brief Flash operation waiting for its completion callback. */
+typedef struct
+{
+    nrf_dfu_flash_callback_t callback;
+    void                   * p_buf;
+} flash_op_t;
+
+const uint8_t      pk[64];
+nrf_dfu_settings_t s_dfu_settings;
+
+static uint8_t            m_fw[FW_SIZE];
+static uint8_t            m_init_packet[INIT_COMMAND_MAX_SIZE];
+static size_t             m_init_packet_len;
+
+static sched_event_t      m_sched_queue[SCHED_QUEUE_SIZE];
+static uint32_t           m_sched_head;
+static uint32_t           m_sched_count;
+static flash_op_t         m_flash_queue[FLASH_QUEUE_SIZE];
+static uint32_t           m_flash_head;
+static uint32_t           m_flash_count;
+static uint64_t           m_flash_us;           /**< Simulated time spent in flash erase and write. */
+static uint32_t           m_write_done_count;   /**< Write buffers returned by the request handler. */
+
+static nrf_dfu_response_t m_response;
+static bool               m_response_received;
+
+
+/* The SoftDevice information and the bootloader address are set with CFLAGS, so the only flash
+ * that is read is the simulated range.
+ */
+ret_code_t nrf_dfu_flash_init(bool sd_irq_initialized)
+{
+    UNUSED_PARAMETER(sd_irq_initialized);
+    return NRF_SUCCESS;
+}
+
+static void flash_op_add(nrf_dfu_flash_callback_t callback, void * p_buf)
+{
+    HOST_TEST_CHECK(m_flash_count < FLASH_QUEUE_SIZE);
+    m_flash_queue[(m_flash_head + m_flash_count++) % FLASH_QUEUE_SIZE] = (flash_op_t){callback, p_buf};
+}
+
+ret_code_t nrf_dfu_flash_store(uint32_t                   dest,
+                               void               const * p_src,
+                               uint32_t                   len,
+                               nrf_dfu_flash_callback_t   callback)
+{
+    uint8_t * p_dest = (uint8_t *)dest;
+
+    HOST_TEST_CHECK((dest >= FLASH_START) && (dest + len <= FLASH_END));
+    for (uint32_t i = 0; i < len; i++)
+    {
+        // Flash must be erased before it is written.
+        if (p_dest[i] != 0xFF)
+        {
+            HOST_TEST_CHECK(p_dest[i] == 0xFF);
+            break;
+        }
+    }
+
+    memcpy(p_dest, p_src, len);
+    m_flash_us += CEIL_DIV(len, sizeof(uint32_t)) * FLASH_WRITE_US;
+    flash_op_add(callback, (void *)p_src);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_dfu_flash_erase(uint32_t page_addr, uint32_t num_pages, nrf_dfu_flash_callback_t callback)
+{
+    HOST_TEST_CHECK((page_addr >= FLASH_START) && (page_addr + num_pages * CODE_PAGE_SIZE <= FLASH_END));
+
+    memset((void *)page_addr, 0xFF, num_pages * CODE_PAGE_SIZE);
+    m_flash_us += num_pages * FLASH_ERASE_US;
+    flash_op_add(callback, NULL);
+
+    return NRF_SUCCESS;
+}
+
+bool nrf_fstorage_is_busy(nrf_fstorage_t const * p_fs)
+{
+    UNUSED_PARAMETER(p_fs);
+    return (m_flash_count > 0);
+}
+
+/* The settings page and its backup are erased and written. */
+ret_code_t nrf_dfu_settings_write_and_backup(nrf_dfu_flash_callback_t callback)
+{
+    m_flash_us += 2 * (FLASH_ERASE_US +
+                       CEIL_DIV(sizeof(s_dfu_settings), sizeof(uint32_t)) * FLASH_WRITE_US);
+    flash_op_add(callback, NULL);
+
+    return NRF_SUCCESS;
+}
+
+void nrf_dfu_settings_progress_reset(void)
+{
+    memset(s_dfu_settings.init_command, 0xFF, INIT_COMMAND_MAX_SIZE);
+    memset(&s_dfu_settings.progress, 0, sizeof(dfu_progress_t));
+    s_dfu_settings.write_offset = 0;
+}
+
+uint32_t app_sched_event_put(void const * p_event_data, uint16_t event_size, app_sched_event_handler_t handler)
+{
+    sched_event_t * p_event;
+
+    if ((m_sched_count == SCHED_QUEUE_SIZE) || (event_size > sizeof(p_event->data)))
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_event          = &m_sched_queue[(m_sched_head + m_sched_count++) % SCHED_QUEUE_SIZE];
+    p_event->handler = handler;
+    p_event->size    = event_size;
+    memcpy(&p_event->data, p_event_data, event_size);
+
+    return NRF_SUCCESS;
+}
+
+/* Signatures are not used: the update is unsigned and NRF_DFU_REQUIRE_SIGNED_APP_UPDATE is 0. */
+const nrf_crypto_ecc_curve_info_t g_nrf_crypto_ecc_secp256r1_curve_info;
+
+ret_code_t nrf_crypto_init(void)
+{
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_crypto_ecc_public_key_from_raw(nrf_crypto_ecc_curve_info_t const * p_curve_info,
+                                              nrf_crypto_ecc_public_key_t       * p_public_key,
+                                              uint8_t                     const * p_raw_data,
+                                              size_t                              raw_data_size)
+{
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_crypto_ecdsa_verify(nrf_crypto_ecdsa_verify_context_t       * p_context,
+                                   nrf_crypto_ecc_public_key_t       const * p_public_key,
+                                   uint8_t                           const * p_hash,
+                                   size_t                                    hash_size,
+                                   uint8_t                           const * p_signature,
+                                   size_t                                    signature_size)
+{
+    return NRF_ERROR_CRYPTO_ECDSA_INVALID_SIGNATURE;
+}
+
+
+/**@brief Function for running scheduled events and completing flash operations until both are
+ *        idle. Flash operations complete in order, interleaved with the scheduled events.
+ */
+static void events_process(void)
+{
+    while ((m_sched_count > 0) || (m_flash_count > 0))
+    {
+        if (m_sched_count > 0)
+        {
+            sched_event_t event = m_sched_queue[m_sched_head];
+
+            m_sched_head = (m_sched_head + 1) % SCHED_QUEUE_SIZE;
+            m_sched_count--;
+            event.handler(&event.data, event.size);
+        }
+
+        if (m_flash_count > 0)
+        {
+            flash_op_t op = m_flash_queue[m_flash_head];
+
+            m_flash_head = (m_flash_head + 1) % FLASH_QUEUE_SIZE;
+            m_flash_count--;
+            if (op.callback != NULL)
+            {
+                op.callback(op.p_buf);
+            }
+        }
+    }
+}
+
+static void on_response(nrf_dfu_response_t * p_res, void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    m_response          = *p_res;
+    m_response_received = true;
+}
+
+static void on_write_done(void * p_buf)
+{
+    UNUSED_PARAMETER(p_buf);
+    m_write_done_count++;
+}
+
+static void on_dfu_evt(nrf_dfu_evt_type_t evt_type)
+{
+    UNUSED_PARAMETER(evt_type);
+}
+
+/**@brief Function for passing a request to the request handler and waiting for the response.
+ *
+ * @return Result of the request.
+ */
+static nrf_dfu_result_t request(nrf_dfu_request_t * p_req)
+{
+    p_req->callback.response = on_response;
+    p_req->callback.write    = on_write_done;
+    m_response_received      = false;
+
+    HOST_TEST_CHECK(nrf_dfu_req_handler_on_req(p_req) == NRF_SUCCESS);
+    events_process();
+    HOST_TEST_CHECK(m_response_received);
+
+    return m_response.result;
+}
+
+/**@brief Function for sending one object: create, write, CRC check and execute.
+ *
+ * @param[in] type      Object type.
+ * @param[in] p_data    Object data.
+ * @param[in] len       Object length.
+ * @param[in] crc       Expected CRC of everything sent so far, including this object.
+ * @param[in] offset    Expected offset after this object.
+ */
+static void object_send(uint32_t type, uint8_t const * p_data, uint32_t len, uint32_t crc, uint32_t offset)
+{
+    nrf_dfu_request_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.request            = NRF_DFU_OP_OBJECT_CREATE;
+    req.create.object_type = type;
+    req.create.object_size = len;
+    HOST_TEST_CHECK(request(&req) == NRF_DFU_RES_CODE_SUCCESS);
+
+    for (uint32_t i = 0; i < len; i += WRITE_LEN)
+    {
+        memset(&req, 0, sizeof(req));
+        req.request      = NRF_DFU_OP_OBJECT_WRITE;
+        req.write.p_data = &p_data[i];
+        req.write.len    = (uint16_t)MIN(WRITE_LEN, len - i);
+        HOST_TEST_CHECK(request(&req) == NRF_DFU_RES_CODE_SUCCESS);
+    }
+
+    memset(&req, 0, sizeof(req));
+    req.request = NRF_DFU_OP_CRC_GET;
+    HOST_TEST_CHECK(request(&req) == NRF_DFU_RES_CODE_SUCCESS);
+    HOST_TEST_CHECK((m_response.crc.crc == crc) && (m_response.crc.offset == offset));
+
+    memset(&req, 0, sizeof(req));
+    req.request = NRF_DFU_OP_OBJECT_EXECUTE;
+    HOST_TEST_CHECK(request(&req) == NRF_DFU_RES_CODE_SUCCESS);
+}
+
+/**@brief Function for creating the firmware and its unsigned init packet. */
+static void update_create(void)
+{
+    sha256_context_t ctx;
+    uint8_t          digest[32];
+    pb_ostream_t     stream;
+    dfu_packet_t     packet;
+    dfu_init_command_t * p_init = &packet.command.init;
+
+    srand(1);
+    for (uint32_t i = 0; i < FW_SIZE; i++)
+    {
+        m_fw[i] = (uint8_t)rand();
+    }
+
+    HOST_TEST_CHECK(sha256_init(&ctx) == NRF_SUCCESS);
+    HOST_TEST_CHECK(sha256_update(&ctx, m_fw, FW_SIZE) == NRF_SUCCESS);
+    HOST_TEST_CHECK(sha256_final(&ctx, digest, 0) == NRF_SUCCESS);
+
+    memset(&packet, 0, sizeof(packet));
+    packet.has_command       = true;
+    packet.command.has_op_code = true;
+    packet.command.op_code     = DFU_OP_CODE_INIT;
+    packet.command.has_init    = true;
+
+    p_init->has_fw_version = true;
+    p_init->fw_version     = FW_VERSION;
+    p_init->has_hw_version = true;
+    p_init->hw_version     = NRF_DFU_HW_VERSION;
+    p_init->sd_req_count   = 1;
+    p_init->sd_req[0]      = _SD_FWID_GET(MBR_SIZE);
+    p_init->has_type       = true;
+    p_init->type           = DFU_FW_TYPE_APPLICATION;
+    p_init->has_app_size   = true;
+    p_init->app_size       = FW_SIZE;
+    p_init->has_hash       = true;
+    p_init->hash.hash_type = DFU_HASH_TYPE_SHA256;
+    p_init->hash.hash.size = sizeof(digest);
+
+    // The init packet holds the hash in little-endian byte order.
+    for (uint32_t i = 0; i < sizeof(digest); i++)
+    {
+        p_init->hash.hash.bytes[i] = digest[sizeof(digest) - 1 - i];
+    }
+
+    stream = pb_ostream_from_buffer(m_init_packet, sizeof(m_init_packet));
+    HOST_TEST_CHECK(pb_encode(&stream, dfu_packet_fields, &packet));
+    m_init_packet_len = stream.bytes_written;
+}
+
+int main(void)
+{
+    nrf_dfu_request_t req;
+    uint64_t          start;
+    uint64_t          transfer_ns;
+    uint64_t          execute_ns = 0;
+    uint32_t          crc        = 0;
+    uint32_t          write_count;
+    void            * p_flash;
+
+    // Flash is accessed through its device addresses.
+    p_flash = mmap((void *)FLASH_START, FLASH_END - FLASH_START, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (p_flash != (void *)FLASH_START)
+    {
+        printf("Simulated flash could not be mapped at 0x%lx.\n", FLASH_START);
+        return host_test_result(NRF_DFU_STREAMING_HASH ? "nrf_dfu_streaming_hash" : "nrf_dfu_full_hash");
+    }
+    memset(p_flash, 0xFF, FLASH_END - FLASH_START);
+
+    update_create();
+    HOST_TEST_CHECK(nrf_dfu_req_handler_init(on_dfu_evt) == NRF_SUCCESS);
+
+    start = host_test_time_ns();
+
+    memset(&req, 0, sizeof(req));
+    req.request            = NRF_DFU_OP_OBJECT_SELECT;
+    req.select.object_type = NRF_DFU_OBJ_TYPE_COMMAND;
+    HOST_TEST_CHECK(request(&req) == NRF_DFU_RES_CODE_SUCCESS);
+
+    object_send(NRF_DFU_OBJ_TYPE_COMMAND,
+                m_init_packet,
+                m_init_packet_len,
+                crc32_compute(m_init_packet, m_init_packet_len, NULL),
+                m_init_packet_len);
+
+    write_count = m_write_done_count;
+    for (uint32_t offset = 0; offset < FW_SIZE; offset += DATA_OBJECT_SIZE)
+    {
+        uint32_t len = MIN(DATA_OBJECT_SIZE, FW_SIZE - offset);
+
+        crc = crc32_compute(&m_fw[offset], len, (offset == 0) ? NULL : &crc);
+
+        if (offset + len == FW_SIZE)
+        {
+            execute_ns = host_test_time_ns();
+        }
+        object_send(NRF_DFU_OBJ_TYPE_DATA, &m_fw[offset], len, crc, offset + len);
+    }
+
+    transfer_ns = host_test_time_ns() - start;
+    execute_ns  = host_test_time_ns() - execute_ns;
+
+    // Every data buffer is returned, and the update is stored in bank 1 as a valid application.
+    HOST_TEST_CHECK(m_write_done_count - write_count == FW_SIZE / DATA_OBJECT_SIZE * CEIL_DIV(DATA_OBJECT_SIZE, WRITE_LEN));
+    HOST_TEST_CHECK(s_dfu_settings.bank_1.bank_code == NRF_DFU_BANK_VALID_APP);
+    HOST_TEST_CHECK(s_dfu_settings.bank_1.image_size == FW_SIZE);
+    HOST_TEST_CHECK(s_dfu_settings.bank_1.image_crc == crc);
+    HOST_TEST_CHECK(s_dfu_settings.app_version == FW_VERSION);
+    HOST_TEST_CHECK(memcmp((void *)s_dfu_settings.progress.update_start_address, m_fw, FW_SIZE) == 0);
+
+    printf("%lu KiB in %lu byte objects: %.1f ms simulated flash, %.2f ms CPU, "
+           "%.2f ms CPU in the last execute\n",
+           FW_SIZE / 1024, (unsigned long)DATA_OBJECT_SIZE, (double)m_flash_us / 1000,
+           (double)transfer_ns / 1000000, (double)execute_ns / 1000000);
+
+    return host_test_result(NRF_DFU_STREAMING_HASH ? "nrf_dfu_streaming_hash" : "nrf_dfu_full_hash");
+}
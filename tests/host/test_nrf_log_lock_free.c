@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief Stress test of the deferred logger frontend with concurrent producers.
+ *
+ * Several producer threads log standard and hexdump entries into the shared log buffer while
+ * one consumer thread processes them. Every entry carries a producer ID, a sequence number and
+ * a check value, so that torn, corrupted or reordered entries are detected. Entries that did not
+ * fit in the buffer are counted in the dropped field of the following entries, so every
+ * produced entry is either received or reported as dropped.
+ *
+ * The test is built with and without @ref NRF_LOG_LOCK_FREE_ENABLED.
+ */
+#define NRF_LOG_MODULE_NAME stress
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_internal.h"
+#include "host_test.h"
+
+NRF_LOG_MODULE_REGISTER();
+
+#define PRODUCER_COUNT      4
+#define ENTRIES_PER_THREAD  100000UL
+#define HEXDUMP_MAX_LEN     23
+#define CHECK_PATTERN       0xA5A5A5A5UL
+
+static uint32_t m_timestamp;
+static uint32_t m_received;
+static uint32_t m_received_hexdump;
+static uint32_t m_dropped;
+static uint32_t m_last_seq[PRODUCER_COUNT];
+static bool     m_done;
+
+static uint32_t timestamp_get(void)
+{
+    return __atomic_fetch_add(&m_timestamp, 1, __ATOMIC_RELAXED);
+}
+
+static uint32_t entry_check(uint32_t id, uint32_t seq, uint32_t value)
+{
+    return id ^ seq ^ value ^ CHECK_PATTERN;
+}
+
+static void std_entry_check(nrf_log_entry_t * p_msg, nrf_log_header_t const * p_header)
+{
+    uint32_t args[NRF_LOG_MAX_NUM_OF_ARGS];
+    uint32_t nargs = p_header->base.std.nargs;
+
+    if (nargs == 0)
+    {
+        // Final entry logged after all producers are done.
+        m_received++;
+        return;
+    }
+
+    HOST_TEST_CHECK(nargs == 4);
+    if (nargs != 4)
+    {
+        return;
+    }
+    nrf_memobj_read(p_msg, args, nargs * sizeof(uint32_t), HEADER_SIZE * sizeof(uint32_t));
+
+    HOST_TEST_CHECK(args[0] < PRODUCER_COUNT);
+    HOST_TEST_CHECK(args[3] == entry_check(args[0], args[1], args[2]));
+    if ((args[0] < PRODUCER_COUNT) && (args[3] == entry_check(args[0], args[1], args[2])))
+    {
+        // Entries of one producer are committed in order.
+        HOST_TEST_CHECK(args[1] > m_last_seq[args[0]]);
+        m_last_seq[args[0]] = args[1];
+        m_received++;
+    }
+}
+
+static void hexdump_entry_check(nrf_log_entry_t * p_msg, nrf_log_header_t const * p_header)
+{
+    uint8_t  data[HEXDUMP_MAX_LEN];
+    uint32_t len = p_header->base.hexdump.len;
+    bool     valid = (len >= 2) && (len <= HEXDUMP_MAX_LEN);
+
+    HOST_TEST_CHECK(valid);
+    if (!valid)
+    {
+        return;
+    }
+    nrf_memobj_read(p_msg, data, len, HEADER_SIZE * sizeof(uint32_t));
+
+    for (uint32_t i = 2; i < len; i++)
+    {
+        valid &= (data[i] == (uint8_t)(data[0] + data[1] * i));
+    }
+    HOST_TEST_CHECK(valid);
+    m_received_hexdump += valid ? 1 : 0;
+}
+
+static void backend_put(nrf_log_backend_t const * p_backend, nrf_log_entry_t * p_msg)
+{
+    nrf_log_header_t header;
+
+    nrf_memobj_read(p_msg, &header, HEADER_SIZE * sizeof(uint32_t), 0);
+    m_dropped += header.dropped;
+
+    if (header.base.generic.type == HEADER_TYPE_STD)
+    {
+        std_entry_check(p_msg, &header);
+    }
+    else
+    {
+        HOST_TEST_CHECK(header.base.generic.type == HEADER_TYPE_HEXDUMP);
+        hexdump_entry_check(p_msg, &header);
+    }
+    nrf_memobj_put(p_msg);
+}
+
+static void backend_nop(nrf_log_backend_t const * p_backend)
+{
+}
+
+static const nrf_log_backend_api_t m_backend_api =
+{
+    .put       = backend_put,
+    .flush     = backend_nop,
+    .panic_set = backend_nop,
+};
+
+NRF_LOG_BACKEND_DEF(m_backend, m_backend_api, NULL);
+
+static void * producer_thread(void * p_arg)
+{
+    uint32_t id = (uint32_t)(uintptr_t)p_arg;
+    uint8_t  data[HEXDUMP_MAX_LEN];
+
+    for (uint32_t seq = 1; seq <= ENTRIES_PER_THREAD; seq++)
+    {
+        // Vary the timing so that producers preempt each other at different points.
+        for (volatile uint32_t delay = (seq * 7919UL) % 1500UL; delay > 0; delay--)
+        {
+        }
+        if ((seq % 64) == 0)
+        {
+            (void)sched_yield();
+        }
+
+        if ((seq % 8) == 0)
+        {
+            uint32_t len = 2 + (seq % (HEXDUMP_MAX_LEN - 1));
+
+            data[0] = (uint8_t)seq;
+            data[1] = (uint8_t)id;
+            for (uint32_t i = 2; i < len; i++)
+            {
+                data[i] = (uint8_t)(data[0] + data[1] * i);
+            }
+            NRF_LOG_HEXDUMP_INFO(data, len);
+        }
+        else
+        {
+            uint32_t value = seq * 2654435761UL;
+
+            NRF_LOG_INFO("%d %d %d %d", id, seq, value, entry_check(id, seq, value));
+        }
+    }
+
+    return NULL;
+}
+
+static void * consumer_thread(void * p_arg)
+{
+    bool done;
+
+    // Flag is read before processing, so that the last entry is processed before exiting.
+    do
+    {
+        done = __atomic_load_n(&m_done, __ATOMIC_ACQUIRE);
+    } while (NRF_LOG_PROCESS() || !done);
+
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t producers[PRODUCER_COUNT];
+    pthread_t consumer;
+    uint32_t  produced = PRODUCER_COUNT * ENTRIES_PER_THREAD + 1;
+    uint64_t  start    = host_test_time_ns();
+
+    HOST_TEST_CHECK(NRF_LOG_INIT(timestamp_get, 32768) == NRF_SUCCESS);
+    (void)nrf_log_backend_add(&m_backend, NRF_LOG_SEVERITY_DEBUG);
+    nrf_log_backend_enable(&m_backend);
+
+    HOST_TEST_CHECK(pthread_create(&consumer, NULL, consumer_thread, NULL) == 0);
+    for (uint32_t i = 0; i < PRODUCER_COUNT; i++)
+    {
+        HOST_TEST_CHECK(pthread_create(&producers[i], NULL, producer_thread,
+                                       (void *)(uintptr_t)i) == 0);
+    }
+    for (uint32_t i = 0; i < PRODUCER_COUNT; i++)
+    {
+        HOST_TEST_CHECK(pthread_join(producers[i], NULL) == 0);
+    }
+
+    // Wait until the buffer is drained, then log an entry that carries the last dropped count.
+    (void)usleep(100000);
+    NRF_LOG_INFO("done");
+    __atomic_store_n(&m_done, true, __ATOMIC_RELEASE);
+    HOST_TEST_CHECK(pthread_join(consumer, NULL) == 0);
+
+    printf("%u entries in %.2f s: %u received (%u hexdumps), %u dropped\n",
+           produced, (double)(host_test_time_ns() - start) / 1e9,
+           m_received + m_received_hexdump, m_received_hexdump, m_dropped);
+    HOST_TEST_CHECK(m_received + m_received_hexdump + m_dropped == produced);
+
+    return host_test_result(NRF_LOG_LOCK_FREE_ENABLED ? "nrf_log_lock_free" : "nrf_log_locked");
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief Stress test of nrf_queue in @ref NRF_QUEUE_MODE_SPSC.
+ *
+ * A producer thread and a consumer thread use the queue without any lock. The producer uses
+ * push, write and in, and the consumer uses peek, pop, read and out, with varying element
+ * counts. Every element carries a sequence number and a check value, so that lost, duplicated,
+ * reordered or torn elements are detected.
+ */
+#include <pthread.h>
+#include <sched.h>
+#include "nrf_queue.h"
+#include "host_test.h"
+
+#define QUEUE_SIZE      37
+#define ELEMENT_COUNT   20000000UL
+#define BATCH_MAX       8
+
+typedef struct
+{
+    uint32_t seq;
+    uint32_t check;
+    uint8_t  padding[4];
+} element_t;
+
+NRF_QUEUE_DEF(element_t, m_queue, QUEUE_SIZE, NRF_QUEUE_MODE_SPSC);
+
+static uint32_t element_check(uint32_t seq)
+{
+    return ~seq * 2654435761UL;
+}
+
+static void * producer_thread(void * p_arg)
+{
+    element_t batch[BATCH_MAX];
+    uint32_t  seq   = 0;
+    uint32_t  loops = 0;
+
+    while (seq < ELEMENT_COUNT)
+    {
+        uint32_t count = 1 + (seq % BATCH_MAX);
+
+        if (count > ELEMENT_COUNT - seq)
+        {
+            count = ELEMENT_COUNT - seq;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            batch[i].seq   = seq + i;
+            batch[i].check = element_check(seq + i);
+        }
+
+        switch (seq % 3)
+        {
+            case 0:
+                if (nrf_queue_push(&m_queue, &batch[0]) == NRF_SUCCESS)
+                {
+                    seq++;
+                }
+                break;
+
+            case 1:
+                if (nrf_queue_write(&m_queue, batch, count) == NRF_SUCCESS)
+                {
+                    seq += count;
+                }
+                break;
+
+            default:
+                seq += nrf_queue_in(&m_queue, batch, count);
+                break;
+        }
+
+        if ((++loops % 16) == 0)
+        {
+            (void)sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t producer;
+    element_t batch[BATCH_MAX];
+    element_t peeked;
+    uint32_t  expected = 0;
+    uint32_t  round    = 0;
+    uint64_t  start    = host_test_time_ns();
+
+    HOST_TEST_CHECK(pthread_create(&producer, NULL, producer_thread, NULL) == 0);
+
+    while (expected < ELEMENT_COUNT)
+    {
+        uint32_t count    = 1 + (round % BATCH_MAX);
+        size_t   received = 0;
+
+        round++;
+        switch (round % 4)
+        {
+            case 0:
+                if (nrf_queue_peek(&m_queue, &peeked) == NRF_SUCCESS)
+                {
+                    HOST_TEST_CHECK(peeked.seq == expected);
+                }
+                received = (nrf_queue_pop(&m_queue, batch) == NRF_SUCCESS) ? 1 : 0;
+                break;
+
+            case 1:
+                received = (nrf_queue_read(&m_queue, batch, count) == NRF_SUCCESS) ? count : 0;
+                break;
+
+            default:
+                received = nrf_queue_out(&m_queue, batch, count);
+                break;
+        }
+
+        for (size_t i = 0; i < received; i++, expected++)
+        {
+            if ((batch[i].seq != expected) || (batch[i].check != element_check(expected)))
+            {
+                HOST_TEST_CHECK(batch[i].seq == expected);
+                HOST_TEST_CHECK(batch[i].check == element_check(expected));
+                break;
+            }
+        }
+
+        HOST_TEST_CHECK(nrf_queue_utilization_get(&m_queue) <= QUEUE_SIZE);
+        if (m_host_test_failures != 0)
+        {
+            break;
+        }
+        if (received == 0)
+        {
+            (void)sched_yield();
+        }
+    }
+
+    if (m_host_test_failures != 0)
+    {
+        return host_test_result("nrf_queue_spsc");
+    }
+
+    HOST_TEST_CHECK(pthread_join(producer, NULL) == 0);
+    HOST_TEST_CHECK(nrf_queue_is_empty(&m_queue));
+    HOST_TEST_CHECK(nrf_queue_max_utilization_get(&m_queue) <= QUEUE_SIZE);
+
+    printf("%u elements in %.2f s, max utilization %u\n", expected,
+           (double)(host_test_time_ns() - start) / 1e9,
+           (unsigned int)nrf_queue_max_utilization_get(&m_queue));
+
+    return host_test_result("nrf_queue_spsc");
+}
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**@file
+ *
+ * @brief NIST vector test and throughput benchmark of the SHA-256 module.
+ *
+ * Checks the FIPS 180-2 example vectors, the result of sha256_update() for arbitrary splits of the
+ * input and the result of sha256_update_multi(). The benchmark measures full-block input, which
+ * is hashed in place, and input fed in small chunks, which goes through the context buffer.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "sha256.h"
+#include "host_test.h"
+
+#define BENCH_SIZE   4096
+#define BENCH_ROUNDS 500
+
+typedef struct
+{
+    char const * p_msg;
+    uint32_t     repeat;
+    char const * p_digest;
+} sha256_vector_t;
+
+static sha256_vector_t const m_vectors[] =
+{
+    {"", 1,
+     "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+    {"abc", 1,
+     "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+    {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+     "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+    {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+     "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1,
+     "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+    {"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+     "aaaaaaaa", 10000,
+     "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+};
+
+static void digest_to_hex(uint8_t const * p_digest, char * p_hex)
+{
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        sprintf(&p_hex[i * 2], "%02x", p_digest[i]);
+    }
+}
+
+static void digest_get(uint8_t const * p_data, size_t size, size_t chunk, uint8_t * p_digest)
+{
+    sha256_context_t ctx;
+
+    (void)sha256_init(&ctx);
+    for (size_t pos = 0; pos < size; pos += chunk)
+    {
+        (void)sha256_update(&ctx, &p_data[pos], (size - pos < chunk) ? (size - pos) : chunk);
+    }
+    (void)sha256_final(&ctx, p_digest, 0);
+}
+
+static double throughput_get(uint8_t const * p_data, size_t chunk)
+{
+    uint8_t        digest[32];
+    uint64_t const start = host_test_time_ns();
+
+    for (uint32_t i = 0; i < BENCH_ROUNDS; i++)
+    {
+        digest_get(p_data, BENCH_SIZE, chunk, digest);
+    }
+    return (double)BENCH_SIZE * BENCH_ROUNDS * 1000.0 / (double)(host_test_time_ns() - start);
+}
+
+int main(void)
+{
+    static uint8_t buf[BENCH_SIZE];
+    uint8_t        digest[32];
+    uint8_t        expected[32];
+    char           hex[65];
+
+    for (uint32_t i = 0; i < sizeof(m_vectors) / sizeof(m_vectors[0]); i++)
+    {
+        sha256_context_t ctx;
+        size_t const     len = strlen(m_vectors[i].p_msg);
+
+        HOST_TEST_CHECK(sha256_init(&ctx) == NRF_SUCCESS);
+        for (uint32_t j = 0; j < m_vectors[i].repeat; j++)
+        {
+            HOST_TEST_CHECK(sha256_update(&ctx, (uint8_t const *)m_vectors[i].p_msg, len)
+                            == NRF_SUCCESS);
+        }
+        HOST_TEST_CHECK(sha256_final(&ctx, digest, 0) == NRF_SUCCESS);
+        digest_to_hex(digest, hex);
+        HOST_TEST_CHECK(strcmp(hex, m_vectors[i].p_digest) == 0);
+    }
+
+    srand(3);
+    for (uint32_t i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = (uint8_t)rand();
+    }
+
+    // Any split of the input must give the same digest.
+    for (size_t size = 0; size < 1000; size += 37)
+    {
+        digest_get(&buf[1], size, size + 1, expected);
+        for (size_t chunk = 1; chunk < 150; chunk += 7)
+        {
+            digest_get(&buf[1], size, chunk, digest);
+            HOST_TEST_CHECK(memcmp(digest, expected, sizeof(digest)) == 0);
+        }
+    }
+
+    // sha256_update_multi() must give the same digests as separate updates.
+    {
+        sha256_context_t         ctx[3];
+        sha256_context_t * const p_ctx[3] = {&ctx[0], &ctx[1], &ctx[2]};
+        uint8_t const * const    p_data[3] = {&buf[10], &buf[3], NULL};
+        size_t const             len[3]    = {1000, 130, 0};
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            (void)sha256_init(&ctx[i]);
+        }
+        (void)sha256_update(&ctx[0], buf, 10);
+        HOST_TEST_CHECK(sha256_update_multi(p_ctx, p_data, len, 3) == NRF_SUCCESS);
+
+        (void)sha256_final(&ctx[0], digest, 0);
+        digest_get(buf, 1010, 1010, expected);
+        HOST_TEST_CHECK(memcmp(digest, expected, sizeof(digest)) == 0);
+
+        (void)sha256_final(&ctx[1], digest, 0);
+        digest_get(&buf[3], 130, 130, expected);
+        HOST_TEST_CHECK(memcmp(digest, expected, sizeof(digest)) == 0);
+
+        (void)sha256_final(&ctx[2], digest, 0);
+        digest_get(buf, 0, 1, expected);
+        HOST_TEST_CHECK(memcmp(digest, expected, sizeof(digest)) == 0);
+    }
+
+    printf("sha256: %.1f MB/s in full blocks, %.1f MB/s in 13-byte chunks\n",
+           throughput_get(buf, BENCH_SIZE),
+           throughput_get(buf, 13));
+
+    return host_test_result("sha256");
+}